@@ -0,0 +1,56 @@
+set(_GLPK_ROOT_HINTS)
+
+if(GLPK_ROOT)
+    list(APPEND _GLPK_ROOT_HINTS "${GLPK_ROOT}")
+endif()
+
+if(DEFINED ENV{GLPK_ROOT})
+    list(APPEND _GLPK_ROOT_HINTS "$ENV{GLPK_ROOT}")
+endif()
+
+list(APPEND _GLPK_ROOT_HINTS
+        /usr/local
+        /opt/homebrew
+        /opt/local
+)
+
+find_path(GLPK_INCLUDE_DIR
+        NAMES glpk.h
+        HINTS ${_GLPK_ROOT_HINTS}
+        PATH_SUFFIXES
+        include
+        .
+)
+
+find_library(GLPK_LIBRARY
+        NAMES glpk libglpk
+        HINTS ${_GLPK_ROOT_HINTS}
+        PATH_SUFFIXES
+        lib
+        lib64
+        .
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(GLPK
+        REQUIRED_VARS
+        GLPK_INCLUDE_DIR
+        GLPK_LIBRARY
+)
+
+if(GLPK_FOUND AND NOT TARGET GLPK::GLPK)
+    add_library(GLPK::GLPK INTERFACE IMPORTED)
+
+    set_target_properties(GLPK::GLPK PROPERTIES
+            INTERFACE_INCLUDE_DIRECTORIES "${GLPK_INCLUDE_DIR}"
+            INTERFACE_LINK_LIBRARIES "${GLPK_LIBRARY}"
+    )
+
+    if(UNIX)
+        set_property(TARGET GLPK::GLPK APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES "m"
+        )
+    endif()
+endif()
+
+mark_as_advanced(GLPK_INCLUDE_DIR GLPK_LIBRARY)
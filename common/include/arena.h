@@ -0,0 +1,53 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/**
+ * @brief Bump allocator for scratch memory (one per thread, not thread-safe).
+ *
+ * Memory comes from blocks obtained with tsp_malloc and is only given back all at once,
+ * by rewinding to a mark or resetting the arena. Blocks are kept after a rewind, so a
+ * loop that rewinds every iteration stops allocating after the first one.
+ */
+typedef struct Arena Arena;
+
+/**
+ * @brief Position in an arena, returned by arena_mark.
+ */
+typedef struct {
+    void *block;
+    size_t used;
+} ArenaMark;
+
+/**
+ * @brief Creates an arena whose first block holds `capacity` bytes.
+ * Larger requests grow the arena with additional blocks.
+ */
+Arena *arena_create(size_t capacity);
+
+void arena_destroy(Arena *arena);
+
+/**
+ * @brief Returns `size` bytes aligned for any type. Never returns NULL.
+ */
+void *arena_alloc(Arena *arena, size_t size);
+
+/**
+ * @brief Like arena_alloc for `num` elements of `size` bytes, zero-filled.
+ */
+void *arena_calloc(Arena *arena, size_t num, size_t size);
+
+ArenaMark arena_mark(const Arena *arena);
+
+/**
+ * @brief Releases everything allocated after `mark` was taken.
+ */
+void arena_rewind(Arena *arena, ArenaMark mark);
+
+/**
+ * @brief Releases every allocation, keeping the blocks.
+ */
+void arena_reset(Arena *arena);
+
+#endif //ARENA_H
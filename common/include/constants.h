@@ -6,4 +6,10 @@
 #define RECORDER_INITIAL_CAPACITY 1024
 #define CC_MINCUT_BIGDOUBLE   (1e30)
 #define CC_MINCUT_ONE_EPSILON (0.000001)
+#define CANDIDATE_LIST_SIZE 10
+#define KICK_MAX_SEGMENT 64
+#define PATH_RELINK_MARGIN_DIVISOR 10
+#define EAX_TRIALS 10
+#define GA_DEDUP_ATTEMPTS 4
+#define TOUR_CACHE_SLOTS (1 << 16)
 #endif //CONSTANTS_H
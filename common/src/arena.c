@@ -0,0 +1,92 @@
+#include "arena.h"
+#include <stdalign.h>
+#include <string.h>
+#include "c_util.h"
+
+#define ARENA_ALIGN alignof(max_align_t)
+#define ARENA_ROUND(size) (((size) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;
+    size_t used;
+} ArenaBlock;
+
+struct Arena {
+    ArenaBlock *first;
+    ArenaBlock *current;
+    size_t block_size;
+};
+
+static unsigned char *block_data(ArenaBlock *block) {
+    return (unsigned char *) block + ARENA_ROUND(sizeof(ArenaBlock));
+}
+
+static ArenaBlock *block_create(const size_t size) {
+    ArenaBlock *block = tsp_malloc(ARENA_ROUND(sizeof(ArenaBlock)) + size);
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+Arena *arena_create(const size_t capacity) {
+    Arena *arena = tsp_malloc(sizeof(Arena));
+    arena->block_size = ARENA_ROUND(capacity > 0 ? capacity : ARENA_ALIGN);
+    arena->first = block_create(arena->block_size);
+    arena->current = arena->first;
+    return arena;
+}
+
+void arena_destroy(Arena *arena) {
+    if (!arena) return;
+    ArenaBlock *block = arena->first;
+    while (block) {
+        ArenaBlock *next = block->next;
+        tsp_free(block);
+        block = next;
+    }
+    tsp_free(arena);
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+    size = ARENA_ROUND(size);
+    ArenaBlock *block = arena->current;
+
+    if (block->used + size > block->size) {
+        // Blocks after the current one are free: reuse the next one if it fits
+        ArenaBlock *next = block->next;
+        if (next && size <= next->size) {
+            next->used = 0;
+        } else {
+            next = block_create(size > arena->block_size ? size : arena->block_size);
+            next->next = block->next;
+            block->next = next;
+        }
+        arena->current = block = next;
+    }
+
+    void *ptr = block_data(block) + block->used;
+    block->used += size;
+    return ptr;
+}
+
+void *arena_calloc(Arena *arena, const size_t num, const size_t size) {
+    void *ptr = arena_alloc(arena, num * size);
+    memset(ptr, 0, num * size);
+    return ptr;
+}
+
+ArenaMark arena_mark(const Arena *arena) {
+    return (ArenaMark){.block = arena->current, .used = arena->current->used};
+}
+
+void arena_rewind(Arena *arena, const ArenaMark mark) {
+    arena->current = mark.block;
+    arena->current->used = mark.used;
+}
+
+void arena_reset(Arena *arena) {
+    arena->current = arena->first;
+    arena->current->used = 0;
+}
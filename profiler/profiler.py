@@ -50,6 +50,34 @@ def run_solver(instance_path, flag_list, seed, time_limit):
         print(f"  [Error] Solver not found at {SOLVER_PATH}")
         return None
 
+def run_batch(runs, threads):
+    """Executes all the runs inside one solver process (--batch); instances are parsed once.
+    runs: list of (instance_path, flag_list, seed, label). Returns the parsed JSON results."""
+    manifest_path = os.path.join(RESULTS_DIR, "batch_manifest.txt")
+    output_path = os.path.join(RESULTS_DIR, "batch_results.jsonl")
+    with open(manifest_path, "w") as m:
+        for (inst, flags, seed, label) in runs:
+            quoted = [f'"{fl}"' if " " in fl else fl for fl in flags]
+            m.write(f"[{label}] --mode 1 --file {inst} --seed {seed} {' '.join(quoted)}\n")
+
+    cmd = [SOLVER_PATH, "--batch", manifest_path, "--batch-output", output_path,
+           "--threads", str(threads), "--verbosity", "0"]
+    try:
+        subprocess.run(cmd, capture_output=True, text=True)
+    except FileNotFoundError:
+        print(f"  [Error] Solver not found at {SOLVER_PATH}")
+        return []
+
+    results = []
+    with open(output_path) as f:
+        for line in f:
+            entry = json.loads(line)
+            if "error" in entry:
+                print(f"  [Error] manifest line {entry['line']}: {entry['error']}")
+            else:
+                results.append(entry)
+    return results
+
 def is_valid_combination(params):
     """Filters out illogical parameter combinations (e.g. min > max)."""
     # VNS Check
@@ -103,6 +131,8 @@ def main():
 
     parser = argparse.ArgumentParser()
     parser.add_argument("config_file", help="Path to JSON configuration file")
+    parser.add_argument("--batch", type=int, metavar="THREADS", default=0,
+                        help="Run everything in one solver process with THREADS workers")
     args = parser.parse_args()
 
     try:
@@ -144,6 +174,17 @@ def main():
         writer = csv.writer(f)
         writer.writerow(["Instance", "Algorithm", "Config", "Cost", "Time", "Seed"])
 
+        if args.batch > 0:
+            runs = [(inst, exp["flags_list"], seed, exp["name"])
+                    for inst in instances
+                    for exp in experiment_queue
+                    for seed in config.get("seeds", [42])]
+            for r in run_batch(runs, args.batch):
+                writer.writerow([os.path.basename(r["instance"]), r["algorithm"], r["label"],
+                                 r["cost"], r["seconds"], r["seed"]])
+            print(f"\nDone. Results: {csv_file}")
+            return
+
         count = 0
         for inst in instances:
             inst_name = os.path.basename(inst)
@@ -7,6 +7,8 @@
 typedef struct {
     double time_limit;
     int num_threads;
+    int cut_depth; // deepest node with fractional SEC cuts, -1 for none
+    int sparse_k; // nearest neighbors per node in the sparse model with pricing, 0 for the complete graph
 } BranchCutConfig;
 
 TspAlgorithm branch_and_cut_create(BranchCutConfig config);
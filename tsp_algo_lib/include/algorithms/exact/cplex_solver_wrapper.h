@@ -4,41 +4,149 @@
 #include "tsp_instance.h"
 #include <stdbool.h>
 
-typedef struct CplexSolverContext CplexSolverContext;
-
 int xpos(int i, int j, int num_nodes);
 
+void cplex_solver_reconstruct_tour(int n, const double *x, int *tour);
+
+/*
+ * Everything below needs CPLEX: the exact algorithms reach it through CPLEX_MIP_BACKEND (mip_backend.h).
+ */
+#ifdef ENABLE_CPLEX
+typedef struct CplexSolverContext CplexSolverContext;
+
 CplexSolverContext *cplex_solver_create(const TspInstance *inst);
 
 void cplex_solver_destroy(CplexSolverContext *ctx);
 
+/**
+ * @brief Adds every edge column and every degree row, each block in a single call.
+ */
 int cplex_solver_build_base_model(CplexSolverContext *ctx, const TspInstance *inst);
 
+/**
+ * @brief Builds the degree rows over the edges to the k nearest neighbors of every node and the edges of tour
+ * (closed, n+1 ints; NULL for the cycle 0-1-...-(n-1), which keeps the model feasible). Columns are then
+ * numbered by the model, not by xpos: see cplex_solver_get_col. Edges missing from the model enter through
+ * cplex_solver_add_mip_start and cplex_solver_price_edges. Local branching and edge fixing by xpos need
+ * the complete model of cplex_solver_build_base_model.
+ */
+int cplex_solver_build_sparse_model(CplexSolverContext *ctx, const TspInstance *inst, int k, const int *tour);
+
+/**
+ * @brief Prices the edges missing from a sparse model against the subtour LP relaxation of the model, which
+ * must only hold degree rows and SECs. The LP is cut with min-cut SECs (also added to the model) and extended
+ * with the edges of negative reduced cost until none is left; its value is then a lower bound for the complete
+ * graph. Last, every edge whose reduced cost is below upper_bound - lower_bound enters the model: if none does,
+ * an optimal solution of the sparse model is optimal for the complete graph. A new column also gets its
+ * coefficient in every SEC row of the model (added, pooled or pricing SECs) whose set holds both its endpoints.
+ *
+ * At most a few edges per node enter each round: loop (solve, price) until `added` is 0.
+ *
+ * @param upper_bound Cost of the best known tour (CPX_INFBOUND or more for none: LP pricing only).
+ * @param lower_bound Receives the bound, -DBL_MAX when the LP could not be priced out (may be NULL).
+ * @param added Receives the number of columns added to the model (may be NULL).
+ */
+int cplex_solver_price_edges(CplexSolverContext *ctx, const TspInstance *inst, double upper_bound,
+                             double *lower_bound, int *added);
+
+/**
+ * @return The column of edge {u, v}: its xpos index, or -1 when a sparse model has no column for it.
+ */
+int cplex_solver_get_col(const CplexSolverContext *ctx, int u, int v, int num_nodes);
+
+/**
+ * @brief Names the columns ("x_i_j") and rows ("deg_h") of the next base model. Off by default:
+ * names only matter when the model is written to a file.
+ */
+void cplex_solver_set_names(CplexSolverContext *ctx, bool with_names);
+
 int cplex_solver_fix_edge(CplexSolverContext *ctx, int u, int v, double value, int num_nodes);
 
+/**
+ * @brief Fixes the given columns (xpos indices) to value with a single bound change.
+ */
+int cplex_solver_fix_edges(CplexSolverContext *ctx, const int *cols, int count, double value);
+
+/**
+ * @brief Restores the [0, 1] bounds of every column fixed since the last reset, with a single bound change.
+ * Together with cplex_solver_fix_edges it lets one model serve every iteration of a fixing matheuristic.
+ */
+int cplex_solver_reset_bounds(CplexSolverContext *ctx);
+
+/**
+ * @brief Removes every MIP start of the model.
+ */
+int cplex_solver_clear_mip_starts(CplexSolverContext *ctx);
+
+/**
+ * @brief Makes the lazy SEC callback keep the SECs it separates (components of at most n/2 nodes) in a pool.
+ * SECs are valid whatever the bounds, so the pool can be moved into the model between solves.
+ */
+void cplex_solver_keep_sec_cuts(CplexSolverContext *ctx, bool keep);
+
+/**
+ * @brief Adds the pooled SECs to the model as rows over its current columns, in one call, and empties the pool.
+ * @param added Receives the number of rows added (may be NULL).
+ */
+int cplex_solver_flush_sec_pool(CplexSolverContext *ctx, int *added);
+
 int cplex_solver_add_local_branching_constraint(CplexSolverContext *ctx, int num_nodes, const int *tour, int k);
 
+/**
+ * @brief Centers the local branching row x(E(tour)) >= n - k on tour. The first call adds the row; later calls
+ * only change the coefficients of the edges that left or entered the center, and the rhs.
+ */
+int cplex_solver_set_local_branching(CplexSolverContext *ctx, int num_nodes, const int *tour, int k);
+
+/**
+ * @brief Adds the reverse (tabu) row x(E(tour)) <= n - k - 1, which cuts off the explored neighborhood of radius k.
+ */
+int cplex_solver_add_reverse_branching(CplexSolverContext *ctx, int num_nodes, const int *tour, int k);
+
 int cplex_solver_add_mip_start(CplexSolverContext *ctx, int num_nodes, const int *tour);
 
+/**
+ * @brief Installs the SEC callback: lazy constraints on integer candidates and, when enabled with
+ * cplex_solver_set_fractional_sec_depth, user cuts on fractional points.
+ */
 int cplex_solver_install_sec_callback(CplexSolverContext *ctx, const TspInstance *inst);
 
+/**
+ * @brief Separates SECs on the LP relaxation of every node up to `max_depth` (0 = root only, -1 = never),
+ * with connected components and min-cut. Takes effect at the next cplex_solver_install_sec_callback.
+ */
+void cplex_solver_set_fractional_sec_depth(CplexSolverContext *ctx, int max_depth);
+
 void cplex_solver_set_time_limit(CplexSolverContext *ctx, double seconds);
 
-void cplex_solver_reconstruct_tour(int n, const double *x, int *tour);
+/**
+ * @brief Caps the threads of the next solves (0 = CPLEX default, one per core). Call it before
+ * cplex_solver_install_sec_callback, which sizes its per-thread scratch from this value.
+ */
+void cplex_solver_set_threads(CplexSolverContext *ctx, int num_threads);
 
 int cplex_solver_optimize(CplexSolverContext *ctx);
 
 bool cplex_solver_has_solution(CplexSolverContext *ctx);
 
+/**
+ * @brief True if the last solve proved optimality (within the gap tolerance).
+ */
+bool cplex_solver_is_optimal(CplexSolverContext *ctx);
+
 int cplex_solver_extract_solution(CplexSolverContext *ctx, double *out_cost);
 
+/**
+ * @brief cplex_solver_reconstruct_tour on the last extracted solution, for complete and sparse models alike.
+ */
+void cplex_solver_extract_tour(const CplexSolverContext *ctx, int n, int *tour);
+
 const double *cplex_solver_get_x(const CplexSolverContext *ctx);
 
 int cplex_solver_get_num_cols(const CplexSolverContext *ctx);
 
 int cplex_solver_add_sec(CplexSolverContext *ctx, const TspInstance *inst, const int *component_nodes, int comp_size);
 
-#ifdef ENABLE_CPLEX
 void *cplex_solver_get_env(const CplexSolverContext *ctx);
 
 void *cplex_solver_get_lp(const CplexSolverContext *ctx);
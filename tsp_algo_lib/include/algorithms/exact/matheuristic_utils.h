@@ -21,4 +21,11 @@ void matheuristic_run_warm_start(const WarmStartParams *params,
 
 void matheuristic_free_args(void *heuristic_args);
 
+/**
+ * @brief Copies the configuration of a warm-start heuristic (NULL stays NULL), so that every clone of a
+ * matheuristic owns and frees its own. The seed of the copy is moved by seed_offset, so that the clones do
+ * not all warm-start from the same tour.
+ */
+void *matheuristic_clone_args(HeuristicType heuristic_type, const void *heuristic_args, uint64_t seed_offset);
+
 #endif
@@ -0,0 +1,49 @@
+#ifndef MIN_CUT_SEPARATOR_H
+#define MIN_CUT_SEPARATOR_H
+
+/**
+ * @brief Separator of subtour elimination constraints on fractional points (one per thread).
+ *
+ * A node set S violates its SEC when x(delta(S)) < 2, which under the degree equations is the same as
+ * x(E(S)) > |S| - 1. The support graph (x > 0) is first split into connected components: with more
+ * than one, every component is a violated set. Otherwise edges with x = 1 are shrunk (Padberg-Rinaldi:
+ * they never cross a minimum cut when the degrees are 2) and Stoer-Wagner runs on the shrunk graph,
+ * reporting every cut of a phase below 2, so a single call may return several sets.
+ */
+typedef struct MinCutSeparator MinCutSeparator;
+
+// Stoer-Wagner costs O(m E log E) on the m supernodes and E edges of the shrunk support graph: beyond this
+// size only components are separated
+#define MIN_CUT_MAX_SUPERNODES 2000
+
+MinCutSeparator *min_cut_separator_create(int num_nodes);
+
+void min_cut_separator_destroy(MinCutSeparator *sep);
+
+/**
+ * @brief Finds node sets whose SEC is violated by more than `tolerance`.
+ * Each set is the smaller side of its cut (at most n/2 nodes, so the SEC has the fewest nonzeros).
+ * Min-cut is skipped when more than MIN_CUT_MAX_SUPERNODES nodes remain after shrinking.
+ *
+ * @param x_star Point in xpos order (n*(n-1)/2 values in [0, 1]).
+ * @param tolerance Minimum violation: sets with x(delta(S)) >= 2 - tolerance are not reported.
+ * @param max_cuts Maximum number of sets returned.
+ * @return The number of sets found, readable with min_cut_separator_get_cut until the next call.
+ */
+int min_cut_separator_run(MinCutSeparator *sep, const double *x_star, double tolerance, int max_cuts);
+
+/**
+ * @brief min_cut_separator_run on a point given edge by edge: x[e] is the value of edge {edge_u[e], edge_v[e]},
+ * every edge not listed is 0 (the columns of a sparse model).
+ */
+int min_cut_separator_run_sparse(MinCutSeparator *sep, const int *edge_u, const int *edge_v, const double *x,
+                                 int num_edges, double tolerance, int max_cuts);
+
+/**
+ * @brief Returns the nodes of set k (0 <= k < the last return value of min_cut_separator_run).
+ * @param size Receives the number of nodes.
+ * @param cut_value Receives x(delta(S)) (may be NULL).
+ */
+const int *min_cut_separator_get_cut(const MinCutSeparator *sep, int k, int *size, double *cut_value);
+
+#endif // MIN_CUT_SEPARATOR_H
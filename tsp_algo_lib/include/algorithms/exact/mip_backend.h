@@ -0,0 +1,69 @@
+#ifndef MIP_BACKEND_H
+#define MIP_BACKEND_H
+
+#include "tsp_instance.h"
+#include <stdbool.h>
+
+#if defined(ENABLE_CPLEX) || defined(ENABLE_GLPK)
+#define MIP_BACKEND_AVAILABLE
+#endif
+
+/**
+ * @brief The MIP solver behind the exact algorithms, as a table of operations on an opaque model.
+ *
+ * Every operation has the semantics of the cplex_solver_* function of the same name. Columns are the edges
+ * of the complete graph numbered by xpos, unless build_sparse_model is used. Operations a solver cannot
+ * offer are NULL: callers check the optional ones (marked below) before using them.
+ */
+typedef struct {
+    const char *name;
+
+    void *(*create)(const TspInstance *inst);
+    void (*destroy)(void *model);
+
+    int (*build_model)(void *model, const TspInstance *inst);
+    int (*build_sparse_model)(void *model, const TspInstance *inst, int k, const int *tour); // optional
+    // Optional, with build_sparse_model. lower_bound is -DBL_MAX unless the LP was priced out: the sparse optimum
+    // is only proven when it is set and no edge was added
+    int (*price_edges)(void *model, const TspInstance *inst, double upper_bound, double *lower_bound, int *added);
+    int (*get_col)(const void *model, int u, int v, int num_nodes);
+
+    int (*fix_edges)(void *model, const int *cols, int count, double value);
+    int (*reset_bounds)(void *model);
+    int (*add_sec)(void *model, const TspInstance *inst, const int *component_nodes, int comp_size);
+    int (*set_local_branching)(void *model, int num_nodes, const int *tour, int k);
+    int (*add_reverse_branching)(void *model, int num_nodes, const int *tour, int k);
+
+    int (*add_mip_start)(void *model, int num_nodes, const int *tour);
+    int (*clear_mip_starts)(void *model);
+
+    int (*install_sec_callback)(void *model, const TspInstance *inst);
+    void (*set_fractional_sec_depth)(void *model, int max_depth); // optional
+    void (*keep_sec_cuts)(void *model, bool keep);
+    int (*flush_sec_pool)(void *model, int *added);
+
+    void (*set_time_limit)(void *model, double seconds);
+    void (*set_threads)(void *model, int num_threads);
+    int (*optimize)(void *model);
+
+    bool (*has_solution)(void *model);
+    bool (*is_optimal)(void *model);
+    int (*extract_solution)(void *model, double *out_cost);
+    void (*extract_tour)(const void *model, int num_nodes, int *tour);
+    const double *(*get_x)(const void *model);
+} MipBackend;
+
+#ifdef ENABLE_CPLEX
+extern const MipBackend CPLEX_MIP_BACKEND;
+#endif
+
+#ifdef ENABLE_GLPK
+extern const MipBackend GLPK_MIP_BACKEND;
+#endif
+
+/**
+ * @return The backend of the exact algorithms: CPLEX when built with it, else GLPK, else NULL.
+ */
+const MipBackend *mip_backend_default(void);
+
+#endif // MIP_BACKEND_H
@@ -0,0 +1,61 @@
+#ifndef SPARSE_EDGE_SET_H
+#define SPARSE_EDGE_SET_H
+
+#include "candidate_lists.h"
+
+/**
+ * @brief Edges of a sparse TSP model: column c joins edge_u[c] < edge_v[c].
+ *
+ * Columns are numbered in insertion order, so edges priced in later keep the columns already given to
+ * the solver. Every node keeps a linked list of incidence entries: entry 2c + s belongs to column c,
+ * on the side of edge_u (s = 0) or edge_v (s = 1):
+ *
+ *     for (int e = set->head[u]; e != -1; e = set->next[e]) { const int col = e >> 1; ... }
+ */
+typedef struct {
+    int num_nodes;
+    int num_edges;
+    int capacity;
+    int *edge_u;
+    int *edge_v;
+    int *head; // first incidence entry of every node, -1 for none
+    int *next; // 2 * capacity
+    int *slots; // open addressing table (u, v) -> column, -1 for empty
+    int slot_mask;
+} SparseEdgeSet;
+
+SparseEdgeSet *sparse_edge_set_create(int num_nodes);
+
+void sparse_edge_set_destroy(SparseEdgeSet *set);
+
+/**
+ * @brief Adds edge {u, v} (u != v) unless present.
+ * @return The column of the edge.
+ */
+int sparse_edge_set_add(SparseEdgeSet *set, int u, int v);
+
+/**
+ * @return The column of edge {u, v}, -1 if it is not in the set.
+ */
+int sparse_edge_set_find(const SparseEdgeSet *set, int u, int v);
+
+/**
+ * @brief Adds the edge from every node to each of its candidate neighbors.
+ */
+void sparse_edge_set_add_candidates(SparseEdgeSet *set, const CandidateLists *candidates);
+
+/**
+ * @brief Adds the edges missing from the set whose reduced cost c_uv - pi_u - pi_v is below `threshold`.
+ *
+ * The node duals are those of the degree rows; rows added later (SECs) have no coefficient on the new
+ * columns, so the value is the exact reduced cost they will enter the LP with. Scans all pairs, O(n^2).
+ *
+ * @param costs Flattened cost matrix (n*n).
+ * @param node_duals Dual value of the degree row of every node.
+ * @param max_per_node Most negative edges kept per (smaller) endpoint, 0 for no limit.
+ * @return The number of edges added: they are the columns from the old num_edges on.
+ */
+int sparse_edge_set_price(SparseEdgeSet *set, const double *costs, const double *node_duals, double threshold,
+                          int max_per_node);
+
+#endif // SPARSE_EDGE_SET_H
@@ -3,12 +3,17 @@
 
 typedef struct {
     int num_components;
-    int *component_of_node;
-    int *nodes_in_component;
+    int *component_of_node; // component id of every node, from 1 to num_components
+    int *nodes_in_component; // size of component c at index c - 1
+    int *component_start; // nodes of component c are component_nodes[component_start[c - 1] .. component_start[c])
+    int *component_nodes;
+    // Scratch owned by the structure, so that finding components does not allocate
+    int *parent; // union-find forest (path halving, smallest node as root)
+    int *cursor;
 } ConnectedComponents;
 
 /**
- * Allocates the structure to hold component data.
+ * Allocates the structure to hold component data and every buffer used to compute it.
  */
 ConnectedComponents *connected_components_create(int num_nodes);
 
@@ -18,7 +23,9 @@ ConnectedComponents *connected_components_create(int num_nodes);
 void connected_components_destroy(ConnectedComponents *cc);
 
 /**
- * Identifies connected components in the graph defined by x_star.
+ * Identifies connected components in the graph defined by x_star and buckets the nodes per component.
+ * Union-find over one linear pass of x_star. Does not allocate: one structure per thread can serve any
+ * number of calls.
  * * @param cc Structure to populate.
  * @param num_nodes Total nodes.
  * @param x_star The binary solution from CPLEX (size n*(n-1)/2).
@@ -26,4 +33,12 @@ void connected_components_destroy(ConnectedComponents *cc);
  */
 void find_connected_components(ConnectedComponents *cc, int num_nodes, const double *x_star);
 
+/**
+ * find_connected_components on the support graph given edge by edge, in O(m alpha(n)): the columns of a
+ * sparse model, where x[e] is the value of edge {edge_u[e], edge_v[e]} and every edge not listed is 0,
+ * or the edges of a tour or of a 2-regular adjacency with x == NULL (every listed edge is selected).
+ */
+void find_connected_components_sparse(ConnectedComponents *cc, int num_nodes, const int *edge_u, const int *edge_v,
+                                      const double *x, int num_edges);
+
 #endif // SUBTOUR_SEPARATOR_H
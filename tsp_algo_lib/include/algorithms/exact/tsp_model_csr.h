@@ -0,0 +1,38 @@
+#ifndef TSP_MODEL_CSR_H
+#define TSP_MODEL_CSR_H
+
+#include <stdbool.h>
+#include "tsp_instance.h"
+
+/**
+ * @brief The base TSP model (one binary column per edge, in xpos order, and one degree row per node)
+ * laid out as the arrays of CPXnewcols and CPXaddrows, so that CPLEX gets each in a single call.
+ */
+typedef struct {
+    int num_nodes;
+    int num_cols;
+    double *obj; // cost of every edge column
+    double *ub; // all 1 (lower bounds are left to the solver default, 0)
+    char *ctype; // all 'B'
+    int num_rows;
+    int nnz;
+    int *rmatbeg; // row h starts at h * (n - 1)
+    int *rmatind;
+    double *rmatval;
+    double *rhs; // all 2
+    char *sense; // all 'E'
+    char **colname; // "x_i_j" (1-based), NULL unless names were requested
+    char **rowname; // "deg_h" (1-based), NULL unless names were requested
+    char *name_buffer;
+} TspModelCsr;
+
+/**
+ * @brief Fills the arrays of the base model. Rows are split among num_threads threads
+ * (0 = one per core; small instances use one).
+ * @param with_names Also generate column and row names (costly for large n, off for solving).
+ */
+TspModelCsr *tsp_model_csr_build(const TspInstance *inst, bool with_names, int num_threads);
+
+void tsp_model_csr_destroy(TspModelCsr *model);
+
+#endif // TSP_MODEL_CSR_H
@@ -1,10 +1,27 @@
 #ifndef GENETIC_H
 #define GENETIC_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "tsp_algorithm.h"
 
+/**
+ * @brief Crossover operator used to generate the offspring.
+ */
+typedef enum {
+    GA_CROSSOVER_CUT = 0, /**< One-point cut, greedy repair and 2-opt on every child. */
+    GA_CROSSOVER_EAX /**< Edge Assembly Crossover: inherits parent edges, no repair or local search. */
+} GeneticCrossover;
+
+/**
+ * @brief How islands are connected in the island model.
+ */
+typedef enum {
+    MIGRATION_RING = 0, /**< Island i sends to island i+1. */
+    MIGRATION_RANDOM /**< Each migration goes to a random other island. */
+} MigrationTopology;
+
 typedef struct {
     double time_limit;
     int population_size;
@@ -16,9 +33,27 @@ typedef struct {
     int init_grasp_rcl_size;
     double init_grasp_prob;
     int init_grasp_percent;
+    GeneticCrossover crossover;
+    int num_threads; /**< Offspring generation threads (0 = auto). Results depend on seed and thread count. */
+
+    /* Island model (enabled when num_islands > 1): one thread and one population per island.
+     * population_size is per island and offspring are generated sequentially within an island. */
+    int num_islands;
+    int migration_interval; /**< Generations between two emigrations. */
+    int migration_count; /**< Best individuals sent per emigration. */
+    MigrationTopology migration_topology;
+
+    /* Deduplication by tour_hash: a cut child whose repaired tour was already optimized is rejected
+     * before the 2-opt, and clones of tours already in the next population are regenerated
+     * (at most GA_DEDUP_ATTEMPTS tries per child). */
+    bool deduplicate;
     uint64_t seed;
 } GeneticConfig;
 
 TspAlgorithm genetic_create(GeneticConfig config);
 
+const char *genetic_crossover_to_string(GeneticCrossover crossover);
+
+const char *migration_topology_to_string(MigrationTopology topology);
+
 #endif // GENETIC_H
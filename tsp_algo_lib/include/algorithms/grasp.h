@@ -1,9 +1,12 @@
 #ifndef GRASP_H
 #define GRASP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "tsp_algorithm.h"
+#include "elite_pool.h"
+#include "path_relinking.h"
 
 /**
  * @brief Configuration structure for GRASP algorithm.
@@ -14,10 +17,19 @@ typedef struct {
     int max_stagnation;
     double time_limit;
     uint64_t seed;
+    bool use_candidate_lists; /**< Build the RCL from the k-nearest-neighbor lists instead of a full scan. */
+    bool deduplicate; /**< Skip the 2-opt of repeated constructions and the relinking of repeated local optima. */
+
+    /* Path relinking (disabled when elite_size is 0) */
+    int elite_size;
+    double elite_min_diversity; /**< Fraction of edges a new elite must differ by. */
+    RelinkingMode relinking;
+    ElitePool *elite_pool; /**< Optional shared pool; created by grasp_create when NULL. */
 } GraspConfig;
 
 /**
  * @brief Creates a GRASP algorithm strategy.
+ * The elite pool is reference-counted: clones made for parallel runs share it.
  *
  * @param config The configuration for GRASP.
  * @return A TspAlgorithm structure ready to run.
@@ -15,6 +15,8 @@ typedef struct {
     HeuristicType heuristic_type;
     uint64_t seed;
     void *heuristic_args; // Optional heuristic-specific configuration (NULL uses defaults)
+    int num_threads; // CPLEX threads of every sub-MIP, 0 to split the cores among the workers
+    int num_workers; // runs sharing the cores with this one: its clones, or the algorithms of a portfolio
 } HardFixingConfig;
 
 TspAlgorithm hard_fixing_create(HardFixingConfig config);
@@ -1,6 +1,9 @@
 #ifndef CONSTRUCTIVE_H
 #define CONSTRUCTIVE_H
 #include "random.h"
+#include "candidate_lists.h"
+#include "spatial_grid.h"
+#include "arena.h"
 
 
 /**
@@ -14,6 +17,8 @@ int nearest_neighbor_tour(int starting_node,
 
 /**
  * @brief GRASP Construction with RCL.
+ *
+ * @param scratch Arena for the RCL buffers, rewound before returning (NULL allocates them per call).
  */
 int grasp_nearest_neighbor_tour(int starting_node,
                                 int *tour,
@@ -22,7 +27,40 @@ int grasp_nearest_neighbor_tour(int starting_node,
                                 double *cost,
                                 int rcl_size,
                                 double probability,
-                                RandomState *rng);
+                                RandomState *rng,
+                                Arena *scratch);
+
+/**
+ * @brief Scratch memory for grasp_candidate_tour, reused across constructions (one per thread).
+ */
+typedef struct GraspWorkspace GraspWorkspace;
+
+/**
+ * @brief Allocates the scratch memory for tours over n nodes.
+ *
+ * @param nodes Node coordinates used for the spatial fallback; borrowed, must outlive the workspace.
+ * @param rcl_capacity Largest RCL the workspace will serve.
+ */
+GraspWorkspace *grasp_workspace_create(const Node *nodes, int n, int rcl_capacity);
+
+void grasp_workspace_destroy(GraspWorkspace *ws);
+
+/**
+ * @brief GRASP Construction drawing the RCL from the k-nearest-neighbor candidate lists.
+ * The RCL holds the first unvisited candidates (at most min(rcl_size, k, rcl_capacity)), which are
+ * the nearest unvisited nodes. When every candidate is visited, the nearest unvisited node is
+ * found through the spatial grid. O(n*k) per tour, no allocation.
+ */
+int grasp_candidate_tour(int starting_node,
+                         int *tour,
+                         int number_of_nodes,
+                         const double *edge_cost_array,
+                         const CandidateLists *candidates,
+                         double *cost,
+                         int rcl_size,
+                         double probability,
+                         RandomState *rng,
+                         GraspWorkspace *ws);
 
 /**
  * @brief Standard Extra Mileage Algorithm (starts from scratch).
@@ -0,0 +1,44 @@
+#ifndef EAX_H
+#define EAX_H
+
+#include <stdbool.h>
+#include "random.h"
+#include "candidate_lists.h"
+
+/**
+ * @brief Preallocated scratch memory for the Edge Assembly Crossover (one per thread).
+ */
+typedef struct EaxWorkspace EaxWorkspace;
+
+EaxWorkspace *eax_workspace_create(int n);
+
+void eax_workspace_destroy(EaxWorkspace *ws);
+
+/**
+ * @brief Edge Assembly Crossover, single AB-cycle strategy (EAX-1AB).
+ *
+ * The edges of the two parents that are not shared are decomposed into AB-cycles
+ * (alternating parent_a / parent_b edges). Each trial applies one AB-cycle to parent_a,
+ * which yields a set of subtours that are then merged greedily by subtour_patcher_merge
+ * (cheapest 2-opt style reconnection over the candidate lists, all nodes as a fallback).
+ * The best of up to `trials` children is returned. Shared edges are always inherited,
+ * so no repair or local search is required.
+ *
+ * @param candidates Neighbor lists used to merge subtours (may be NULL: full scan only).
+ * @param child Buffer of n+1 ints, receives the closed child tour.
+ * @param child_cost Cost of the child.
+ * @return false if the parents share every edge (no AB-cycle); child is left untouched.
+ */
+bool eax_crossover(const int *parent_a,
+                   double cost_a,
+                   const int *parent_b,
+                   int n,
+                   const double *costs,
+                   const CandidateLists *candidates,
+                   int trials,
+                   int *child,
+                   double *child_cost,
+                   EaxWorkspace *ws,
+                   RandomState *rng);
+
+#endif //EAX_H
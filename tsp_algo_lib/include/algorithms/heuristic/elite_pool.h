@@ -0,0 +1,54 @@
+#ifndef ELITE_POOL_H
+#define ELITE_POOL_H
+
+#include <stdbool.h>
+#include "random.h"
+
+/**
+ * @brief Thread-safe, reference-counted pool of high-quality, mutually diverse tours.
+ * Diversity is measured as the number of edges of one tour missing from the other.
+ */
+typedef struct ElitePool ElitePool;
+
+/**
+ * @brief Creates an empty pool. Storage is sized on the first insertion.
+ *
+ * @param capacity Maximum number of members.
+ * @param min_diversity Fraction of edges (0.0-1.0) a newcomer must differ by from every member,
+ *                      unless it improves on the best member.
+ */
+ElitePool *elite_pool_create(int capacity, double min_diversity);
+
+/**
+ * @brief Takes an additional reference (e.g. for a cloned configuration).
+ */
+ElitePool *elite_pool_retain(ElitePool *pool);
+
+/**
+ * @brief Drops a reference, freeing the pool with the last one.
+ */
+void elite_pool_release(ElitePool *pool);
+
+/**
+ * @brief Offers a tour to the pool.
+ * When full, the newcomer must beat the worst member and replaces the most similar worse member.
+ *
+ * @return true if the tour was inserted.
+ */
+bool elite_pool_try_add(ElitePool *pool, const int *tour, int n, double cost);
+
+/**
+ * @brief Copies a uniformly random member into out_tour (size n+1).
+ * @return false if the pool is empty.
+ */
+bool elite_pool_sample(ElitePool *pool, RandomState *rng, int *out_tour, double *out_cost);
+
+int elite_pool_size(ElitePool *pool);
+
+/**
+ * @brief Number of edges of tour_a that do not appear in tour_b.
+ * @param adjacency_scratch Buffer of 2n ints.
+ */
+int tour_edge_distance(const int *tour_a, const int *tour_b, int n, int *adjacency_scratch);
+
+#endif //ELITE_POOL_H
@@ -0,0 +1,81 @@
+#ifndef KICK_H
+#define KICK_H
+
+#include "random.h"
+#include "candidate_lists.h"
+
+/**
+ * @brief Perturbation operators used to escape local optima.
+ */
+typedef enum {
+    KICK_RANDOM_N_OPT = 0, /**< k random edges removed, segments reconnected (O(n)). */
+    KICK_DOUBLE_BRIDGE, /**< Double-bridge confined to a window of KICK_MAX_SEGMENT positions. */
+    KICK_SEGMENT_REVERSAL, /**< Reversal of a random segment of at most KICK_MAX_SEGMENT nodes. */
+    KICK_NEAR_DOUBLE_BRIDGE /**< Double-bridge whose cut points are spatial neighbors. */
+} KickType;
+
+/**
+ * @brief Preallocated scratch memory for the kicks.
+ * One workspace per thread: kicks never allocate.
+ */
+typedef struct KickWorkspace KickWorkspace;
+
+/**
+ * @brief Creates a workspace for tours of n nodes.
+ *
+ * @param max_k Largest number of edges a random n-opt kick may remove.
+ * @param candidates Neighbor lists for KICK_NEAR_DOUBLE_BRIDGE (NULL falls back to the windowed double-bridge).
+ */
+KickWorkspace *kick_workspace_create(int n, int max_k, const CandidateLists *candidates);
+
+void kick_workspace_destroy(KickWorkspace *ws);
+
+/**
+ * @brief Signals that the tour has been modified outside the kick API (local search, restore).
+ * The node position index used by the near double-bridge is then rebuilt on demand.
+ */
+void kick_workspace_reset(KickWorkspace *ws);
+
+/**
+ * @brief Removes k random edges and reconnects the segments.
+ * @return The cost delta.
+ */
+double kick_random_n_opt(int *tour, int n, const double *costs, int k, KickWorkspace *ws, RandomState *rng);
+
+/**
+ * @brief Double-bridge (A B C D E -> A D C B E) with all four cuts inside a random window.
+ * Cost is O(KICK_MAX_SEGMENT).
+ * @return The cost delta.
+ */
+double kick_double_bridge(int *tour, int n, const double *costs, KickWorkspace *ws, RandomState *rng);
+
+/**
+ * @brief Reverses a random segment of at most KICK_MAX_SEGMENT nodes.
+ * @return The cost delta.
+ */
+double kick_segment_reversal(int *tour, int n, const double *costs, KickWorkspace *ws, RandomState *rng);
+
+/**
+ * @brief Double-bridge with cut points at a random node and three of its nearest neighbors.
+ * Cost is proportional to the tour span between the outer cuts.
+ * @return The cost delta.
+ */
+double kick_near_double_bridge(int *tour, int n, const double *costs, KickWorkspace *ws, RandomState *rng);
+
+/**
+ * @brief Applies a kick of the given type and strength.
+ * The strength is the number of edges to break: a random n-opt removes exactly that many,
+ * the double-bridges are repeated strength/4 times and the reversal strength/2 times (at least once).
+ * @return The cost delta.
+ */
+double kick_apply(KickType type,
+                  int *tour,
+                  int n,
+                  const double *costs,
+                  int strength,
+                  KickWorkspace *ws,
+                  RandomState *rng);
+
+const char *kick_type_to_string(KickType type);
+
+#endif //KICK_H
@@ -1,5 +1,6 @@
 #ifndef LOCAL_SEARCH_H
 #define LOCAL_SEARCH_H
+#include <stdint.h>
 #include "time_limiter.h"
 
 double two_opt(int *tour,
@@ -7,4 +8,15 @@ double two_opt(int *tour,
                const double *edge_cost_array,
                TimeLimiter timer);
 
+/**
+ * @brief two_opt that also keeps the tour_hash of the tour up to date, one XOR update per move.
+ *
+ * @param hash In: tour_hash of the input tour. Out: tour_hash of the improved tour.
+ */
+double two_opt_hashed(int *tour,
+                      int number_of_nodes,
+                      const double *edge_cost_array,
+                      TimeLimiter timer,
+                      uint64_t *hash);
+
 #endif //LOCAL_SEARCH_H
@@ -0,0 +1,33 @@
+#ifndef MIGRATION_QUEUE_H
+#define MIGRATION_QUEUE_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer queue of tours.
+ * Used to move migrants between GA islands: exactly one thread may push and one thread may pop.
+ * Tours are copied in and out, so the queue owns its storage.
+ */
+typedef struct MigrationQueue MigrationQueue;
+
+/**
+ * @param capacity Maximum number of queued tours.
+ * @param n Number of nodes (tours are n+1 ints).
+ */
+MigrationQueue *migration_queue_create(int capacity, int n);
+
+void migration_queue_destroy(MigrationQueue *queue);
+
+/**
+ * @brief Producer side. Never blocks.
+ * @return false if the queue is full (the tour is dropped).
+ */
+bool migration_queue_push(MigrationQueue *queue, const int *tour, double cost);
+
+/**
+ * @brief Consumer side. Never blocks.
+ * @return false if the queue is empty.
+ */
+bool migration_queue_pop(MigrationQueue *queue, int *out_tour, double *out_cost);
+
+#endif //MIGRATION_QUEUE_H
@@ -0,0 +1,43 @@
+#ifndef PATH_RELINKING_H
+#define PATH_RELINKING_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Direction of the relinking between a new local optimum and an elite tour.
+ */
+typedef enum {
+    RELINK_BACKWARD = 0, /**< From the elite tour towards the new local optimum. */
+    RELINK_FORWARD, /**< From the new local optimum towards the elite tour. */
+    RELINK_BOTH /**< Both directions, keeping the better result. */
+} RelinkingMode;
+
+/**
+ * @brief Preallocated scratch memory for path relinking (one per thread).
+ */
+typedef struct PathRelinkWorkspace PathRelinkWorkspace;
+
+PathRelinkWorkspace *path_relink_workspace_create(int n);
+
+void path_relink_workspace_destroy(PathRelinkWorkspace *ws);
+
+/**
+ * @brief Walks from `from` to `target`, one 2-opt move per step, each move introducing one edge of the target.
+ * Returns the best intermediate tour, skipping a margin of the path next to both endpoints.
+ *
+ * @param out_tour Buffer of n+1 ints for the best intermediate tour.
+ * @param out_cost Cost of the best intermediate tour.
+ * @return false if the two tours are too close to have an intermediate.
+ */
+bool path_relink(const int *from,
+                 double from_cost,
+                 const int *target,
+                 int n,
+                 const double *costs,
+                 int *out_tour,
+                 double *out_cost,
+                 PathRelinkWorkspace *ws);
+
+const char *relinking_mode_to_string(RelinkingMode mode);
+
+#endif //PATH_RELINKING_H
@@ -0,0 +1,52 @@
+#ifndef SUBTOUR_PATCHING_H
+#define SUBTOUR_PATCHING_H
+
+#include <stdbool.h>
+#include "candidate_lists.h"
+
+/**
+ * @brief Preallocated scratch memory for patching subtours into a tour (one per thread).
+ *
+ * Graphs are given as 2-regular adjacencies: 2n ints holding both neighbors of every node,
+ * as produced by an integer point of the degree-constrained model or by an EAX child.
+ */
+typedef struct SubtourPatcher SubtourPatcher;
+
+SubtourPatcher *subtour_patcher_create(int n);
+
+void subtour_patcher_destroy(SubtourPatcher *patcher);
+
+/**
+ * @brief Reads the adjacency of the edges above 0.5 of a point in xpos order.
+ * @return false if some node does not have exactly two such edges.
+ */
+bool subtour_adjacency_from_x(const double *x_star, int n, int *adj);
+
+/**
+ * @brief Merges the subtours of adj into one cycle, in place.
+ *
+ * The smallest subtour is repeatedly merged into a neighboring one by the cheapest exchange of one
+ * edge of each (two ways to reconnect), searching the candidate lists first and all nodes as a fallback.
+ *
+ * @param candidates Neighbor lists (may be NULL: full scan only).
+ * @return The cost delta of the merges.
+ */
+double subtour_patcher_merge(SubtourPatcher *patcher, int *adj, const double *costs,
+                             const CandidateLists *candidates);
+
+/**
+ * @brief Walks a single-cycle adjacency into a closed tour (n+1 ints) starting at node 0.
+ */
+void subtour_adjacency_to_tour(const int *adj, int n, int *tour);
+
+/**
+ * @brief 2-opt and Or-opt (segments of 1 to 3 nodes) restricted to the candidate lists, first improvement,
+ * until no move improves. Cheap enough to polish a patched tour inside a solver callback.
+ *
+ * @param tour Closed tour (n+1 ints), improved in place.
+ * @return The cost delta (<= 0).
+ */
+double subtour_patcher_improve(SubtourPatcher *patcher, int *tour, const double *costs,
+                               const CandidateLists *candidates);
+
+#endif //SUBTOUR_PATCHING_H
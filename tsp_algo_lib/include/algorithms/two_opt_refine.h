@@ -0,0 +1,16 @@
+#ifndef TWO_OPT_REFINE_H
+#define TWO_OPT_REFINE_H
+
+#include "tsp_algorithm.h"
+
+typedef struct {
+    double time_limit;
+} TwoOptConfig;
+
+/**
+ * @brief Creates a 2-opt descent strategy.
+ * It does not build a tour: it improves the one already stored in the solution (e.g. in a pipeline).
+ */
+TspAlgorithm two_opt_create(TwoOptConfig config);
+
+#endif // TWO_OPT_REFINE_H
@@ -4,6 +4,7 @@
 #include <stdint.h>
 
 #include "tsp_algorithm.h"
+#include "kick.h"
 
 typedef struct {
     int min_k;
@@ -11,6 +12,7 @@ typedef struct {
     int kick_repetition;
     double time_limit;
     int max_stagnation;
+    KickType kick_type;
     uint64_t seed;
 } VNSConfig;
 
@@ -1,6 +1,7 @@
 #ifndef TSP_ALGORITHM_H
 #define TSP_ALGORITHM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "cost_recorder.h"
@@ -39,4 +40,47 @@ void tsp_algorithm_run(const TspAlgorithm *algo,
 
 void tsp_algorithm_destroy(TspAlgorithm *algo);
 
+/**
+ * @brief A solve running on its own thread, started by tsp_algorithm_start.
+ */
+typedef struct TspSolveHandle TspSolveHandle;
+
+/**
+ * @brief Starts the algorithm on a new thread and returns immediately.
+ *
+ * The handle owns a cancellation token attached to the solution, so tsp_solve_cancel stops the algorithm at its
+ * next time check. on_improvement (may be NULL) is registered as the solution listener: it runs on the solver
+ * thread, under the solution lock, every time the incumbent improves.
+ * algo, instance, solution and recorder are borrowed and must outlive the handle.
+ *
+ * @return The handle, or NULL if the thread cannot be created.
+ */
+TspSolveHandle *tsp_algorithm_start(const TspAlgorithm *algo,
+                                    const TspInstance *instance,
+                                    TspSolution *solution,
+                                    CostRecorder *recorder,
+                                    TspSolutionListener on_improvement,
+                                    void *user_data);
+
+/**
+ * @brief Returns true once the solve has finished (normally or after a cancellation). Never blocks.
+ */
+bool tsp_solve_poll(const TspSolveHandle *handle);
+
+/**
+ * @brief Blocks until the solve has finished.
+ */
+void tsp_solve_wait(TspSolveHandle *handle);
+
+/**
+ * @brief Requests the solve to stop. Returns immediately; the best tour found so far stays in the solution.
+ */
+void tsp_solve_cancel(TspSolveHandle *handle);
+
+/**
+ * @brief Cancels the solve if still running, waits for it and releases the handle.
+ * The solution is detached from the handle's token and listener.
+ */
+void tsp_solve_destroy(TspSolveHandle *handle);
+
 #endif // TSP_ALGORITHM_H
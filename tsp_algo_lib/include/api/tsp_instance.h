@@ -3,6 +3,7 @@
 #include <stddef.h>
 
 #include "tsp_error.h"
+#include "candidate_lists.h"
 
 /**
  * @brief Defines the area used for generating a random TSP instance.
@@ -69,5 +70,11 @@ const Node *tsp_instance_get_nodes(const TspInstance *instance);
  */
 const double *tsp_instance_get_cost_matrix(const TspInstance *instance);
 
+/**
+ * @brief Returns the k-nearest-neighbor lists (k = CANDIDATE_LIST_SIZE).
+ * Built on first use and cached for the lifetime of the instance. Thread-safe.
+ */
+const CandidateLists *tsp_instance_get_candidate_lists(const TspInstance *instance);
+
 
 #endif // TSP_INSTANCE_H
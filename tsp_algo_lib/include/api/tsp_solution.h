@@ -4,11 +4,18 @@
 #include <stdbool.h>
 #include "feasibility_result.h"
 #include "tsp_error.h"
+#include "cancel_token.h"
 
 // Forward declarations
 typedef struct TspInstance TspInstance;
 typedef struct TspSolution TspSolution;
 
+/**
+ * @brief Called after every improvement of the stored tour, under the solution lock:
+ * it must be quick and must not call back into the solution.
+ */
+typedef void (*TspSolutionListener)(const int *tour, int n, double cost, void *user_data);
+
 TspSolution *tsp_solution_create(const TspInstance *instance);
 
 TspSolution *tsp_solution_create_with_tour(const TspInstance *instance, const int *tour);
@@ -23,6 +30,27 @@ void tsp_solution_get_tour(TspSolution *self, int *tour_buffer);
 
 bool tsp_solution_update_if_better(TspSolution *self, const int *new_tour, double new_cost);
 
+/**
+ * @brief Copies the stored tour into tour_buffer only if its cost is better than *cost.
+ * Tour and cost are read under the same lock, so a concurrent update can never be seen half-written.
+ * @param cost In: the caller's cost. Out: the stored cost, when the tour was copied.
+ * @return true if tour_buffer and *cost were updated.
+ */
+bool tsp_solution_fetch_if_better(TspSolution *self, int *tour_buffer, double *cost);
+
+/**
+ * @brief Registers the improvement listener (NULL removes it). Set it before the solve starts.
+ */
+void tsp_solution_set_listener(TspSolution *self, TspSolutionListener listener, void *user_data);
+
+/**
+ * @brief Attaches a cancellation token (borrowed) that algorithms bind to their time limiters.
+ * Set it before the solve starts.
+ */
+void tsp_solution_set_cancel_token(TspSolution *self, const CancelToken *token);
+
+const CancelToken *tsp_solution_get_cancel_token(const TspSolution *self);
+
 TspError tsp_solution_save(TspSolution *self, const char *path);
 
 TspError tsp_solution_load(TspSolution *self, const char *path);
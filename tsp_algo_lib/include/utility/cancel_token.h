@@ -0,0 +1,25 @@
+#ifndef CANCEL_TOKEN_H
+#define CANCEL_TOKEN_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Shared cancellation flag. Any thread may cancel it; time limiters bound to it report
+ * their time as over from then on (see time_limiter_bind_cancel).
+ */
+typedef struct CancelToken CancelToken;
+
+CancelToken *cancel_token_create(void);
+
+void cancel_token_destroy(CancelToken *token);
+
+void cancel_token_cancel(CancelToken *token);
+
+/**
+ * @brief A NULL token is never cancelled.
+ */
+bool cancel_token_is_cancelled(const CancelToken *token);
+
+void cancel_token_reset(CancelToken *token);
+
+#endif //CANCEL_TOKEN_H
@@ -0,0 +1,32 @@
+#ifndef CANDIDATE_LISTS_H
+#define CANDIDATE_LISTS_H
+
+/**
+ * @brief Opaque k-nearest-neighbor candidate lists.
+ * For every node stores its k closest nodes sorted by increasing cost.
+ */
+typedef struct CandidateLists CandidateLists;
+
+/**
+ * @brief Builds the candidate lists from a flattened cost matrix.
+ * Runs in O(n^2) (plus O(k) per accepted insertion) and is meant to be built once per instance.
+ *
+ * @param costs Flattened cost matrix (size n*n).
+ * @param n Number of nodes.
+ * @param k Neighbors per node, clamped to n-1.
+ */
+CandidateLists *candidate_lists_create(const double *costs, int n, int k);
+
+void candidate_lists_destroy(CandidateLists *lists);
+
+/**
+ * @brief Returns the number of neighbors stored per node.
+ */
+int candidate_lists_get_k(const CandidateLists *lists);
+
+/**
+ * @brief Returns the k neighbors of node, nearest first.
+ */
+const int *candidate_lists_get(const CandidateLists *lists, int node);
+
+#endif //CANDIDATE_LISTS_H
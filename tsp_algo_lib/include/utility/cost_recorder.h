@@ -7,20 +7,55 @@
 typedef struct CostRecorder CostRecorder;
 
 /**
- * @brief Creates a new CostRecorder instance.
+ * @brief Kind of a recorded sample.
+ */
+typedef enum {
+    COST_EVENT_ITERATION = 0, /**< Cost of the current solution, no better than the best recorded so far. */
+    COST_EVENT_IMPROVEMENT, /**< New best cost of the recorder. */
+    COST_EVENT_FINAL /**< Final cost of a run (see cost_recorder_add_event). */
+} CostEvent;
+
+/**
+ * @brief Which samples a recorder keeps.
+ */
+typedef enum {
+    COST_RECORD_ALL = 0,
+    COST_RECORD_IMPROVEMENTS /**< Only improvements and final costs. */
+} CostRecordMode;
+
+/**
+ * @brief Creates a new CostRecorder instance. Its clock starts now.
  */
 CostRecorder *cost_recorder_create(size_t initial_capacity);
 
+/**
+ * @brief Creates a recorder for one worker thread: it shares the clock, mode and bound of the parent
+ * and tags its samples with thread_id. Appending to it needs no lock; merge it into the parent once the worker ends.
+ */
+CostRecorder *cost_recorder_create_child(const CostRecorder *parent, int thread_id);
+
 /**
  * @brief Destroys the CostRecorder and frees memory.
  */
 void cost_recorder_destroy(CostRecorder *r);
 
 /**
- * @brief Adds a cost value to the recorder if enabled.
+ * @brief Sets the mode and the maximum number of samples (0 = unbounded). A full recorder halves its
+ * iterations, keeping every other one, and from then on records only every other iteration (the stride doubles).
+ * Improvements and final costs are always kept: a run with more of them than max_samples exceeds the bound.
+ */
+void cost_recorder_set_bounds(CostRecorder *r, CostRecordMode mode, size_t max_samples);
+
+/**
+ * @brief Adds a cost value to the recorder if enabled, as an iteration or an improvement.
  */
 void cost_recorder_add(CostRecorder *r, double cost);
 
+/**
+ * @brief Adds a cost value with an explicit event type.
+ */
+void cost_recorder_add_event(CostRecorder *r, double cost, CostEvent event);
+
 /**
  * @brief Returns the number of recorded costs.
  */
@@ -32,6 +67,21 @@ size_t cost_recorder_get_count(const CostRecorder *r);
  */
 const double *cost_recorder_get_costs(const CostRecorder *r);
 
+/**
+ * @brief Seconds from the start of the recorder clock, one per recorded cost. Same validity as the costs.
+ */
+const double *cost_recorder_get_times(const CostRecorder *r);
+
+/**
+ * @brief Thread id of every recorded cost (0 for the recorder created by cost_recorder_create).
+ */
+const int *cost_recorder_get_threads(const CostRecorder *r);
+
+/**
+ * @brief Event type of every recorded cost.
+ */
+const CostEvent *cost_recorder_get_events(const CostRecorder *r);
+
 /**
  * @brief Enables the recording of costs.
  */
@@ -44,6 +94,15 @@ void cost_recorder_disable(CostRecorder *r);
 
 /**
  * @brief Merges data from source recorder into destination recorder.
+ * Both are kept in time order, so the merged samples of several threads form one time-to-quality curve.
  */
 void cost_recorder_merge(CostRecorder *dest, const CostRecorder *src);
+
+/**
+ * @brief Writes the samples as CSV rows "seconds,cost,thread,event".
+ * @return 0 on success, -1 if the file cannot be written.
+ */
+int cost_recorder_save_csv(const CostRecorder *r, const char *path);
+
+const char *cost_event_to_string(CostEvent event);
 #endif // COST_RECORDER_H
@@ -0,0 +1,38 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "tsp_instance.h"
+
+/**
+ * @brief Opaque uniform grid over the node coordinates (about two nodes per cell).
+ * Supports O(1) removal and nearest-remaining-node queries by expanding rings of cells.
+ * Not thread-safe: every thread needs its own grid.
+ */
+typedef struct SpatialGrid SpatialGrid;
+
+/**
+ * @brief Builds the grid with every node present. The nodes array is borrowed and must outlive the grid.
+ */
+SpatialGrid *spatial_grid_create(const Node *nodes, int n);
+
+void spatial_grid_destroy(SpatialGrid *grid);
+
+/**
+ * @brief Puts back every removed node. O(number of cells).
+ */
+void spatial_grid_fill(SpatialGrid *grid);
+
+/**
+ * @brief Removes a node from the grid. Removing a node twice is a no-op.
+ */
+void spatial_grid_remove(SpatialGrid *grid, int node);
+
+/**
+ * @brief Returns the remaining node closest (Euclidean) to `node`, excluding `node` itself.
+ * @return The node index, or -1 if no other node remains.
+ */
+int spatial_grid_nearest(const SpatialGrid *grid, int node);
+
+int spatial_grid_count(const SpatialGrid *grid);
+
+#endif //SPATIAL_GRID_H
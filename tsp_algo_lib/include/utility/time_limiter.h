@@ -2,16 +2,33 @@
 #define TIME_LIMITER_H
 
 #include <stdbool.h>
+#include "cancel_token.h"
 
 /**
  * @brief Lightweight time limiter (value-type).
- * Tracks elapsed time against a fixed limit.
+ * Tracks elapsed time against a fixed limit, and optionally a shared cancellation token.
  */
 typedef struct {
     double start_time;
     double limit_seconds;
+    const CancelToken *cancel; // borrowed, may be NULL
+    CancelToken *expired; // borrowed, may be NULL: cancelled by the first copy that sees the time over
 } TimeLimiter;
 
+/**
+ * @brief Clock reads of time_limiter_poll are spaced about this far apart, which bounds how late an expiry is seen.
+ */
+#define DEADLINE_POLL_INTERVAL 0.0002
+
+/**
+ * @brief State of one time_limiter_poll call site (zero-initialize it). Not shared between threads.
+ */
+typedef struct {
+    unsigned int stride; // calls between two clock reads
+    unsigned int countdown;
+    double last_read;
+} DeadlinePacer;
+
 /**
  * @brief Creates a time limiter with the given max duration.
  */
@@ -23,10 +40,29 @@ TimeLimiter time_limiter_create(double limit_seconds);
 void time_limiter_start(TimeLimiter *limiter);
 
 /**
- * @brief Checks whether the time limit has been exceeded.
+ * @brief Makes the limiter report its time as over once the token is cancelled (NULL unbinds).
+ * Copies of the limiter made afterwards share the token.
+ */
+void time_limiter_bind_cancel(TimeLimiter *limiter, const CancelToken *token);
+
+/**
+ * @brief Shares the expiry between the copies of the limiter (one per worker thread): the first copy that finds
+ * the time over cancels the token, and the others stop at their next check without reading the clock.
+ * The token is owned by the caller and must outlive every copy.
+ */
+void time_limiter_share_expiry(TimeLimiter *limiter, CancelToken *expired);
+
+/**
+ * @brief Checks whether the time limit has been exceeded or the bound token cancelled.
  */
 bool time_limiter_is_over(const TimeLimiter *limiter);
 
+/**
+ * @brief time_limiter_is_over for hot loops: the tokens are checked on every call, the clock only every
+ * pacer->stride calls. The stride adapts so that clock reads happen about every DEADLINE_POLL_INTERVAL.
+ */
+bool time_limiter_poll(const TimeLimiter *limiter, DeadlinePacer *pacer);
+
 /**
  * @brief Returns the remaining time in seconds.
  * Returns 0.0 if the time limit has already been exceeded.
@@ -0,0 +1,80 @@
+#ifndef TOUR_HASH_H
+#define TOUR_HASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Zobrist-style key of the undirected edge {u, v}.
+ */
+static inline uint64_t tour_edge_key(const int u, const int v) {
+    const uint64_t lo = (uint64_t) (uint32_t) (u < v ? u : v);
+    const uint64_t hi = (uint64_t) (uint32_t) (u < v ? v : u);
+    // splitmix64 finalizer
+    uint64_t z = (hi << 32 | lo) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief XOR of the edge keys of a closed tour (n+1 ints).
+ * Equal for every rotation and for both orientations of the same cycle.
+ */
+uint64_t tour_hash(const int *tour, int n);
+
+/**
+ * @brief Updates a tour hash for the 2-opt move that replaces edges (a,b),(c,d) with (a,c),(b,d).
+ */
+static inline uint64_t tour_hash_two_opt(const uint64_t hash, const int a, const int b, const int c, const int d) {
+    return hash ^ tour_edge_key(a, b) ^ tour_edge_key(c, d) ^ tour_edge_key(a, c) ^ tour_edge_key(b, d);
+}
+
+/**
+ * @brief Lock-free set of tour hashes (open addressing, CAS insertion).
+ * Insertions are safe from any number of threads; clearing is not.
+ */
+typedef struct TourHashSet TourHashSet;
+
+/**
+ * @brief Creates a set able to hold at least `capacity` hashes.
+ */
+TourHashSet *tour_hash_set_create(int capacity);
+
+void tour_hash_set_destroy(TourHashSet *set);
+
+/**
+ * @brief Adds a hash to the set.
+ * @return false if the hash was already present. A full set stores nothing and returns true.
+ */
+bool tour_hash_set_insert(TourHashSet *set, uint64_t hash);
+
+bool tour_hash_set_contains(const TourHashSet *set, uint64_t hash);
+
+/**
+ * @brief Empties the set. Must not run concurrently with insertions.
+ */
+void tour_hash_set_clear(TourHashSet *set);
+
+/**
+ * @brief Lossy, lock-free map from tour hash to cost, shared by the threads of a run.
+ * Direct mapped: a store overwrites the previous entry of its slot. Entries torn by concurrent
+ * stores are detected on lookup and reported as misses.
+ */
+typedef struct TourCache TourCache;
+
+/**
+ * @brief Creates a cache with `capacity` slots (rounded up to a power of two).
+ */
+TourCache *tour_cache_create(int capacity);
+
+void tour_cache_destroy(TourCache *cache);
+
+/**
+ * @return true and the cached cost if `hash` is in the cache.
+ */
+bool tour_cache_lookup(const TourCache *cache, uint64_t hash, double *cost);
+
+void tour_cache_store(TourCache *cache, uint64_t hash, double cost);
+
+#endif //TOUR_HASH_H
@@ -1,37 +1,49 @@
 #include "benders_loop.h"
 #include "cplex_solver_wrapper.h"
+#include "mip_backend.h"
 #include "subtour_separator.h"
 #include "logger.h"
 #include "c_util.h"
 #include "time_limiter.h"
 #include "local_search.h"
 #include "tsp_math.h"
+#include "subtour_patching.h"
 #include <stdlib.h>
 
 static void run_benders(const TspInstance *inst,
                         TspSolution *sol,
                         const void *cfg_void,
                         CostRecorder *rec) {
-#ifdef ENABLE_CPLEX
     const BendersConfig *cfg = cfg_void;
+    const MipBackend *mip = mip_backend_default();
+    if (!mip) {
+        if_verbose(VERBOSE_INFO, "[ERROR] Benders unavailable (no MIP solver)\n");
+        return;
+    }
     int n = tsp_instance_get_num_nodes(inst);
     const double *costs = tsp_instance_get_cost_matrix(inst);
 
-    CplexSolverContext *ctx = cplex_solver_create(inst);
-    if (!ctx) return;
+    void *model = mip->create(inst);
+    if (!model) return;
 
-    if (cplex_solver_build_base_model(ctx, inst)) {
-        cplex_solver_destroy(ctx);
+    if (mip->build_model(model, inst)) {
+        mip->destroy(model);
         return;
     }
 
     TimeLimiter timer = time_limiter_create(cfg->time_limit);
     time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(sol));
 
     ConnectedComponents *cc = connected_components_create(n);
     bool optimal_found = false;
 
     int *tour = tsp_malloc((n + 1) * sizeof(int));
+    int *adj = tsp_malloc(2 * n * sizeof(int));
+    int *adj_owner = tsp_malloc(2 * n * sizeof(int)); // adj[e] is a neighbor of adj_owner[e]
+    for (int e = 0; e < 2 * n; e++) adj_owner[e] = e / 2;
+    SubtourPatcher *patcher = subtour_patcher_create(n);
+    const CandidateLists *candidates = tsp_instance_get_candidate_lists(inst);
 
     for (int it = 0; it < cfg->max_iterations; it++) {
         double remaining = time_limiter_get_remaining(&timer);
@@ -41,23 +53,26 @@ static void run_benders(const TspInstance *inst,
             break;
         }
 
-        cplex_solver_set_time_limit(ctx, remaining);
+        mip->set_time_limit(model, remaining);
 
-        if (cplex_solver_optimize(ctx) != 0) {
+        if (mip->optimize(model) != 0) {
             if_verbose(VERBOSE_DEBUG, "Benders: optimization failed at iter %d\n", it);
             break;
         }
 
-        if (!cplex_solver_has_solution(ctx)) {
+        if (!mip->has_solution(model)) {
             if_verbose(VERBOSE_INFO, "Benders: no integer solution at iter %d\n", it);
             break;
         }
 
         double lp_obj = 0.0;
-        if (cplex_solver_extract_solution(ctx, &lp_obj) != 0) break;
+        if (mip->extract_solution(model, &lp_obj) != 0) break;
 
-        const double *x = cplex_solver_get_x(ctx);
-        find_connected_components(cc, n, x);
+        const double *x = mip->get_x(model);
+        // A 2-regular master point is scanned once: its components come from the adjacency in O(n alpha(n))
+        const bool two_regular = subtour_adjacency_from_x(x, n, adj);
+        if (two_regular) find_connected_components_sparse(cc, n, adj_owner, adj, NULL, 2 * n);
+        else find_connected_components(cc, n, x);
 
         if (cc->num_components == 1) {
             cplex_solver_reconstruct_tour(n, x, tour);
@@ -72,26 +87,28 @@ static void run_benders(const TspInstance *inst,
 
         if_verbose(VERBOSE_DEBUG, "Benders: iter %d, %d subtours found\n", it, cc->num_components);
 
-        for (int c = 1; c <= cc->num_components; c++) {
-            int sz = 0;
-            int *nodes = tsp_malloc(n * sizeof(int));
-
-            for (int i = 0; i < n; i++)
-                if (cc->component_of_node[i] == c)
-                    nodes[sz++] = i;
+        // Patch every master solution into a tour: the incumbent improves while the bound rises
+        if (two_regular) {
+            subtour_patcher_merge(patcher, adj, costs, candidates);
+            subtour_adjacency_to_tour(adj, n, tour);
+            subtour_patcher_improve(patcher, tour, costs, candidates);
+            const double patched_cost = calculate_tour_cost(tour, n, costs);
+            if (tsp_solution_update_if_better(sol, tour, patched_cost)) {
+                cost_recorder_add(rec, patched_cost);
+                if_verbose(VERBOSE_DEBUG, "Benders: iter %d, patched tour %.2f\n", it, patched_cost);
+            }
+        }
 
-            cplex_solver_add_sec(ctx, inst, nodes, sz);
-            tsp_free(nodes);
+        for (int c = 0; c < cc->num_components; c++) {
+            mip->add_sec(model, inst, cc->component_nodes + cc->component_start[c], cc->nodes_in_component[c]);
         }
     }
 
     // Fallback: If optimal not found, try to patch the last integer solution
-    if (!optimal_found && cplex_solver_has_solution(ctx)) {
+    if (!optimal_found && mip->has_solution(model)) {
         if_verbose(VERBOSE_INFO, "Benders: Attempting fallback patching + 2-Opt...\n");
 
-        const double *x = cplex_solver_get_x(ctx);
-
-        cplex_solver_reconstruct_tour(n, x, tour);
+        mip->extract_tour(model, n, tour);
 
         double patched_cost = calculate_tour_cost(tour, n, costs);
 
@@ -101,6 +118,7 @@ static void run_benders(const TspInstance *inst,
 
         TimeLimiter patch_timer = time_limiter_create(remaining);
         time_limiter_start(&patch_timer);
+        time_limiter_bind_cancel(&patch_timer, tsp_solution_get_cancel_token(sol));
 
         double improvement = two_opt(tour, n, costs, patch_timer);
         patched_cost += improvement;
@@ -112,12 +130,11 @@ static void run_benders(const TspInstance *inst,
     }
 
     tsp_free(tour);
+    tsp_free(adj);
+    tsp_free(adj_owner);
+    subtour_patcher_destroy(patcher);
     connected_components_destroy(cc);
-    cplex_solver_destroy(ctx);
-#else
-    (void) inst; (void) sol; (void) cfg_void; (void) rec;
-    if_verbose(VERBOSE_INFO, "[ERROR] CPLEX not enabled\n");
-#endif
+    mip->destroy(model);
 }
 
 static void free_benders_config(void *cfg) {
@@ -1,10 +1,11 @@
 #include "branch_and_cut.h"
-#include "cplex_solver_wrapper.h"
+#include "mip_backend.h"
 #include "logger.h"
 #include "c_util.h"
 #include "time_limiter.h"
 #include "constructive.h"
 #include "local_search.h"
+#include <float.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -14,44 +15,86 @@ static void run_bc(const TspInstance *inst,
                    TspSolution *sol,
                    const void *cfg_void,
                    CostRecorder *rec) {
-#ifdef ENABLE_CPLEX
     const BranchCutConfig *cfg = cfg_void;
+    const MipBackend *mip = mip_backend_default();
+    if (!mip) {
+        if_verbose(VERBOSE_INFO, "[ERROR] Branch & Cut unavailable (no MIP solver)\n");
+        return;
+    }
     int n = tsp_instance_get_num_nodes(inst);
     const double *original_costs = tsp_instance_get_cost_matrix(inst);
 
-    CplexSolverContext *ctx = cplex_solver_create(inst);
-    if (!ctx) return;
+    void *model = mip->create(inst);
+    if (!model) return;
 
-    if (cplex_solver_build_base_model(ctx, inst) != 0) {
-        cplex_solver_destroy(ctx);
-        return;
+    const bool sparse = cfg->sparse_k > 0 && mip->build_sparse_model && mip->price_edges;
+    if (cfg->sparse_k > 0 && !sparse)
+        if_verbose(VERBOSE_INFO, "BC: %s has no sparse model, solving the complete one\n", mip->name);
+    int *current_tour = NULL;
+    if (tsp_solution_get_cost(sol) > 0) {
+        current_tour = tsp_malloc((n + 1) * sizeof(int));
+        tsp_solution_get_tour(sol, current_tour);
     }
 
-    cplex_solver_install_sec_callback(ctx, inst);
+    TimeLimiter timer = time_limiter_create(cfg->time_limit);
+    time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(sol));
 
-    // Warm start from current solution if available
-    if (tsp_solution_get_cost(sol) > 0) {
-        int *current_tour = tsp_malloc((n + 1) * sizeof(int));
-        tsp_solution_get_tour(sol, current_tour);
-        cplex_solver_add_mip_start(ctx, n, current_tour);
+    // The sparse model keeps the edges of the warm start, and the LP prices in the others it needs
+    const int build_status = sparse
+                                 ? mip->build_sparse_model(model, inst, cfg->sparse_k, current_tour)
+                                 : mip->build_model(model, inst);
+    if (build_status != 0 || (sparse && mip->price_edges(model, inst, DBL_MAX, NULL, NULL) != 0)) {
         tsp_free(current_tour);
+        mip->destroy(model);
+        return;
     }
 
-    cplex_solver_set_time_limit(ctx, cfg->time_limit);
+    if (mip->set_fractional_sec_depth) mip->set_fractional_sec_depth(model, cfg->cut_depth);
+    mip->install_sec_callback(model, inst);
 
-    TimeLimiter timer = time_limiter_create(cfg->time_limit);
-    time_limiter_start(&timer);
+    // Warm start from current solution if available
+    if (current_tour) mip->add_mip_start(model, n, current_tour);
+
+    mip->set_time_limit(model, time_limiter_get_remaining(&timer));
+
+    int status = mip->optimize(model);
+
+    /*
+     * The optimum of the sparse model is only proven for the complete graph once no missing edge can beat it:
+     * price against its cost, and solve again from it while edges enter.
+     */
+    while (sparse && status == 0 && mip->is_optimal(model) && !time_limiter_is_over(&timer)) {
+        double cost = 0.0, lower_bound = 0.0;
+        int added = 0;
+        if (mip->extract_solution(model, &cost) != 0) break;
+        if (!current_tour) current_tour = tsp_malloc((n + 1) * sizeof(int));
+        mip->extract_tour(model, n, current_tour);
+        if (mip->price_edges(model, inst, cost, &lower_bound, &added) != 0) break;
+        if (added == 0) {
+            if (lower_bound != -DBL_MAX)
+                if_verbose(VERBOSE_INFO, "BC: sparse optimum %.2f proven by pricing (LP bound %.2f)\n", cost,
+                           lower_bound);
+            else
+                if_verbose(VERBOSE_INFO, "BC: sparse optimum %.2f not proven, the LP could not be priced out\n",
+                           cost);
+            break;
+        }
 
-    int status = cplex_solver_optimize(ctx);
+        if_verbose(VERBOSE_INFO, "BC: %d edges priced in, solving again\n", added);
+        mip->add_mip_start(model, n, current_tour);
+        mip->set_time_limit(model, time_limiter_get_remaining(&timer));
+        status = mip->optimize(model);
+    }
+    tsp_free(current_tour);
 
-    // Case 1: CPLEX found an integer solution
-    if (cplex_solver_has_solution(ctx)) {
+    // Case 1: the solver found an integer solution
+    if (mip->has_solution(model)) {
         double cost = 0.0;
-        cplex_solver_extract_solution(ctx, &cost);
-        const double *x = cplex_solver_get_x(ctx);
+        mip->extract_solution(model, &cost);
 
         int *tour = tsp_malloc((n + 1) * sizeof(int));
-        cplex_solver_reconstruct_tour(n, x, tour);
+        mip->extract_tour(model, n, tour);
 
         tsp_solution_update_if_better(sol, tour, cost);
         cost_recorder_add(rec, cost);
@@ -62,14 +105,14 @@ static void run_bc(const TspInstance *inst,
         if_verbose(VERBOSE_INFO, "BC: No integer solution found. Attempting LP-guided fallback.\n");
 
         double *biased_costs = tsp_malloc(n * n * sizeof(double));
-        const double *x_frac = cplex_solver_get_x(ctx); // LP relaxation values
+        const double *x_frac = mip->get_x(model); // LP relaxation values
 
         // Create biased costs: Cost_new = Cost_old * (1 - 0.9 * x_frac)
         // If x_frac is close to 1, cost becomes very small, guiding GRASP to pick it.
         for (int i = 0; i < n; i++) {
             for (int j = i + 1; j < n; j++) {
-                int idx = xpos(i, j, n);
-                double val = x_frac[idx]; // Fractional value [0, 1]
+                int idx = mip->get_col(model, i, j, n);
+                double val = idx >= 0 ? x_frac[idx] : 0.0; // Fractional value [0, 1]
                 double weight = 1.0 - (0.9 * val);
 
                 biased_costs[i * n + j] = original_costs[i * n + j] * weight;
@@ -81,11 +124,12 @@ static void run_bc(const TspInstance *inst,
         double dummy_cost = 0.0;
         RandomState rng;
         random_init(&rng, n);
-        int res = grasp_nearest_neighbor_tour(0, tour, n, biased_costs, &dummy_cost, 5, 0.9, &rng);
+        int res = grasp_nearest_neighbor_tour(0, tour, n, biased_costs, &dummy_cost, 5, 0.9, &rng, NULL);
 
         if (res == 0) {
             TimeLimiter remaining_timer = time_limiter_create(2.0); // Quick refinement
             time_limiter_start(&remaining_timer);
+            time_limiter_bind_cancel(&remaining_timer, tsp_solution_get_cancel_token(sol));
 
             two_opt(tour, n, original_costs, remaining_timer);
 
@@ -101,11 +145,7 @@ static void run_bc(const TspInstance *inst,
         tsp_free(biased_costs);
     }
 
-    cplex_solver_destroy(ctx);
-#else
-    (void) inst; (void) sol; (void) cfg_void; (void) rec;
-    if_verbose(VERBOSE_INFO, "[ERROR] Branch & Cut unavailable (no CPLEX)\n");
-#endif
+    mip->destroy(model);
 }
 
 static void free_bc_config(void *cfg) { tsp_free(cfg); }
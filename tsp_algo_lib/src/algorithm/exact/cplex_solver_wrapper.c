@@ -1,9 +1,19 @@
 #include "cplex_solver_wrapper.h"
+#include "mip_backend.h"
 #include "subtour_separator.h"
+#include "tsp_model_csr.h"
+#include "min_cut_separator.h"
+#include "subtour_patching.h"
+#include "sparse_edge_set.h"
+#include "tsp_math.h"
+#include "constants.h"
 #include "logger.h"
 #include "c_util.h"
+#include "arena.h"
+#include <float.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 int xpos(int i, int j, int num_nodes) {
     if (i == j) return -1;
@@ -66,15 +76,133 @@ void cplex_solver_reconstruct_tour(int n, const double *x, int *tour) {
 
 #ifdef ENABLE_CPLEX
 #include <ilcplex/cplex.h>
+#include <pthread.h>
+
+// Upper bound on the nodes held by the SEC pool between two flushes
+#define SEC_POOL_MAX_NNZ (1 << 23)
+// A fractional SEC is only cut when x(delta(S)) < 2 - FRACTIONAL_SEC_VIOLATION
+#define FRACTIONAL_SEC_VIOLATION 0.01
+#define FRACTIONAL_SEC_MAX_CUTS 32
+// Pricing of the sparse model: LP rounds (SEC separation or new columns) before giving up on the proof,
+// most negative edges priced in per node and round, and the reduced cost below which an edge enters
+#define PRICING_MAX_ROUNDS 200
+#define PRICING_EDGES_PER_NODE 5
+#define PRICING_SEC_MAX_CUTS 64
+#define PRICING_EPS 1e-6
+
+/* Node sets S of SECs x(E(S)) <= |S| - 1, stored CSR. */
+typedef struct {
+    int num_sets;
+    int set_capacity;
+    int *beg;
+    int num_nodes;
+    int node_capacity;
+    int *nodes;
+} SecSets;
+
+/*
+ * SECs separated by the lazy callback, kept for the next solves of the same model. They are stored as node
+ * sets, so that their rows get the columns of the model at the flush; the callback threads append under the mutex.
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    bool enabled;
+    SecSets sets;
+} SecPool;
 
 struct CplexSolverContext {
     CPXENVptr env;
     CPXLPptr lp;
+    int num_nodes;
     int num_cols;
+    bool with_names; // name columns and rows in cplex_solver_build_base_model (for model dumps)
+    int fractional_depth; // deepest node with user SEC cuts, -1 for none
     double *x_star;
     void *callback_data;
+    int *fixed_cols; // columns fixed since the last cplex_solver_reset_bounds
+    int num_fixed;
+    SecPool pool;
+    int lb_row; // local branching row, -1 until cplex_solver_set_local_branching adds it
+    int *lb_cols; // columns of the current center
+    unsigned char *col_mark; // num_cols scratch flags
+    SparseEdgeSet *edges; // columns of the sparse model, NULL when every edge has its xpos column
+    const double *costs; // objective of the columns priced into the sparse model
+    SecSets sec_sets; // SEC rows of the sparse model, which the columns priced in later join
+    int *sec_rows; // row of each of sec_sets
 };
 
+/*
+ * Scratch owned by one CPLEX thread: x_star, components and cut buffers are carved from the
+ * arena and rewound after every candidate, so the callback stops allocating after warm-up.
+ */
+typedef struct {
+    Arena *arena;
+    ConnectedComponents *cc;
+    MinCutSeparator *min_cut; // created on the first relaxation point
+    SubtourPatcher *patcher; // created on the first candidate with subtours
+} CallbackScratch;
+
+typedef struct {
+    const TspInstance *inst;
+    const double *costs;
+    const CandidateLists *candidates; // neighbor lists of the patching heuristic, owned by the instance
+    const SparseEdgeSet *edges; // NULL for the complete graph
+    int num_cols;
+    int num_slots;
+    CallbackScratch *slots; // Indexed by CPLEX thread id
+    SecPool *pool;
+    int fractional_depth;
+} CallbackCtx;
+
+static void sec_sets_add(SecSets *sets, const int *nodes, const int size) {
+    if (sets->num_sets == sets->set_capacity) {
+        sets->set_capacity = sets->set_capacity ? 2 * sets->set_capacity : 64;
+        sets->beg = tsp_realloc(sets->beg, sets->set_capacity * sizeof(int));
+    }
+    if (sets->num_nodes + size > sets->node_capacity) {
+        while (sets->num_nodes + size > sets->node_capacity)
+            sets->node_capacity = sets->node_capacity ? 2 * sets->node_capacity : 4096;
+        sets->nodes = tsp_realloc(sets->nodes, sets->node_capacity * sizeof(int));
+    }
+    sets->beg[sets->num_sets++] = sets->num_nodes;
+    memcpy(sets->nodes + sets->num_nodes, nodes, size * sizeof(int));
+    sets->num_nodes += size;
+}
+
+static const int *sec_sets_get(const SecSets *sets, const int s, int *size) {
+    const int end = s + 1 < sets->num_sets ? sets->beg[s + 1] : sets->num_nodes;
+    *size = end - sets->beg[s];
+    return sets->nodes + sets->beg[s];
+}
+
+static void sec_sets_free(SecSets *sets) {
+    tsp_free(sets->beg);
+    tsp_free(sets->nodes);
+}
+
+static void sec_pool_clear(SecPool *pool) {
+    pool->sets.num_sets = 0;
+    pool->sets.num_nodes = 0;
+}
+
+static void sec_pool_add(SecPool *pool, const int *nodes, const int size) {
+    if (!pool->enabled) return;
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->sets.num_nodes + size <= SEC_POOL_MAX_NNZ) sec_sets_add(&pool->sets, nodes, size);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static void callback_ctx_destroy(CallbackCtx *cb) {
+    for (int t = 0; t < cb->num_slots; t++) {
+        arena_destroy(cb->slots[t].arena);
+        connected_components_destroy(cb->slots[t].cc);
+        min_cut_separator_destroy(cb->slots[t].min_cut);
+        subtour_patcher_destroy(cb->slots[t].patcher);
+    }
+    tsp_free(cb->slots);
+    tsp_free(cb);
+}
+
 CplexSolverContext *cplex_solver_create(const TspInstance *inst) {
     int status = 0;
     CplexSolverContext *ctx = tsp_malloc(sizeof *ctx);
@@ -93,11 +221,26 @@ CplexSolverContext *cplex_solver_create(const TspInstance *inst) {
         return NULL;
     }
 
-    int n = tsp_instance_get_num_nodes(inst);
-    ctx->num_cols = n * (n - 1) / 2;
-    ctx->x_star = tsp_calloc(ctx->num_cols, sizeof(double));
+    // Sized by the model built next: complete graph or sparse
+    (void) inst;
+    ctx->num_nodes = 0;
+    ctx->num_cols = 0;
+    ctx->x_star = NULL;
 
+    ctx->with_names = false;
+    ctx->fractional_depth = -1;
     ctx->callback_data = NULL;
+    ctx->fixed_cols = NULL;
+    ctx->num_fixed = 0;
+    ctx->pool = (SecPool){.enabled = false};
+    ctx->lb_row = -1;
+    ctx->lb_cols = NULL;
+    ctx->col_mark = NULL;
+    ctx->edges = NULL;
+    ctx->costs = NULL;
+    ctx->sec_sets = (SecSets){.num_sets = 0};
+    ctx->sec_rows = NULL;
+    pthread_mutex_init(&ctx->pool.mutex, NULL);
     CPXsetintparam(ctx->env, CPX_PARAM_SCRIND, CPX_OFF);
     return ctx;
 }
@@ -107,56 +250,192 @@ void cplex_solver_destroy(CplexSolverContext *ctx) {
     if (ctx->lp) CPXfreeprob(ctx->env, &ctx->lp);
     if (ctx->env) CPXcloseCPLEX(&ctx->env);
     if (ctx->callback_data) {
-        tsp_free(ctx->callback_data);
+        callback_ctx_destroy(ctx->callback_data);
         ctx->callback_data = NULL;
     }
     tsp_free(ctx->x_star);
+    tsp_free(ctx->fixed_cols);
+    tsp_free(ctx->lb_cols);
+    tsp_free(ctx->col_mark);
+    sparse_edge_set_destroy(ctx->edges);
+    sec_sets_free(&ctx->sec_sets);
+    tsp_free(ctx->sec_rows);
+    sec_sets_free(&ctx->pool.sets);
+    pthread_mutex_destroy(&ctx->pool.mutex);
     tsp_free(ctx);
 }
 
 int cplex_solver_build_base_model(CplexSolverContext *ctx, const TspInstance *inst) {
-    int n = tsp_instance_get_num_nodes(inst);
-    const double *costs = tsp_instance_get_cost_matrix(inst);
-    int status = 0;
+    TspModelCsr *model = tsp_model_csr_build(inst, ctx->with_names, 0);
+
+    // Lower bounds default to 0; one call per block instead of one per column and per row
+    int status = CPXnewcols(ctx->env, ctx->lp, model->num_cols, model->obj, NULL, model->ub, model->ctype,
+                            model->colname);
+    if (!status)
+        status = CPXaddrows(ctx->env, ctx->lp, 0, model->num_rows, model->nnz, model->rhs, model->sense,
+                            model->rmatbeg, model->rmatind, model->rmatval, NULL, model->rowname);
+    if (!status) {
+        ctx->num_nodes = tsp_instance_get_num_nodes(inst);
+        ctx->num_cols = model->num_cols;
+        tsp_free(ctx->x_star);
+        ctx->x_star = tsp_calloc(ctx->num_cols, sizeof(double));
+    }
 
-    char binary = 'B';
-    char colname[64];
-    char *colname_ptr = colname;
+    tsp_model_csr_destroy(model);
+    return status;
+}
 
-    for (int i = 0; i < n; i++) {
-        for (int j = i + 1; j < n; j++) {
-            double cost = costs[i * n + j];
-            double lb = 0.0, ub = 1.0;
-            sprintf(colname, "x_%d_%d", i + 1, j + 1);
-            status = CPXnewcols(ctx->env, ctx->lp, 1, &cost, &lb, &ub, &binary, &colname_ptr);
-            if (status) return status;
+static int column_of(const SparseEdgeSet *edges, const int u, const int v, const int n) {
+    return edges ? sparse_edge_set_find(edges, u, v) : xpos(u, v, n);
+}
+
+/*
+ * Columns of the sparse model inside a node set: every node gets `id` in label, then each column with
+ * both endpoints labelled id is written to ind once. With ind == NULL the columns are only counted.
+ */
+static int sparse_sec_columns(const SparseEdgeSet *edges, const int *nodes, const int size, int *label, const int id,
+                              int *ind) {
+    for (int i = 0; i < size; i++) label[nodes[i]] = id;
+    int nnz = 0;
+    for (int i = 0; i < size; i++) {
+        const int u = nodes[i];
+        for (int e = edges->head[u]; e != -1; e = edges->next[e]) {
+            const int col = e >> 1;
+            // Listed from its smaller endpoint only
+            if (edges->edge_u[col] != u || label[edges->edge_v[col]] != id) continue;
+            if (ind) ind[nnz] = col;
+            nnz++;
         }
     }
+    return nnz;
+}
+
+int cplex_solver_get_col(const CplexSolverContext *ctx, const int u, const int v, const int num_nodes) {
+    return column_of(ctx->edges, u, v, num_nodes);
+}
 
-    double rhs = 2.0;
-    char sense = 'E';
-    int *indices = tsp_malloc(n * sizeof(int));
-    double *values = tsp_malloc(n * sizeof(double));
+/* Records a SEC row of the sparse model: the columns priced in later get their coefficient in it. */
+static void track_sec_row(CplexSolverContext *ctx, const int row, const int *nodes, const int size) {
+    if (!ctx->edges) return;
+    const int capacity = ctx->sec_sets.set_capacity;
+    sec_sets_add(&ctx->sec_sets, nodes, size);
+    if (ctx->sec_sets.set_capacity != capacity)
+        ctx->sec_rows = tsp_realloc(ctx->sec_rows, ctx->sec_sets.set_capacity * sizeof(int));
+    ctx->sec_rows[ctx->sec_sets.num_sets - 1] = row;
+}
 
+/*
+ * Creates the columns of the edges from `first` on in lp, with their coefficients in one more call: the two
+ * degree rows, and every SEC row of sec_sets whose set holds both endpoints. The pricing LP is a clone of
+ * the model that gets the same rows in the same order, so the rows of sec_sets hold for both. On the model
+ * of the context, the solution buffer and the callback follow the new column count.
+ */
+static int add_edge_columns(CplexSolverContext *ctx, CPXLPptr lp, const int first, const bool integer) {
+    const SparseEdgeSet *edges = ctx->edges;
+    const int n = edges->num_nodes;
+    const int count = edges->num_edges - first;
+    if (count <= 0) return 0;
+
+    double *obj = tsp_malloc(count * sizeof(double));
+    double *ub = tsp_malloc(count * sizeof(double));
+    char *ctype = integer ? tsp_malloc(count * sizeof(char)) : NULL;
+    int capacity = 2 * count;
+    int *rows = tsp_malloc(capacity * sizeof(int));
+    int *cols = tsp_malloc(capacity * sizeof(int));
+    for (int k = 0; k < count; k++) {
+        const int col = first + k;
+        obj[k] = ctx->costs[edges->edge_u[col] * n + edges->edge_v[col]];
+        ub[k] = 1.0;
+        if (ctype) ctype[k] = 'B';
+        rows[2 * k] = edges->edge_u[col];
+        rows[2 * k + 1] = edges->edge_v[col];
+        cols[2 * k] = cols[2 * k + 1] = col;
+    }
 
-    for (int h = 0; h < n; h++) {
-        int nnz = 0;
-        for (int i = 0; i < n; i++) {
-            if (i == h) continue;
-            indices[nnz] = xpos(h, i, n);
-            values[nnz++] = 1.0;
+    int nnz = 2 * count;
+    if (ctx->sec_sets.num_sets > 0) {
+        int *label = tsp_calloc(n, sizeof(int));
+        for (int r = 0; r < ctx->sec_sets.num_sets; r++) {
+            int size;
+            const int *nodes = sec_sets_get(&ctx->sec_sets, r, &size);
+            for (int i = 0; i < size; i++) label[nodes[i]] = r + 1;
+            for (int col = first; col < edges->num_edges; col++) {
+                if (label[edges->edge_u[col]] != r + 1 || label[edges->edge_v[col]] != r + 1) continue;
+                if (nnz == capacity) {
+                    capacity *= 2;
+                    rows = tsp_realloc(rows, capacity * sizeof(int));
+                    cols = tsp_realloc(cols, capacity * sizeof(int));
+                }
+                rows[nnz] = ctx->sec_rows[r];
+                cols[nnz++] = col;
+            }
         }
-        int matbeg = 0;
-        sprintf(colname, "deg_%d", h + 1);
-        status = CPXaddrows(ctx->env, ctx->lp, 0, 1, nnz, &rhs, &sense, &matbeg, indices, values, NULL, &colname_ptr);
-        if (status) break;
+        tsp_free(label);
+    }
+    double *vals = tsp_malloc(nnz * sizeof(double));
+    for (int k = 0; k < nnz; k++) vals[k] = 1.0;
+
+    // An LP gets continuous columns: a ctype array would turn it into a MIP
+    int status = CPXnewcols(ctx->env, lp, count, obj, NULL, ub, ctype, NULL);
+    if (!status) status = CPXchgcoeflist(ctx->env, lp, nnz, rows, cols, vals);
+    if (!status && lp == ctx->lp) {
+        const int old_cols = ctx->num_cols;
+        ctx->num_cols = edges->num_edges;
+        ctx->x_star = tsp_realloc(ctx->x_star, ctx->num_cols * sizeof(double));
+        memset(ctx->x_star + old_cols, 0, (ctx->num_cols - old_cols) * sizeof(double));
+        if (ctx->fixed_cols) ctx->fixed_cols = tsp_realloc(ctx->fixed_cols, ctx->num_cols * sizeof(int));
+        if (ctx->col_mark) {
+            ctx->col_mark = tsp_realloc(ctx->col_mark, ctx->num_cols * sizeof(unsigned char));
+            memset(ctx->col_mark + old_cols, 0, (ctx->num_cols - old_cols) * sizeof(unsigned char));
+        }
+        // Columns only change between solves: the callback reads the new count at the next one
+        if (ctx->callback_data) ((CallbackCtx *) ctx->callback_data)->num_cols = ctx->num_cols;
     }
 
-    tsp_free(indices);
-    tsp_free(values);
+    tsp_free(obj);
+    tsp_free(ub);
+    tsp_free(ctype);
+    tsp_free(rows);
+    tsp_free(cols);
+    tsp_free(vals);
     return status;
 }
 
+int cplex_solver_build_sparse_model(CplexSolverContext *ctx, const TspInstance *inst, const int k, const int *tour) {
+    const int n = tsp_instance_get_num_nodes(inst);
+    ctx->num_nodes = n;
+    ctx->costs = tsp_instance_get_cost_matrix(inst);
+    sparse_edge_set_destroy(ctx->edges);
+    ctx->edges = sparse_edge_set_create(n);
+
+    CandidateLists *candidates = candidate_lists_create(ctx->costs, n, k);
+    sparse_edge_set_add_candidates(ctx->edges, candidates);
+    candidate_lists_destroy(candidates);
+    // A Hamiltonian cycle among the columns keeps the model and its LP feasible; without a tour, 0-1-...-(n-1)
+    for (int i = 0; i < n; i++) {
+        if (tour) sparse_edge_set_add(ctx->edges, tour[i], tour[i + 1]);
+        else sparse_edge_set_add(ctx->edges, i, (i + 1) % n);
+    }
+
+    // Degree rows first and empty: every column, now or priced in later, then lists its own two coefficients
+    double *rhs = tsp_malloc(n * sizeof(double));
+    char *sense = tsp_malloc(n * sizeof(char));
+    for (int h = 0; h < n; h++) {
+        rhs[h] = 2.0;
+        sense[h] = 'E';
+    }
+    int status = CPXnewrows(ctx->env, ctx->lp, n, rhs, sense, NULL, NULL);
+    if (!status) status = add_edge_columns(ctx, ctx->lp, 0, true);
+
+    tsp_free(rhs);
+    tsp_free(sense);
+    return status;
+}
+
+void cplex_solver_set_names(CplexSolverContext *ctx, const bool with_names) {
+    ctx->with_names = with_names;
+}
+
 int cplex_solver_add_local_branching_constraint(CplexSolverContext *ctx, int num_nodes, const int *tour, int k) {
     int nzcnt = num_nodes;
     int *indices = tsp_malloc(nzcnt * sizeof(int));
@@ -182,89 +461,474 @@ int cplex_solver_add_local_branching_constraint(CplexSolverContext *ctx, int num
     return status;
 }
 
+int cplex_solver_set_local_branching(CplexSolverContext *ctx, const int num_nodes, const int *tour, const int k) {
+    if (ctx->lb_row < 0) {
+        const int status = cplex_solver_add_local_branching_constraint(ctx, num_nodes, tour, k);
+        if (status) return status;
+        ctx->lb_row = CPXgetnumrows(ctx->env, ctx->lp) - 1;
+        ctx->lb_cols = tsp_malloc(num_nodes * sizeof(int));
+        for (int i = 0; i < num_nodes; i++) ctx->lb_cols[i] = xpos(tour[i], tour[i + 1], num_nodes);
+        return 0;
+    }
+    if (!ctx->col_mark) ctx->col_mark = tsp_calloc(ctx->num_cols, sizeof(unsigned char));
+
+    // Edges of the new center get coefficient 1, edges only in the old center 0: no column is listed twice
+    int *rows = tsp_malloc(2 * num_nodes * sizeof(int));
+    int *cols = tsp_malloc(2 * num_nodes * sizeof(int));
+    double *vals = tsp_malloc(2 * num_nodes * sizeof(double));
+    int count = 0;
+    for (int i = 0; i < num_nodes; i++) {
+        const int col = xpos(tour[i], tour[i + 1], num_nodes);
+        ctx->col_mark[col] = 1;
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        const int col = ctx->lb_cols[i];
+        if (ctx->col_mark[col]) continue;
+        rows[count] = ctx->lb_row;
+        cols[count] = col;
+        vals[count++] = 0.0;
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        const int col = xpos(tour[i], tour[i + 1], num_nodes);
+        ctx->col_mark[col] = 0;
+        ctx->lb_cols[i] = col;
+        rows[count] = ctx->lb_row;
+        cols[count] = col;
+        vals[count++] = 1.0;
+    }
+
+    int status = CPXchgcoeflist(ctx->env, ctx->lp, count, rows, cols, vals);
+    if (!status) {
+        const double rhs = num_nodes - k;
+        status = CPXchgrhs(ctx->env, ctx->lp, 1, &ctx->lb_row, &rhs);
+    }
+
+    tsp_free(rows);
+    tsp_free(cols);
+    tsp_free(vals);
+    return status;
+}
+
+int cplex_solver_add_reverse_branching(CplexSolverContext *ctx, const int num_nodes, const int *tour, const int k) {
+    int *indices = tsp_malloc(num_nodes * sizeof(int));
+    double *values = tsp_malloc(num_nodes * sizeof(double));
+    for (int i = 0; i < num_nodes; i++) {
+        indices[i] = xpos(tour[i], tour[i + 1], num_nodes);
+        values[i] = 1.0;
+    }
+
+    double rhs = num_nodes - k - 1;
+    char sense = 'L';
+    int matbeg = 0;
+    char *name = "REVERSE_BRANCHING";
+    const int status = CPXaddrows(ctx->env, ctx->lp, 0, 1, num_nodes, &rhs, &sense, &matbeg, indices, values, NULL,
+                                  &name);
+
+    tsp_free(indices);
+    tsp_free(values);
+    return status;
+}
+
 int cplex_solver_fix_edge(CplexSolverContext *ctx, int u, int v, double value, int num_nodes) {
-    int index = xpos(u, v, num_nodes);
+    int index = column_of(ctx->edges, u, v, num_nodes);
     if (index < 0 || index >= ctx->num_cols) {
         return -1;
     }
-    char lu = 'B';
-    double bd = value;
-    return CPXchgbds(ctx->env, ctx->lp, 1, &index, &lu, &bd);
+    return cplex_solver_fix_edges(ctx, &index, 1, value);
+}
+
+int cplex_solver_fix_edges(CplexSolverContext *ctx, const int *cols, const int count, const double value) {
+    if (count <= 0) return 0;
+    if (!ctx->fixed_cols) ctx->fixed_cols = tsp_malloc(ctx->num_cols * sizeof(int));
+
+    char *lu = tsp_malloc(count * sizeof(char));
+    double *bd = tsp_malloc(count * sizeof(double));
+    for (int k = 0; k < count; k++) {
+        lu[k] = 'B';
+        bd[k] = value;
+        // A column fixed twice is only reset once more: harmless
+        if (ctx->num_fixed < ctx->num_cols) ctx->fixed_cols[ctx->num_fixed++] = cols[k];
+    }
+    const int status = CPXchgbds(ctx->env, ctx->lp, count, cols, lu, bd);
+
+    tsp_free(lu);
+    tsp_free(bd);
+    return status;
+}
+
+int cplex_solver_reset_bounds(CplexSolverContext *ctx) {
+    if (ctx->num_fixed == 0) return 0;
+
+    // Lower and upper bound of each fixed column in the same call
+    const int count = 2 * ctx->num_fixed;
+    int *indices = tsp_malloc(count * sizeof(int));
+    char *lu = tsp_malloc(count * sizeof(char));
+    double *bd = tsp_malloc(count * sizeof(double));
+    for (int k = 0; k < ctx->num_fixed; k++) {
+        indices[2 * k] = indices[2 * k + 1] = ctx->fixed_cols[k];
+        lu[2 * k] = 'L';
+        bd[2 * k] = 0.0;
+        lu[2 * k + 1] = 'U';
+        bd[2 * k + 1] = 1.0;
+    }
+    const int status = CPXchgbds(ctx->env, ctx->lp, count, indices, lu, bd);
+    if (!status) ctx->num_fixed = 0;
+
+    tsp_free(indices);
+    tsp_free(lu);
+    tsp_free(bd);
+    return status;
+}
+
+int cplex_solver_clear_mip_starts(CplexSolverContext *ctx) {
+    const int count = CPXgetnummipstarts(ctx->env, ctx->lp);
+    if (count <= 0) return 0;
+    return CPXdelmipstarts(ctx->env, ctx->lp, 0, count - 1);
+}
+
+void cplex_solver_keep_sec_cuts(CplexSolverContext *ctx, const bool keep) {
+    pthread_mutex_lock(&ctx->pool.mutex);
+    ctx->pool.enabled = keep;
+    if (!keep) sec_pool_clear(&ctx->pool);
+    pthread_mutex_unlock(&ctx->pool.mutex);
+}
+
+int cplex_solver_flush_sec_pool(CplexSolverContext *ctx, int *added) {
+    const SecSets *sets = &ctx->pool.sets;
+    const SparseEdgeSet *edges = ctx->edges;
+    const int n = ctx->num_nodes;
+    if (added) *added = 0;
+    // Called between solves: no callback is running
+    if (sets->num_sets == 0) return 0;
+
+    // Rows over the current columns: edges priced in since the separation are part of the cuts too
+    int *label = edges ? tsp_calloc(n, sizeof(int)) : NULL;
+    int nzcnt = 0;
+    for (int r = 0; r < sets->num_sets; r++) {
+        int size;
+        const int *nodes = sec_sets_get(sets, r, &size);
+        nzcnt += edges ? sparse_sec_columns(edges, nodes, size, label, r + 1, NULL) : size * (size - 1) / 2;
+    }
+
+    int *rmatbeg = tsp_malloc(sets->num_sets * sizeof(int));
+    double *rhs = tsp_malloc(sets->num_sets * sizeof(double));
+    char *sense = tsp_malloc(sets->num_sets * sizeof(char));
+    int *ind = tsp_malloc((nzcnt > 0 ? nzcnt : 1) * sizeof(int));
+    double *val = tsp_malloc((nzcnt > 0 ? nzcnt : 1) * sizeof(double));
+    int nnz = 0;
+    for (int r = 0; r < sets->num_sets; r++) {
+        int size;
+        const int *nodes = sec_sets_get(sets, r, &size);
+        rmatbeg[r] = nnz;
+        rhs[r] = (double) (size - 1);
+        sense[r] = 'L';
+        if (edges) {
+            nnz += sparse_sec_columns(edges, nodes, size, label, r + 1, ind + nnz);
+        } else {
+            for (int i = 0; i < size; i++)
+                for (int j = i + 1; j < size; j++) ind[nnz++] = xpos(nodes[i], nodes[j], n);
+        }
+    }
+    for (int k = 0; k < nnz; k++) val[k] = 1.0;
+
+    const int first_row = CPXgetnumrows(ctx->env, ctx->lp);
+    const int status = CPXaddrows(ctx->env, ctx->lp, 0, sets->num_sets, nzcnt, rhs, sense, rmatbeg, ind, val,
+                                  NULL, NULL);
+    if (!status) {
+        for (int r = 0; r < sets->num_sets; r++) {
+            int size;
+            const int *nodes = sec_sets_get(sets, r, &size);
+            track_sec_row(ctx, first_row + r, nodes, size);
+        }
+        if (added) *added = sets->num_sets;
+    }
+    sec_pool_clear(&ctx->pool);
+
+    tsp_free(label);
+    tsp_free(rmatbeg);
+    tsp_free(rhs);
+    tsp_free(sense);
+    tsp_free(ind);
+    tsp_free(val);
+    return status;
+}
+
+void cplex_solver_set_fractional_sec_depth(CplexSolverContext *ctx, const int max_depth) {
+    ctx->fractional_depth = max_depth;
 }
 
 void cplex_solver_set_time_limit(CplexSolverContext *ctx, double seconds) {
     CPXsetdblparam(ctx->env, CPX_PARAM_TILIM, seconds);
 }
 
-typedef struct {
-    const TspInstance *inst;
-    int num_cols;
-} CallbackCtx;
+void cplex_solver_set_threads(CplexSolverContext *ctx, const int num_threads) {
+    CPXsetintparam(ctx->env, CPXPARAM_Threads, num_threads > 0 ? num_threads : 0);
+}
 
-static int CPXPUBLIC lazy_sec_callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, void *userhandle) {
-    (void) contextid;
-    CallbackCtx *cb_ctx = userhandle;
-    int n = tsp_instance_get_num_nodes(cb_ctx->inst);
+/*
+ * subtour_adjacency_from_x for a point of the sparse model.
+ * Returns false if some node does not have exactly two edges above 0.5.
+ */
+static bool sparse_adjacency_from_x(const SparseEdgeSet *edges, const double *x, int *adj) {
+    const int n = edges->num_nodes;
+    for (int i = 0; i < 2 * n; i++) adj[i] = -1;
+    for (int col = 0; col < edges->num_edges; col++) {
+        if (x[col] <= 0.5) continue;
+        const int ends[2] = {edges->edge_u[col], edges->edge_v[col]};
+        for (int s = 0; s < 2; s++) {
+            int *slot = adj + 2 * ends[s];
+            if (slot[1] != -1) return false;
+            slot[slot[0] == -1 ? 0 : 1] = ends[1 - s];
+        }
+    }
+    for (int i = 0; i < 2 * n; i++) {
+        if (adj[i] == -1) return false;
+    }
+    return true;
+}
+
+/*
+ * Patches the subtours of an integer candidate into a tour, polishes it with 2-opt and Or-opt over the
+ * candidate lists and offers it to CPLEX when it beats the incumbent. CPLEX checks it against the bounds
+ * and rows of the model (fixed edges, local branching), so the heuristic does not need to know them.
+ * Buffers come from the caller's arena frame.
+ */
+static void post_patched_tour(CPXCALLBACKCONTEXTptr context, const CallbackCtx *cb_ctx,
+                              CallbackScratch *scratch, const double *x_star) {
+    const int n = tsp_instance_get_num_nodes(cb_ctx->inst);
+    Arena *arena = scratch->arena;
+
+    int *adj = arena_alloc(arena, 2 * n * sizeof(int));
+    if (cb_ctx->edges ? !sparse_adjacency_from_x(cb_ctx->edges, x_star, adj) : !subtour_adjacency_from_x(x_star, n, adj))
+        return;
+
+    if (!scratch->patcher) scratch->patcher = subtour_patcher_create(n);
+    int *tour = arena_alloc(arena, (n + 1) * sizeof(int));
+    subtour_patcher_merge(scratch->patcher, adj, cb_ctx->costs, cb_ctx->candidates);
+    subtour_adjacency_to_tour(adj, n, tour);
+    subtour_patcher_improve(scratch->patcher, tour, cb_ctx->costs, cb_ctx->candidates);
+    const double cost = calculate_tour_cost(tour, n, cb_ctx->costs);
+
+    double incumbent = CPX_INFBOUND;
+    if (CPXcallbackgetinfodbl(context, CPXCALLBACKINFO_BEST_SOL, &incumbent) == 0 && cost >= incumbent - EPSILON)
+        return;
+
+    int *ind = arena_alloc(arena, cb_ctx->num_cols * sizeof(int));
+    double *val = arena_calloc(arena, cb_ctx->num_cols, sizeof(double));
+    for (int i = 0; i < cb_ctx->num_cols; i++) ind[i] = i;
+    for (int i = 0; i < n; i++) {
+        // A sparse model may lack an edge of the patched tour: the tour cannot be posted
+        const int col = column_of(cb_ctx->edges, tour[i], tour[i + 1], n);
+        if (col < 0) return;
+        val[col] = 1.0;
+    }
+
+    if (CPXcallbackpostheursoln(context, cb_ctx->num_cols, ind, val, cost, CPXCALLBACKSOLUTION_CHECKFEAS))
+        if_verbose(VERBOSE_DEBUG, "[ERROR] SEC callback: patched tour (cost %.2f) was not posted\n", cost);
+}
+
+/*
+ * Lazy SECs on an integer candidate: one row per connected component, all rejected in one call.
+ * Every buffer comes from the thread's scratch, so a warmed-up callback does not allocate.
+ */
+static int separate_integer_subtours(CPXCALLBACKCONTEXTptr context, const CallbackCtx *cb_ctx,
+                                     CallbackScratch *scratch) {
+    const int n = tsp_instance_get_num_nodes(cb_ctx->inst);
+    Arena *arena = scratch->arena;
+    const ArenaMark mark = arena_mark(arena);
 
-    double *x_star = tsp_malloc(cb_ctx->num_cols * sizeof(double));
+    double *x_star = arena_alloc(arena, cb_ctx->num_cols * sizeof(double));
 
     double objval;
     int status = CPXcallbackgetcandidatepoint(context, x_star, 0, cb_ctx->num_cols - 1, &objval);
     if (status) {
-        tsp_free(x_star);
+        arena_rewind(arena, mark);
         return status;
     }
 
-    ConnectedComponents *cc = connected_components_create(n);
-    find_connected_components(cc, n, x_star);
+    ConnectedComponents *cc = scratch->cc;
+    const SparseEdgeSet *edges = cb_ctx->edges;
+    if (edges) find_connected_components_sparse(cc, n, edges->edge_u, edges->edge_v, x_star, cb_ctx->num_cols);
+    else find_connected_components(cc, n, x_star);
+    const int k = cc->num_components;
+    if (k <= 1) {
+        arena_rewind(arena, mark);
+        return 0;
+    }
+
+    // Every subtour is rejected in one call: size the batch from the bucketed components
+    int nzcnt = 0;
+    for (int c = 0; c < k; c++) {
+        const int comp_size = cc->nodes_in_component[c];
+        nzcnt += edges
+                     ? sparse_sec_columns(edges, cc->component_nodes + cc->component_start[c], comp_size,
+                                          cc->component_of_node, c + 1, NULL)
+                     : comp_size * (comp_size - 1) / 2;
+    }
 
-    if (cc->num_components > 1) {
-        for (int c = 1; c <= cc->num_components; c++) {
-            int comp_size = 0;
-            int *nodes = tsp_malloc(n * sizeof(int));
+    int *rmatbeg = arena_alloc(arena, k * sizeof(int));
+    double *rhs = arena_alloc(arena, k * sizeof(double));
+    char *sense = arena_alloc(arena, k * sizeof(char));
+    int *ind = arena_alloc(arena, nzcnt * sizeof(int));
+    double *val = arena_alloc(arena, nzcnt * sizeof(double));
 
-            for (int i = 0; i < n; i++) {
-                if (cc->component_of_node[i] == c) nodes[comp_size++] = i;
+    int nnz = 0;
+    for (int c = 0; c < k; c++) {
+        const int *nodes = cc->component_nodes + cc->component_start[c];
+        const int comp_size = cc->nodes_in_component[c];
+        rmatbeg[c] = nnz;
+        rhs[c] = (double) (comp_size - 1);
+        sense[c] = 'L';
+        if (edges) {
+            const int count = sparse_sec_columns(edges, nodes, comp_size, cc->component_of_node, c + 1, ind + nnz);
+            for (int i = 0; i < count; i++) val[nnz++] = 1.0;
+        } else {
+            for (int i = 0; i < comp_size; i++) {
+                for (int j = i + 1; j < comp_size; j++) {
+                    ind[nnz] = xpos(nodes[i], nodes[j], n);
+                    val[nnz++] = 1.0;
+                }
             }
+        }
+        // The complement of a large component gives the same cut with fewer nonzeros
+        if (comp_size <= n / 2) sec_pool_add(cb_ctx->pool, nodes, comp_size);
+    }
 
-            int max_edges = comp_size * (comp_size - 1) / 2;
-            int *ind = tsp_malloc(max_edges * sizeof(int));
-            double *val = tsp_malloc(max_edges * sizeof(double));
+    status = CPXcallbackrejectcandidate(context, k, nzcnt, rhs, sense, rmatbeg, ind, val);
+    if (!status) post_patched_tour(context, cb_ctx, scratch, x_star);
+    arena_rewind(arena, mark);
+    return status;
+}
 
+/*
+ * User cuts on the LP point of the nodes up to fractional_depth: the min-cut separator returns the
+ * violated sets, whose SECs reach CPLEX in one call.
+ */
+static int separate_fractional_subtours(CPXCALLBACKCONTEXTptr context, const CallbackCtx *cb_ctx,
+                                        CallbackScratch *scratch) {
+    CPXLONG depth = 0;
+    if (CPXcallbackgetinfolong(context, CPXCALLBACKINFO_NODEDEPTH, &depth) == 0 && depth > cb_ctx->fractional_depth)
+        return 0;
 
-            int nnz = 0;
+    const int n = tsp_instance_get_num_nodes(cb_ctx->inst);
+    Arena *arena = scratch->arena;
+    const ArenaMark mark = arena_mark(arena);
 
-            for (int i = 0; i < comp_size; i++) {
-                for (int j = i + 1; j < comp_size; j++) {
+    double *x_star = arena_alloc(arena, cb_ctx->num_cols * sizeof(double));
+
+    double objval;
+    int status = CPXcallbackgetrelaxationpoint(context, x_star, 0, cb_ctx->num_cols - 1, &objval);
+    if (status) {
+        arena_rewind(arena, mark);
+        return status;
+    }
+
+    if (!scratch->min_cut) scratch->min_cut = min_cut_separator_create(n);
+    const SparseEdgeSet *edges = cb_ctx->edges;
+    const int num_cuts = edges
+                             ? min_cut_separator_run_sparse(scratch->min_cut, edges->edge_u, edges->edge_v, x_star,
+                                                            cb_ctx->num_cols, FRACTIONAL_SEC_VIOLATION,
+                                                            FRACTIONAL_SEC_MAX_CUTS)
+                             : min_cut_separator_run(scratch->min_cut, x_star, FRACTIONAL_SEC_VIOLATION,
+                                                     FRACTIONAL_SEC_MAX_CUTS);
+    if (num_cuts == 0) {
+        arena_rewind(arena, mark);
+        return 0;
+    }
+
+    int *label = edges ? arena_calloc(arena, n, sizeof(int)) : NULL;
+    int nzcnt = 0;
+    for (int c = 0; c < num_cuts; c++) {
+        int size;
+        const int *nodes = min_cut_separator_get_cut(scratch->min_cut, c, &size, NULL);
+        nzcnt += edges ? sparse_sec_columns(edges, nodes, size, label, c + 1, NULL) : size * (size - 1) / 2;
+    }
+
+    int *rmatbeg = arena_alloc(arena, num_cuts * sizeof(int));
+    double *rhs = arena_alloc(arena, num_cuts * sizeof(double));
+    char *sense = arena_alloc(arena, num_cuts * sizeof(char));
+    int *purgeable = arena_alloc(arena, num_cuts * sizeof(int));
+    int *local = arena_calloc(arena, num_cuts, sizeof(int));
+    int *ind = arena_alloc(arena, nzcnt * sizeof(int));
+    double *val = arena_alloc(arena, nzcnt * sizeof(double));
+
+    int nnz = 0;
+    for (int c = 0; c < num_cuts; c++) {
+        int size;
+        const int *nodes = min_cut_separator_get_cut(scratch->min_cut, c, &size, NULL);
+        rmatbeg[c] = nnz;
+        rhs[c] = (double) (size - 1);
+        sense[c] = 'L';
+        purgeable[c] = CPX_USECUT_FILTER;
+        if (edges) {
+            const int count = sparse_sec_columns(edges, nodes, size, label, c + 1, ind + nnz);
+            for (int i = 0; i < count; i++) val[nnz++] = 1.0;
+        } else {
+            for (int i = 0; i < size; i++) {
+                for (int j = i + 1; j < size; j++) {
                     ind[nnz] = xpos(nodes[i], nodes[j], n);
-                    val[nnz] = 1.0;
-                    nnz++;
+                    val[nnz++] = 1.0;
                 }
             }
+        }
+        sec_pool_add(cb_ctx->pool, nodes, size);
+    }
 
-            double rhs = (double) (comp_size - 1);
-            char sense = 'L';
-            int matbeg = 0;
+    status = CPXcallbackaddusercuts(context, num_cuts, nzcnt, rhs, sense, rmatbeg, ind, val, purgeable, local);
+    arena_rewind(arena, mark);
+    return status;
+}
 
-            CPXcallbackrejectcandidate(context, 1, nnz, &rhs, &sense, &matbeg, ind, val);
+static int CPXPUBLIC sec_callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, void *userhandle) {
+    CallbackCtx *cb_ctx = userhandle;
+    int n = tsp_instance_get_num_nodes(cb_ctx->inst);
 
-            tsp_free(nodes);
-            tsp_free(ind);
-            tsp_free(val);
-        }
+    CPXINT thread_id = 0;
+    CPXcallbackgetinfoint(context, CPXCALLBACKINFO_THREADID, &thread_id);
+    if (thread_id < 0 || thread_id >= cb_ctx->num_slots) {
+        if_verbose(VERBOSE_INFO, "[ERROR] SEC callback: CPLEX thread id %d has no scratch slot\n", thread_id);
+        return 1;
     }
-    connected_components_destroy(cc);
-    tsp_free(x_star);
-    return 0;
+
+    // Each slot is only touched by its own thread: lazy creation needs no lock
+    CallbackScratch *scratch = &cb_ctx->slots[thread_id];
+    if (!scratch->arena) {
+        // Sized for x_star: the first large batch of cuts adds a block that is kept from then on
+        scratch->arena = arena_create(cb_ctx->num_cols * sizeof(double) + 2 * n * sizeof(int) + 256);
+        scratch->cc = connected_components_create(n);
+    }
+
+    if (contextid == CPX_CALLBACKCONTEXT_RELAXATION) return separate_fractional_subtours(context, cb_ctx, scratch);
+    return separate_integer_subtours(context, cb_ctx, scratch);
 }
 
 int cplex_solver_install_sec_callback(CplexSolverContext *ctx, const TspInstance *inst) {
     CallbackCtx *cb = tsp_malloc(sizeof(CallbackCtx));
 
     cb->inst = inst;
+    cb->costs = tsp_instance_get_cost_matrix(inst);
+    cb->candidates = tsp_instance_get_candidate_lists(inst);
+    cb->edges = ctx->edges;
     cb->num_cols = ctx->num_cols;
+    cb->pool = &ctx->pool;
+
+    // CPLEX runs at most one callback per thread and defaults to one thread per core
+    CPXINT threads = 0;
+    CPXgetintparam(ctx->env, CPXPARAM_Threads, &threads);
+    cb->num_slots = threads > 0 ? threads : (int) get_max_threads();
+    cb->slots = tsp_calloc(cb->num_slots, sizeof(CallbackScratch));
+
+    cb->fractional_depth = ctx->fractional_depth;
+
+    CPXLONG contexts = CPX_CALLBACKCONTEXT_CANDIDATE;
+    if (ctx->fractional_depth >= 0) contexts |= CPX_CALLBACKCONTEXT_RELAXATION;
+
+    // A callback installed earlier is released once CPLEX no longer points to it
+    CallbackCtx *previous = ctx->callback_data;
     ctx->callback_data = cb;
-    return CPXcallbacksetfunc(ctx->env, ctx->lp, CPX_CALLBACKCONTEXT_CANDIDATE, lazy_sec_callback, cb);
+    const int status = CPXcallbacksetfunc(ctx->env, ctx->lp, contexts, sec_callback, cb);
+    if (previous) callback_ctx_destroy(previous);
+    return status;
 }
 
 int cplex_solver_optimize(CplexSolverContext *ctx) {
@@ -277,6 +941,11 @@ bool cplex_solver_has_solution(CplexSolverContext *ctx) {
             status == CPXMIP_TIME_LIM_FEAS || status == CPXMIP_MEM_LIM_FEAS);
 }
 
+bool cplex_solver_is_optimal(CplexSolverContext *ctx) {
+    const int status = CPXgetstat(ctx->env, ctx->lp);
+    return status == CPXMIP_OPTIMAL || status == CPXMIP_OPTIMAL_TOL;
+}
+
 int cplex_solver_extract_solution(CplexSolverContext *ctx, double *out_cost) {
     int status = CPXgetx(ctx->env, ctx->lp, ctx->x_star, 0, ctx->num_cols - 1);
     if (!status && out_cost) {
@@ -293,6 +962,174 @@ int cplex_solver_get_num_cols(const CplexSolverContext *ctx) {
     return ctx->num_cols;
 }
 
+void cplex_solver_extract_tour(const CplexSolverContext *ctx, const int n, int *tour) {
+    if (!ctx->edges) {
+        cplex_solver_reconstruct_tour(n, ctx->x_star, tour);
+        return;
+    }
+
+    // Same walk as cplex_solver_reconstruct_tour, over the (at most two) selected columns of every node
+    int *adj = tsp_malloc(2 * n * sizeof(int));
+    int *vis = tsp_calloc(n, sizeof(int));
+    for (int i = 0; i < 2 * n; i++) adj[i] = -1;
+    for (int col = 0; col < ctx->num_cols; col++) {
+        if (ctx->x_star[col] <= 0.5) continue;
+        const int u = ctx->edges->edge_u[col], v = ctx->edges->edge_v[col];
+        if (adj[2 * u + 1] == -1) adj[2 * u + (adj[2 * u] != -1)] = v;
+        if (adj[2 * v + 1] == -1) adj[2 * v + (adj[2 * v] != -1)] = u;
+    }
+
+    int current = 0, first_unvisited = 1;
+    tour[0] = 0;
+    vis[0] = 1;
+    for (int count = 1; count < n; count++) {
+        int next = -1;
+        for (int s = 0; s < 2 && next == -1; s++) {
+            if (adj[2 * current + s] != -1 && !vis[adj[2 * current + s]]) next = adj[2 * current + s];
+        }
+        // Subtour closed: naive merge with the first unvisited node
+        if (next == -1) {
+            while (vis[first_unvisited]) first_unvisited++;
+            next = first_unvisited;
+        }
+        tour[count] = next;
+        vis[next] = 1;
+        current = next;
+    }
+    tour[n] = tour[0];
+
+    tsp_free(adj);
+    tsp_free(vis);
+}
+
+/*
+ * Adds the SECs of the sets found by the separator as rows of lp and of the model of the context,
+ * where they tighten every later solve.
+ */
+static int add_pricing_cuts(CplexSolverContext *ctx, CPXLPptr lp, const MinCutSeparator *sep, const int num_cuts,
+                            int *label) {
+    // Cut ids restart at 1 every round
+    memset(label, 0, ctx->edges->num_nodes * sizeof(int));
+    int nzcnt = 0;
+    for (int c = 0; c < num_cuts; c++) {
+        int size;
+        const int *nodes = min_cut_separator_get_cut(sep, c, &size, NULL);
+        nzcnt += sparse_sec_columns(ctx->edges, nodes, size, label, c + 1, NULL);
+    }
+
+    int *rmatbeg = tsp_malloc(num_cuts * sizeof(int));
+    double *rhs = tsp_malloc(num_cuts * sizeof(double));
+    char *sense = tsp_malloc(num_cuts * sizeof(char));
+    int *ind = tsp_malloc((nzcnt > 0 ? nzcnt : 1) * sizeof(int));
+    double *val = tsp_malloc((nzcnt > 0 ? nzcnt : 1) * sizeof(double));
+    int nnz = 0;
+    for (int c = 0; c < num_cuts; c++) {
+        int size;
+        const int *nodes = min_cut_separator_get_cut(sep, c, &size, NULL);
+        rmatbeg[c] = nnz;
+        rhs[c] = (double) (size - 1);
+        sense[c] = 'L';
+        const int count = sparse_sec_columns(ctx->edges, nodes, size, label, c + 1, ind + nnz);
+        for (int i = 0; i < count; i++) val[nnz++] = 1.0;
+    }
+
+    const int first_row = CPXgetnumrows(ctx->env, ctx->lp);
+    int status = CPXaddrows(ctx->env, lp, 0, num_cuts, nzcnt, rhs, sense, rmatbeg, ind, val, NULL, NULL);
+    if (!status)
+        status = CPXaddrows(ctx->env, ctx->lp, 0, num_cuts, nzcnt, rhs, sense, rmatbeg, ind, val, NULL, NULL);
+    for (int c = 0; !status && c < num_cuts; c++) {
+        int size;
+        const int *nodes = min_cut_separator_get_cut(sep, c, &size, NULL);
+        track_sec_row(ctx, first_row + c, nodes, size);
+    }
+
+    tsp_free(rmatbeg);
+    tsp_free(rhs);
+    tsp_free(sense);
+    tsp_free(ind);
+    tsp_free(val);
+    return status;
+}
+
+int cplex_solver_price_edges(CplexSolverContext *ctx, const TspInstance *inst, const double upper_bound,
+                             double *lower_bound, int *added) {
+    if (lower_bound) *lower_bound = -DBL_MAX;
+    if (added) *added = 0;
+    if (!ctx->edges) return 0; // every edge already has its column
+
+    const int n = tsp_instance_get_num_nodes(inst);
+    int status = 0;
+    CPXLPptr lp = CPXcloneprob(ctx->env, ctx->lp, &status);
+    if (status) return status;
+    status = CPXchgprobtype(ctx->env, lp, CPXPROB_LP);
+
+    MinCutSeparator *sep = min_cut_separator_create(n);
+    double *pi = tsp_malloc(n * sizeof(double));
+    int *label = tsp_calloc(n, sizeof(int));
+    double *x = NULL;
+    double bound = -CPX_INFBOUND;
+    bool priced_out = false;
+    int total = 0;
+
+    // Column generation on the subtour LP: cut the LP point, then price the degree duals, until neither applies
+    for (int round = 0; !status && round < PRICING_MAX_ROUNDS; round++) {
+        status = CPXlpopt(ctx->env, lp);
+        if (status) break;
+        if (CPXgetstat(ctx->env, lp) != CPX_STAT_OPTIMAL) {
+            if_verbose(VERBOSE_INFO, "[ERROR] Pricing: LP status %d, the sparse bound is not proven\n",
+                       CPXgetstat(ctx->env, lp));
+            break;
+        }
+
+        const int cols = ctx->edges->num_edges;
+        x = tsp_realloc(x, cols * sizeof(double));
+        status = CPXgetx(ctx->env, lp, x, 0, cols - 1);
+        if (status) break;
+        const int num_cuts = min_cut_separator_run_sparse(sep, ctx->edges->edge_u, ctx->edges->edge_v, x, cols,
+                                                          FRACTIONAL_SEC_VIOLATION, PRICING_SEC_MAX_CUTS);
+        if (num_cuts > 0) {
+            status = add_pricing_cuts(ctx, lp, sep, num_cuts, label);
+            continue;
+        }
+
+        status = CPXgetpi(ctx->env, lp, pi, 0, n - 1);
+        if (!status) status = CPXgetobjval(ctx->env, lp, &bound);
+        if (status) break;
+
+        const int count = sparse_edge_set_price(ctx->edges, ctx->costs, pi, -PRICING_EPS, PRICING_EDGES_PER_NODE);
+        if (count == 0) {
+            priced_out = true;
+            break;
+        }
+        status = add_edge_columns(ctx, lp, cols, false);
+        if (!status) status = add_edge_columns(ctx, ctx->lp, cols, true);
+        total += count;
+    }
+
+    /*
+     * Every edge left out now has a reduced cost >= 0, so bound is valid for the complete graph, and a tour
+     * through a missing edge e costs at least bound + rc(e): only edges with rc(e) < upper_bound - bound
+     * can improve on the incumbent.
+     */
+    if (!status && priced_out && upper_bound < CPX_INFBOUND) {
+        const int cols = ctx->edges->num_edges;
+        const int count = sparse_edge_set_price(ctx->edges, ctx->costs, pi, upper_bound - bound - PRICING_EPS,
+                                                PRICING_EDGES_PER_NODE);
+        status = add_edge_columns(ctx, ctx->lp, cols, true);
+        total += count;
+    }
+
+    if (!status && priced_out && lower_bound) *lower_bound = bound;
+    if (added) *added = total;
+
+    CPXfreeprob(ctx->env, &lp);
+    min_cut_separator_destroy(sep);
+    tsp_free(pi);
+    tsp_free(label);
+    tsp_free(x);
+    return status;
+}
+
 int cplex_solver_add_sec(CplexSolverContext *ctx, const TspInstance *inst, const int *nodes, int comp_size) {
     int n = tsp_instance_get_num_nodes(inst);
     int max_edges = comp_size * (comp_size - 1) / 2;
@@ -304,7 +1141,9 @@ int cplex_solver_add_sec(CplexSolverContext *ctx, const TspInstance *inst, const
 
     for (int i = 0; i < comp_size; i++) {
         for (int j = i + 1; j < comp_size; j++) {
-            ind[nnz] = xpos(nodes[i], nodes[j], n);
+            const int col = column_of(ctx->edges, nodes[i], nodes[j], n);
+            if (col < 0) continue; // edge without a column in the sparse model
+            ind[nnz] = col;
             val[nnz] = 1.0;
             nnz++;
         }
@@ -314,6 +1153,7 @@ int cplex_solver_add_sec(CplexSolverContext *ctx, const TspInstance *inst, const
     int matbeg = 0;
     char *name = "SEC";
     int status = CPXaddrows(ctx->env, ctx->lp, 0, 1, nnz, &rhs, &sense, &matbeg, ind, val, NULL, &name);
+    if (!status) track_sec_row(ctx, CPXgetnumrows(ctx->env, ctx->lp) - 1, nodes, comp_size);
     tsp_free(ind);
     tsp_free(val);
     return status;
@@ -322,6 +1162,14 @@ int cplex_solver_add_sec(CplexSolverContext *ctx, const TspInstance *inst, const
 int cplex_solver_add_mip_start(CplexSolverContext *ctx, int num_nodes, const int *tour) {
     int nzcnt = num_nodes;
 
+    // The sparse model gets the columns the start needs
+    if (ctx->edges) {
+        const int first = ctx->edges->num_edges;
+        for (int i = 0; i < num_nodes; i++) sparse_edge_set_add(ctx->edges, tour[i], tour[i + 1]);
+        const int status = add_edge_columns(ctx, ctx->lp, first, true);
+        if (status) return status;
+    }
+
     int *indices = tsp_malloc(nzcnt * sizeof(int));
     double *values = tsp_malloc(nzcnt * sizeof(double));
 
@@ -330,7 +1178,7 @@ int cplex_solver_add_mip_start(CplexSolverContext *ctx, int num_nodes, const int
         int u = tour[i];
         int v = tour[i + 1];
 
-        int idx = xpos(u, v, num_nodes);
+        int idx = column_of(ctx->edges, u, v, num_nodes);
 
         indices[i] = idx;
         values[i] = 1.0;
@@ -355,24 +1203,81 @@ int cplex_solver_add_mip_start(CplexSolverContext *ctx, int num_nodes, const int
 void *cplex_solver_get_env(const CplexSolverContext *ctx) { return ctx->env; }
 void *cplex_solver_get_lp(const CplexSolverContext *ctx) { return ctx->lp; }
 
-#else
 
-struct CplexSolverContext {
-    int dummy;
-};
-CplexSolverContext *cplex_solver_create(const TspInstance *inst) { return NULL; }
-void cplex_solver_destroy(CplexSolverContext *ctx) {
+/*
+ * CPLEX behind the MipBackend table: the operations take the model as void *, so each one forwards to the
+ * cplex_solver_* function of the same name.
+ */
+static void *cplex_create(const TspInstance *inst) { return cplex_solver_create(inst); }
+static void cplex_destroy(void *m) { cplex_solver_destroy(m); }
+static int cplex_build_model(void *m, const TspInstance *inst) { return cplex_solver_build_base_model(m, inst); }
+static int cplex_build_sparse_model(void *m, const TspInstance *inst, const int k, const int *tour) {
+    return cplex_solver_build_sparse_model(m, inst, k, tour);
+}
+static int cplex_price_edges(void *m, const TspInstance *inst, const double upper_bound, double *lower_bound,
+                             int *added) {
+    return cplex_solver_price_edges(m, inst, upper_bound, lower_bound, added);
+}
+static int cplex_get_col(const void *m, const int u, const int v, const int n) {
+    return cplex_solver_get_col(m, u, v, n);
 }
-int cplex_solver_build_base_model(CplexSolverContext *ctx, const TspInstance *inst) { return -1; }
-int cplex_solver_fix_edge(CplexSolverContext *ctx, int u, int v, double val, int n) { return 0; }
-int cplex_solver_install_sec_callback(CplexSolverContext *ctx, const TspInstance *i) { return 0; }
-void cplex_solver_set_time_limit(CplexSolverContext *ctx, double s) {
-}
-int cplex_solver_optimize(CplexSolverContext *ctx) { return -1; }
-bool cplex_solver_has_solution(CplexSolverContext *ctx) { return false; }
-int cplex_solver_extract_solution(CplexSolverContext *ctx, double *out_cost) { return -1; }
-const double *cplex_solver_get_x(const CplexSolverContext *ctx) { return NULL; }
-int cplex_solver_get_num_cols(const CplexSolverContext *ctx) { return 0; }
-int cplex_solver_add_sec(CplexSolverContext *ctx, const TspInstance *inst, const int *c, int s) { return -1; }
-int cplex_solver_add_mip_start(CplexSolverContext *c, int n, const int *t) { return 0; }
+static int cplex_fix_edges(void *m, const int *cols, const int count, const double value) {
+    return cplex_solver_fix_edges(m, cols, count, value);
+}
+static int cplex_reset_bounds(void *m) { return cplex_solver_reset_bounds(m); }
+static int cplex_add_sec(void *m, const TspInstance *inst, const int *nodes, const int size) {
+    return cplex_solver_add_sec(m, inst, nodes, size);
+}
+static int cplex_set_local_branching(void *m, const int n, const int *tour, const int k) {
+    return cplex_solver_set_local_branching(m, n, tour, k);
+}
+static int cplex_add_reverse_branching(void *m, const int n, const int *tour, const int k) {
+    return cplex_solver_add_reverse_branching(m, n, tour, k);
+}
+static int cplex_add_mip_start(void *m, const int n, const int *tour) { return cplex_solver_add_mip_start(m, n, tour); }
+static int cplex_clear_mip_starts(void *m) { return cplex_solver_clear_mip_starts(m); }
+static int cplex_install_sec_callback(void *m, const TspInstance *inst) {
+    return cplex_solver_install_sec_callback(m, inst);
+}
+static void cplex_set_fractional_sec_depth(void *m, const int depth) { cplex_solver_set_fractional_sec_depth(m, depth); }
+static void cplex_keep_sec_cuts(void *m, const bool keep) { cplex_solver_keep_sec_cuts(m, keep); }
+static int cplex_flush_sec_pool(void *m, int *added) { return cplex_solver_flush_sec_pool(m, added); }
+static void cplex_set_time_limit(void *m, const double seconds) { cplex_solver_set_time_limit(m, seconds); }
+static void cplex_set_threads(void *m, const int num_threads) { cplex_solver_set_threads(m, num_threads); }
+static int cplex_optimize(void *m) { return cplex_solver_optimize(m); }
+static bool cplex_has_solution(void *m) { return cplex_solver_has_solution(m); }
+static bool cplex_is_optimal(void *m) { return cplex_solver_is_optimal(m); }
+static int cplex_extract_solution(void *m, double *out_cost) { return cplex_solver_extract_solution(m, out_cost); }
+static void cplex_extract_tour(const void *m, const int n, int *tour) { cplex_solver_extract_tour(m, n, tour); }
+static const double *cplex_get_x(const void *m) { return cplex_solver_get_x(m); }
+
+const MipBackend CPLEX_MIP_BACKEND = {
+    .name = "CPLEX",
+    .create = cplex_create,
+    .destroy = cplex_destroy,
+    .build_model = cplex_build_model,
+    .build_sparse_model = cplex_build_sparse_model,
+    .price_edges = cplex_price_edges,
+    .get_col = cplex_get_col,
+    .fix_edges = cplex_fix_edges,
+    .reset_bounds = cplex_reset_bounds,
+    .add_sec = cplex_add_sec,
+    .set_local_branching = cplex_set_local_branching,
+    .add_reverse_branching = cplex_add_reverse_branching,
+    .add_mip_start = cplex_add_mip_start,
+    .clear_mip_starts = cplex_clear_mip_starts,
+    .install_sec_callback = cplex_install_sec_callback,
+    .set_fractional_sec_depth = cplex_set_fractional_sec_depth,
+    .keep_sec_cuts = cplex_keep_sec_cuts,
+    .flush_sec_pool = cplex_flush_sec_pool,
+    .set_time_limit = cplex_set_time_limit,
+    .set_threads = cplex_set_threads,
+    .optimize = cplex_optimize,
+    .has_solution = cplex_has_solution,
+    .is_optimal = cplex_is_optimal,
+    .extract_solution = cplex_extract_solution,
+    .extract_tour = cplex_extract_tour,
+    .get_x = cplex_get_x
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,417 @@
+#include "mip_backend.h"
+
+#ifdef ENABLE_GLPK
+#include "cplex_solver_wrapper.h" // xpos, cplex_solver_reconstruct_tour
+#include "subtour_separator.h"
+#include "tsp_model_csr.h"
+#include "time_limiter.h"
+#include "logger.h"
+#include "c_util.h"
+#include <glpk.h>
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+// The lazy SEC callback only looks for subtours on LP points this close to integral
+#define GLPK_INTEGRALITY_TOL 1e-6
+
+/*
+ * The TSP model on GLPK. GLPK is single-threaded and numbers rows and columns from 1: column xpos(i, j) + 1
+ * is edge {i, j}, and every index/value array handed to it leaves entry 0 unused.
+ *
+ * Lazy SECs are rows added from the callback on integer LP points (GLP_IROWGEN); they are removed once the
+ * solve ends, as CPLEX forgets its lazy cuts, and survive only through the SEC pool. The MIP start is offered
+ * as a heuristic solution at the first chance (GLP_IHEUR). The MIP needs an optimal LP basis to start from
+ * (its presolver would hide the columns from the callback), so every solve runs the simplex first.
+ */
+typedef struct {
+    glp_prob *lp;
+    const TspInstance *inst;
+    int num_nodes;
+    int num_cols;
+    double time_limit; // seconds, 0 for none
+    double *x_star; // solution of the last solve
+    double *point; // scratch: LP point read by the callback
+    double obj_val;
+    bool has_solution;
+    bool optimal;
+    int *row_ind; // num_cols + 1 scratch for one row
+    double *row_val;
+    int *start_tour; // MIP start, closed tour
+    bool has_start;
+    bool start_posted;
+    bool lazy_secs;
+    ConnectedComponents *cc;
+    bool keep_cuts;
+    int pool_rows; // pooled SEC r holds pool_nodes[pool_start[r] .. pool_start[r + 1])
+    int pool_row_capacity;
+    int *pool_start;
+    int pool_nnz;
+    int pool_nnz_capacity;
+    int *pool_nodes;
+    int *fixed_cols; // columns fixed since the last reset
+    int num_fixed;
+    int lb_row; // local branching row, 0 until set_local_branching adds it
+} GlpkModel;
+
+static int to_glpk_ms(const double seconds) {
+    if (seconds <= 0.0 || seconds * 1000.0 >= (double) INT_MAX) return INT_MAX;
+    const int ms = (int) (seconds * 1000.0);
+    return ms > 0 ? ms : 1;
+}
+
+static void *glpk_create(const TspInstance *inst) {
+    GlpkModel *m = tsp_calloc(1, sizeof(GlpkModel));
+    m->inst = inst;
+    m->num_nodes = tsp_instance_get_num_nodes(inst);
+    m->lp = glp_create_prob();
+    glp_set_obj_dir(m->lp, GLP_MIN);
+    glp_term_out(GLP_OFF);
+    return m;
+}
+
+static void glpk_destroy(void *model) {
+    GlpkModel *m = model;
+    if (!m) return;
+    glp_delete_prob(m->lp);
+    tsp_free(m->x_star);
+    tsp_free(m->point);
+    tsp_free(m->row_ind);
+    tsp_free(m->row_val);
+    tsp_free(m->start_tour);
+    connected_components_destroy(m->cc);
+    tsp_free(m->pool_start);
+    tsp_free(m->pool_nodes);
+    tsp_free(m->fixed_cols);
+    tsp_free(m);
+}
+
+static int glpk_build_model(void *model, const TspInstance *inst) {
+    GlpkModel *m = model;
+    TspModelCsr *csr = tsp_model_csr_build(inst, false, 0);
+
+    m->num_cols = csr->num_cols;
+    const int first_col = glp_add_cols(m->lp, csr->num_cols);
+    for (int j = 0; j < csr->num_cols; j++) {
+        glp_set_col_kind(m->lp, first_col + j, GLP_BV);
+        glp_set_obj_coef(m->lp, first_col + j, csr->obj[j]);
+    }
+
+    // The degree rows in a single matrix load, as (row, column, value) triplets
+    const int first_row = glp_add_rows(m->lp, csr->num_rows);
+    int *ia = tsp_malloc((csr->nnz + 1) * sizeof(int));
+    int *ja = tsp_malloc((csr->nnz + 1) * sizeof(int));
+    double *ar = tsp_malloc((csr->nnz + 1) * sizeof(double));
+    for (int h = 0; h < csr->num_rows; h++) {
+        glp_set_row_bnds(m->lp, first_row + h, GLP_FX, csr->rhs[h], csr->rhs[h]);
+        const int end = h + 1 < csr->num_rows ? csr->rmatbeg[h + 1] : csr->nnz;
+        for (int k = csr->rmatbeg[h]; k < end; k++) {
+            ia[k + 1] = first_row + h;
+            ja[k + 1] = first_col + csr->rmatind[k];
+            ar[k + 1] = csr->rmatval[k];
+        }
+    }
+    glp_load_matrix(m->lp, csr->nnz, ia, ja, ar);
+
+    m->x_star = tsp_calloc(m->num_cols, sizeof(double));
+    m->point = tsp_malloc(m->num_cols * sizeof(double));
+    m->row_ind = tsp_malloc((m->num_cols + 1) * sizeof(int));
+    m->row_val = tsp_malloc((m->num_cols + 1) * sizeof(double));
+    m->fixed_cols = tsp_malloc(m->num_cols * sizeof(int));
+
+    tsp_free(ia);
+    tsp_free(ja);
+    tsp_free(ar);
+    tsp_model_csr_destroy(csr);
+    return 0;
+}
+
+static int glpk_get_col(const void *model, const int u, const int v, const int num_nodes) {
+    (void) model;
+    return xpos(u, v, num_nodes);
+}
+
+static int glpk_fix_edges(void *model, const int *cols, const int count, const double value) {
+    GlpkModel *m = model;
+    for (int k = 0; k < count; k++) {
+        glp_set_col_bnds(m->lp, cols[k] + 1, GLP_FX, value, value);
+        // A column fixed twice is only reset once more: harmless
+        if (m->num_fixed < m->num_cols) m->fixed_cols[m->num_fixed++] = cols[k];
+    }
+    return 0;
+}
+
+static int glpk_reset_bounds(void *model) {
+    GlpkModel *m = model;
+    for (int k = 0; k < m->num_fixed; k++) glp_set_col_bnds(m->lp, m->fixed_cols[k] + 1, GLP_DB, 0.0, 1.0);
+    m->num_fixed = 0;
+    return 0;
+}
+
+// x(E(S)) <= |S| - 1 as a new row
+static void add_sec_row(GlpkModel *m, const int *nodes, const int comp_size) {
+    int nnz = 0;
+    for (int i = 0; i < comp_size; i++) {
+        for (int j = i + 1; j < comp_size; j++) {
+            m->row_ind[++nnz] = xpos(nodes[i], nodes[j], m->num_nodes) + 1;
+            m->row_val[nnz] = 1.0;
+        }
+    }
+    const int row = glp_add_rows(m->lp, 1);
+    glp_set_row_bnds(m->lp, row, GLP_UP, 0.0, comp_size - 1);
+    glp_set_mat_row(m->lp, row, nnz, m->row_ind, m->row_val);
+}
+
+static int glpk_add_sec(void *model, const TspInstance *inst, const int *component_nodes, const int comp_size) {
+    (void) inst;
+    add_sec_row(model, component_nodes, comp_size);
+    return 0;
+}
+
+// Row over the edges of tour, with the given bounds
+static int add_tour_row(GlpkModel *m, int row, const int *tour, const int type, const double bound) {
+    const int n = m->num_nodes;
+    for (int i = 0; i < n; i++) {
+        m->row_ind[i + 1] = xpos(tour[i], tour[i + 1], n) + 1;
+        m->row_val[i + 1] = 1.0;
+    }
+    if (row == 0) row = glp_add_rows(m->lp, 1);
+    glp_set_row_bnds(m->lp, row, type, bound, bound);
+    glp_set_mat_row(m->lp, row, n, m->row_ind, m->row_val);
+    return row;
+}
+
+static int glpk_set_local_branching(void *model, const int num_nodes, const int *tour, const int k) {
+    GlpkModel *m = model;
+    // GLPK replaces the whole row: the edges that left the center drop out with it
+    m->lb_row = add_tour_row(m, m->lb_row, tour, GLP_LO, num_nodes - k);
+    return 0;
+}
+
+static int glpk_add_reverse_branching(void *model, const int num_nodes, const int *tour, const int k) {
+    add_tour_row(model, 0, tour, GLP_UP, num_nodes - k - 1);
+    return 0;
+}
+
+static int glpk_add_mip_start(void *model, const int num_nodes, const int *tour) {
+    GlpkModel *m = model;
+    if (!m->start_tour) m->start_tour = tsp_malloc((num_nodes + 1) * sizeof(int));
+    memcpy(m->start_tour, tour, (num_nodes + 1) * sizeof(int));
+    m->has_start = true;
+    return 0;
+}
+
+static int glpk_clear_mip_starts(void *model) {
+    ((GlpkModel *) model)->has_start = false;
+    return 0;
+}
+
+static int glpk_install_sec_callback(void *model, const TspInstance *inst) {
+    GlpkModel *m = model;
+    (void) inst;
+    if (!m->cc) m->cc = connected_components_create(m->num_nodes);
+    m->lazy_secs = true;
+    return 0;
+}
+
+static void pool_add(GlpkModel *m, const int *nodes, const int comp_size) {
+    if (m->pool_rows + 1 >= m->pool_row_capacity) {
+        m->pool_row_capacity = m->pool_row_capacity ? 2 * m->pool_row_capacity : 64;
+        m->pool_start = tsp_realloc(m->pool_start, m->pool_row_capacity * sizeof(int));
+    }
+    if (m->pool_nnz + comp_size > m->pool_nnz_capacity) {
+        while (m->pool_nnz + comp_size > m->pool_nnz_capacity)
+            m->pool_nnz_capacity = m->pool_nnz_capacity ? 2 * m->pool_nnz_capacity : 1024;
+        m->pool_nodes = tsp_realloc(m->pool_nodes, m->pool_nnz_capacity * sizeof(int));
+    }
+    m->pool_start[m->pool_rows] = m->pool_nnz;
+    memcpy(m->pool_nodes + m->pool_nnz, nodes, comp_size * sizeof(int));
+    m->pool_nnz += comp_size;
+    m->pool_start[++m->pool_rows] = m->pool_nnz;
+}
+
+static void glpk_keep_sec_cuts(void *model, const bool keep) {
+    GlpkModel *m = model;
+    m->keep_cuts = keep;
+    if (!keep) m->pool_rows = m->pool_nnz = 0;
+}
+
+static int glpk_flush_sec_pool(void *model, int *added) {
+    GlpkModel *m = model;
+    for (int r = 0; r < m->pool_rows; r++)
+        add_sec_row(m, m->pool_nodes + m->pool_start[r], m->pool_start[r + 1] - m->pool_start[r]);
+    if (added) *added = m->pool_rows;
+    m->pool_rows = m->pool_nnz = 0;
+    return 0;
+}
+
+static void glpk_set_time_limit(void *model, const double seconds) {
+    ((GlpkModel *) model)->time_limit = seconds;
+}
+
+// GLPK solves on the calling thread only
+static void glpk_set_threads(void *model, const int num_threads) {
+    (void) model;
+    (void) num_threads;
+}
+
+// Lazy SECs: one row per connected component of an integer LP point
+static void separate_integer_subtours(GlpkModel *m) {
+    for (int j = 0; j < m->num_cols; j++) {
+        const double v = glp_get_col_prim(m->lp, j + 1);
+        if (fabs(v - round(v)) > GLPK_INTEGRALITY_TOL) return;
+        m->point[j] = v;
+    }
+
+    ConnectedComponents *cc = m->cc;
+    find_connected_components(cc, m->num_nodes, m->point);
+    if (cc->num_components <= 1) return;
+
+    for (int c = 0; c < cc->num_components; c++) {
+        const int *nodes = cc->component_nodes + cc->component_start[c];
+        add_sec_row(m, nodes, cc->nodes_in_component[c]);
+        if (m->keep_cuts) pool_add(m, nodes, cc->nodes_in_component[c]);
+    }
+}
+
+static void post_mip_start(GlpkModel *m, glp_tree *tree) {
+    if (!m->has_start || m->start_posted) return;
+    m->start_posted = true;
+
+    // 1-based values of every column: the start is a tour, so it needs no SEC
+    double *x = m->row_val;
+    for (int j = 1; j <= m->num_cols; j++) x[j] = 0.0;
+    for (int i = 0; i < m->num_nodes; i++) x[xpos(m->start_tour[i], m->start_tour[i + 1], m->num_nodes) + 1] = 1.0;
+    if (glp_ios_heur_sol(tree, x))
+        if_verbose(VERBOSE_DEBUG, "[GLPK Warn] MIP start rejected\n");
+}
+
+static void glpk_callback(glp_tree *tree, void *info) {
+    GlpkModel *m = info;
+    switch (glp_ios_reason(tree)) {
+        case GLP_IROWGEN:
+            if (m->lazy_secs) separate_integer_subtours(m);
+            break;
+        case GLP_IHEUR:
+            post_mip_start(m, tree);
+            break;
+        default:
+            break;
+    }
+}
+
+// Removes the rows added by the callback (from first_row on)
+static void drop_rows_from(GlpkModel *m, const int first_row) {
+    const int count = glp_get_num_rows(m->lp) - first_row + 1;
+    if (count <= 0) return;
+    int *num = tsp_malloc((count + 1) * sizeof(int));
+    for (int k = 1; k <= count; k++) num[k] = first_row + k - 1;
+    glp_del_rows(m->lp, count, num);
+    tsp_free(num);
+}
+
+/*
+ * Returns 0 once GLPK has run, also when it stopped at the time limit or proved the model infeasible:
+ * has_solution and is_optimal tell the outcome, as for CPLEX.
+ */
+static int glpk_optimize(void *model) {
+    GlpkModel *m = model;
+    m->has_solution = m->optimal = false;
+    m->start_posted = false;
+
+    TimeLimiter timer = time_limiter_create(m->time_limit > 0.0 ? m->time_limit : (double) INT_MAX / 1000.0);
+    time_limiter_start(&timer);
+
+    glp_smcp smcp;
+    glp_init_smcp(&smcp);
+    smcp.msg_lev = GLP_MSG_OFF;
+    smcp.tm_lim = to_glpk_ms(time_limiter_get_remaining(&timer));
+    int status = glp_simplex(m->lp, &smcp);
+    // Rows removed since the last solve may leave a basis of the wrong size
+    if (status == GLP_EBADB || status == GLP_ESING) {
+        glp_adv_basis(m->lp, 0);
+        status = glp_simplex(m->lp, &smcp);
+    }
+    if (status == GLP_ETMLIM) return 0;
+    if (status) {
+        if_verbose(VERBOSE_DEBUG, "[GLPK Error] LP relaxation failed, status: %d\n", status);
+        return status;
+    }
+    if (glp_get_status(m->lp) != GLP_OPT) return 0; // infeasible relaxation
+
+    glp_iocp iocp;
+    glp_init_iocp(&iocp);
+    iocp.msg_lev = GLP_MSG_OFF;
+    iocp.presolve = GLP_OFF;
+    iocp.tm_lim = to_glpk_ms(time_limiter_get_remaining(&timer));
+    iocp.cb_func = glpk_callback;
+    iocp.cb_info = m;
+
+    const int first_lazy_row = glp_get_num_rows(m->lp) + 1;
+    status = glp_intopt(m->lp, &iocp);
+
+    const int mip_status = glp_mip_status(m->lp);
+    if (mip_status == GLP_OPT || mip_status == GLP_FEAS) {
+        for (int j = 0; j < m->num_cols; j++) m->x_star[j] = glp_mip_col_val(m->lp, j + 1);
+        m->obj_val = glp_mip_obj_val(m->lp);
+        m->has_solution = true;
+        m->optimal = status == 0 && mip_status == GLP_OPT;
+    }
+    drop_rows_from(m, first_lazy_row);
+
+    if (status == GLP_ETMLIM || status == GLP_ESTOP) return 0;
+    if (status) if_verbose(VERBOSE_DEBUG, "[GLPK Error] MIP solve failed, status: %d\n", status);
+    return status;
+}
+
+static bool glpk_has_solution(void *model) { return ((GlpkModel *) model)->has_solution; }
+
+static bool glpk_is_optimal(void *model) { return ((GlpkModel *) model)->optimal; }
+
+static int glpk_extract_solution(void *model, double *out_cost) {
+    const GlpkModel *m = model;
+    if (!m->has_solution) return -1;
+    if (out_cost) *out_cost = m->obj_val;
+    return 0;
+}
+
+static void glpk_extract_tour(const void *model, const int num_nodes, int *tour) {
+    cplex_solver_reconstruct_tour(num_nodes, ((const GlpkModel *) model)->x_star, tour);
+}
+
+static const double *glpk_get_x(const void *model) { return ((const GlpkModel *) model)->x_star; }
+
+/*
+ * No sparse model or pricing, and no cuts on fractional points: B&C runs on the complete model with lazy
+ * SECs only.
+ */
+const MipBackend GLPK_MIP_BACKEND = {
+    .name = "GLPK",
+    .create = glpk_create,
+    .destroy = glpk_destroy,
+    .build_model = glpk_build_model,
+    .build_sparse_model = NULL,
+    .price_edges = NULL,
+    .get_col = glpk_get_col,
+    .fix_edges = glpk_fix_edges,
+    .reset_bounds = glpk_reset_bounds,
+    .add_sec = glpk_add_sec,
+    .set_local_branching = glpk_set_local_branching,
+    .add_reverse_branching = glpk_add_reverse_branching,
+    .add_mip_start = glpk_add_mip_start,
+    .clear_mip_starts = glpk_clear_mip_starts,
+    .install_sec_callback = glpk_install_sec_callback,
+    .set_fractional_sec_depth = NULL,
+    .keep_sec_cuts = glpk_keep_sec_cuts,
+    .flush_sec_pool = glpk_flush_sec_pool,
+    .set_time_limit = glpk_set_time_limit,
+    .set_threads = glpk_set_threads,
+    .optimize = glpk_optimize,
+    .has_solution = glpk_has_solution,
+    .is_optimal = glpk_is_optimal,
+    .extract_solution = glpk_extract_solution,
+    .extract_tour = glpk_extract_tour,
+    .get_x = glpk_get_x
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "grasp.h"
 #include "genetic.h"
 #include <stdlib.h>
+#include <string.h>
 
 #include "c_util.h"
 
@@ -13,6 +14,36 @@ void matheuristic_free_args(void *heuristic_args) {
     tsp_free(heuristic_args);
 }
 
+static size_t heuristic_args_size(const HeuristicType heuristic_type) {
+    switch (heuristic_type) {
+        case NN: return sizeof(NNConfig);
+        case EM: return sizeof(EMConfig);
+        case TABU: return sizeof(TabuConfig);
+        case GRASP: return sizeof(GraspConfig);
+        case GENETIC: return sizeof(GeneticConfig);
+        case VNS:
+        default: return sizeof(VNSConfig);
+    }
+}
+
+void *matheuristic_clone_args(const HeuristicType heuristic_type, const void *heuristic_args,
+                              const uint64_t seed_offset) {
+    if (!heuristic_args) return NULL;
+    const size_t size = heuristic_args_size(heuristic_type);
+    void *copy = tsp_malloc(size);
+    memcpy(copy, heuristic_args, size);
+    switch (heuristic_type) {
+        case NN: ((NNConfig *) copy)->seed += seed_offset; break;
+        case EM: ((EMConfig *) copy)->seed += seed_offset; break;
+        case TABU: ((TabuConfig *) copy)->seed += seed_offset; break;
+        case GRASP: ((GraspConfig *) copy)->seed += seed_offset; break;
+        case GENETIC: ((GeneticConfig *) copy)->seed += seed_offset; break;
+        case VNS:
+        default: ((VNSConfig *) copy)->seed += seed_offset; break;
+    }
+    return copy;
+}
+
 void matheuristic_run_warm_start(const WarmStartParams *params,
                                  const TspInstance *inst,
                                  TspSolution *sol,
@@ -0,0 +1,389 @@
+#include "min_cut_separator.h"
+#include "c_util.h"
+#include <stdbool.h>
+#include <string.h>
+
+// Edges below this value are not part of the support graph
+#define SUPPORT_EPS 1e-6
+// Edges above 1 - SHRINK_EPS are shrunk
+#define SHRINK_EPS 1e-6
+
+/*
+ * Point to separate: either dense in xpos order (edge_u == NULL) or one value per listed edge.
+ */
+typedef struct {
+    const double *x;
+    const int *edge_u;
+    const int *edge_v;
+    int num_edges;
+} SupportGraph;
+
+struct MinCutSeparator {
+    int n;
+    int *parent; // union-find over the nodes, for components and shrinking
+    int *super_of; // supernode of every node
+    int *member_start; // CSR offsets of the nodes of every supernode
+    int *members;
+    int *adj_head; // adjacency list of every supernode, followed by the lists of the groups merged into it
+    int *adj_tail;
+    int *owner; // group of every supernode
+    int num_adj;
+    int adj_capacity;
+    int *adj_next;
+    int *adj_to;
+    double *adj_weight;
+    int heap_size; // lazy max-heap on key: stale entries are skipped when popped
+    int heap_capacity;
+    int *heap_node;
+    double *heap_key;
+    double *key; // Stoer-Wagner attachment of every supernode to the growing set
+    int *active; // supernodes still standing for a group
+    unsigned char *added;
+    int *group_next; // supernodes merged into a group, as a linked list
+    int *group_tail;
+    unsigned char *in_cut;
+    int num_cuts;
+    int cut_capacity;
+    int *cut_beg; // CSR offsets into cut_nodes
+    double *cut_value;
+    int node_capacity;
+    int *cut_nodes;
+};
+
+MinCutSeparator *min_cut_separator_create(const int num_nodes) {
+    MinCutSeparator *sep = tsp_calloc(1, sizeof(MinCutSeparator));
+    const int size = num_nodes > 0 ? num_nodes : 1;
+    sep->n = num_nodes;
+    sep->parent = tsp_malloc(size * sizeof(int));
+    sep->super_of = tsp_malloc(size * sizeof(int));
+    sep->member_start = tsp_malloc((size + 1) * sizeof(int));
+    sep->members = tsp_malloc(size * sizeof(int));
+    sep->adj_head = tsp_malloc(size * sizeof(int));
+    sep->adj_tail = tsp_malloc(size * sizeof(int));
+    sep->owner = tsp_malloc(size * sizeof(int));
+    sep->key = tsp_malloc(size * sizeof(double));
+    sep->active = tsp_malloc(size * sizeof(int));
+    sep->added = tsp_malloc(size * sizeof(unsigned char));
+    sep->group_next = tsp_malloc(size * sizeof(int));
+    sep->group_tail = tsp_malloc(size * sizeof(int));
+    sep->in_cut = tsp_calloc(size, sizeof(unsigned char));
+    sep->cut_beg = tsp_malloc(sizeof(int));
+    sep->cut_beg[0] = 0;
+    return sep;
+}
+
+void min_cut_separator_destroy(MinCutSeparator *sep) {
+    if (!sep) return;
+    tsp_free(sep->parent);
+    tsp_free(sep->super_of);
+    tsp_free(sep->member_start);
+    tsp_free(sep->members);
+    tsp_free(sep->adj_head);
+    tsp_free(sep->adj_tail);
+    tsp_free(sep->owner);
+    tsp_free(sep->adj_next);
+    tsp_free(sep->adj_to);
+    tsp_free(sep->adj_weight);
+    tsp_free(sep->heap_node);
+    tsp_free(sep->heap_key);
+    tsp_free(sep->key);
+    tsp_free(sep->active);
+    tsp_free(sep->added);
+    tsp_free(sep->group_next);
+    tsp_free(sep->group_tail);
+    tsp_free(sep->in_cut);
+    tsp_free(sep->cut_beg);
+    tsp_free(sep->cut_value);
+    tsp_free(sep->cut_nodes);
+    tsp_free(sep);
+}
+
+// xpos(i, j, n) == row_base(i, n) + j for every j > i
+static int row_base(const int i, const int n) {
+    return i * n - (i + 1) * (i + 2) / 2;
+}
+
+static int uf_find(int *parent, int v) {
+    while (parent[v] != v) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+static void join(int *parent, const int i, const int j) {
+    const int a = uf_find(parent, i), b = uf_find(parent, j);
+    if (a != b) parent[a > b ? a : b] = a < b ? a : b;
+}
+
+/*
+ * Joins the sets of every edge whose value is above `threshold` and numbers the resulting sets
+ * in super_of (by smallest node). Returns the number of sets.
+ */
+static int union_edges(MinCutSeparator *sep, const SupportGraph *g, const double threshold) {
+    const int n = sep->n;
+    for (int i = 0; i < n; i++) sep->parent[i] = i;
+
+    if (g->edge_u) {
+        for (int e = 0; e < g->num_edges; e++) {
+            if (g->x[e] > threshold) join(sep->parent, g->edge_u[e], g->edge_v[e]);
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            const int base = row_base(i, n);
+            for (int j = i + 1; j < n; j++) {
+                if (g->x[base + j] > threshold) join(sep->parent, i, j);
+            }
+        }
+    }
+
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        const int root = uf_find(sep->parent, i);
+        sep->super_of[i] = root == i ? count++ : sep->super_of[root];
+    }
+    return count;
+}
+
+// Groups the nodes by set (counting sort on super_of)
+static void bucket_members(MinCutSeparator *sep, const int count) {
+    const int n = sep->n;
+    memset(sep->member_start, 0, (count + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) sep->member_start[sep->super_of[i] + 1]++;
+    for (int s = 0; s < count; s++) sep->member_start[s + 1] += sep->member_start[s];
+    int *cursor = sep->active;
+    memcpy(cursor, sep->member_start, count * sizeof(int));
+    for (int i = 0; i < n; i++) sep->members[cursor[sep->super_of[i]]++] = i;
+}
+
+/*
+ * Stores the marked nodes (in_cut) as a new set, or their complement when they are more than n/2,
+ * and clears the marks. Sets of fewer than two nodes have a trivial SEC and are dropped.
+ */
+static void emit_marked(MinCutSeparator *sep, const int marked, const double value) {
+    const int n = sep->n;
+    const bool complement = marked > n / 2;
+    const int size = complement ? n - marked : marked;
+
+    if (size >= 2) {
+        if (sep->num_cuts == sep->cut_capacity) {
+            sep->cut_capacity = sep->cut_capacity ? 2 * sep->cut_capacity : 16;
+            sep->cut_beg = tsp_realloc(sep->cut_beg, (sep->cut_capacity + 1) * sizeof(int));
+            sep->cut_value = tsp_realloc(sep->cut_value, sep->cut_capacity * sizeof(double));
+        }
+        const int start = sep->cut_beg[sep->num_cuts];
+        if (start + size > sep->node_capacity) {
+            while (start + size > sep->node_capacity)
+                sep->node_capacity = sep->node_capacity ? 2 * sep->node_capacity : 4 * n;
+            sep->cut_nodes = tsp_realloc(sep->cut_nodes, sep->node_capacity * sizeof(int));
+        }
+        int k = start;
+        for (int i = 0; i < n; i++) {
+            if ((sep->in_cut[i] != 0) != complement) sep->cut_nodes[k++] = i;
+        }
+        sep->cut_value[sep->num_cuts] = value;
+        sep->cut_beg[++sep->num_cuts] = k;
+    }
+    memset(sep->in_cut, 0, n * sizeof(unsigned char));
+}
+
+static int separate_components(MinCutSeparator *sep, const int count, const int max_cuts) {
+    bucket_members(sep, count);
+    // With two components the second set is the complement of the first: same SEC
+    const int limit = count == 2 ? 1 : count;
+    int smallest = 0;
+    if (count == 2 && sep->member_start[2] - sep->member_start[1] < sep->member_start[1]) smallest = 1;
+
+    for (int c = 0; c < limit && sep->num_cuts < max_cuts; c++) {
+        const int comp = count == 2 ? smallest : c;
+        for (int k = sep->member_start[comp]; k < sep->member_start[comp + 1]; k++)
+            sep->in_cut[sep->members[k]] = 1;
+        emit_marked(sep, sep->member_start[comp + 1] - sep->member_start[comp], 0.0);
+    }
+    return sep->num_cuts;
+}
+
+static void emit_group(MinCutSeparator *sep, const int group, const double value) {
+    int marked = 0;
+    for (int s = group; s != -1; s = sep->group_next[s]) {
+        for (int k = sep->member_start[s]; k < sep->member_start[s + 1]; k++) {
+            sep->in_cut[sep->members[k]] = 1;
+            marked++;
+        }
+    }
+    emit_marked(sep, marked, value);
+}
+
+static void heap_push(MinCutSeparator *sep, const int v, const double key) {
+    int i = sep->heap_size++;
+    while (i > 0 && sep->heap_key[(i - 1) / 2] < key) {
+        sep->heap_node[i] = sep->heap_node[(i - 1) / 2];
+        sep->heap_key[i] = sep->heap_key[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    sep->heap_node[i] = v;
+    sep->heap_key[i] = key;
+}
+
+// Pops the supernode of largest key not added yet, -1 when the heap has none
+static int heap_pop(MinCutSeparator *sep) {
+    while (sep->heap_size > 0) {
+        const int top = sep->heap_node[0];
+        const double top_key = sep->heap_key[0];
+        const int last = sep->heap_node[--sep->heap_size];
+        const double last_key = sep->heap_key[sep->heap_size];
+        int i = 0;
+        for (int child = 1; child < sep->heap_size; child = 2 * i + 1) {
+            if (child + 1 < sep->heap_size && sep->heap_key[child + 1] > sep->heap_key[child]) child++;
+            if (sep->heap_key[child] <= last_key) break;
+            sep->heap_node[i] = sep->heap_node[child];
+            sep->heap_key[i] = sep->heap_key[child];
+            i = child;
+        }
+        sep->heap_node[i] = last;
+        sep->heap_key[i] = last_key;
+        // An entry is stale once its supernode is added or its key grew again
+        if (!sep->added[top] && top_key == sep->key[top]) return top;
+    }
+    return -1;
+}
+
+// Adds v to the growing set: every neighbor group gets closer to it
+static void attach(MinCutSeparator *sep, const int v) {
+    sep->added[v] = 1;
+    for (int e = sep->adj_head[v]; e != -1; e = sep->adj_next[e]) {
+        const int u = sep->owner[sep->adj_to[e]];
+        if (sep->added[u]) continue; // also the edges inside the group of v
+        sep->key[u] += sep->adj_weight[e];
+        heap_push(sep, u, sep->key[u]);
+    }
+}
+
+/*
+ * Stoer-Wagner on the adjacency lists of the shrunk support graph. Every phase orders the groups by
+ * maximum adjacency with a heap, in O(E log E) for E list entries; the last one, t, is separated from
+ * the rest by a minimum s-t cut, reported when violated, and then merged into the one before it.
+ */
+static void stoer_wagner(MinCutSeparator *sep, const int m, const double threshold, const int max_cuts) {
+    int num_active = m;
+    for (int s = 0; s < m; s++) {
+        sep->active[s] = s;
+        sep->owner[s] = s;
+        sep->group_next[s] = -1;
+        sep->group_tail[s] = s;
+    }
+
+    while (num_active > 1 && sep->num_cuts < max_cuts) {
+        for (int k = 0; k < num_active; k++) {
+            sep->key[sep->active[k]] = 0.0;
+            sep->added[sep->active[k]] = 0;
+        }
+        sep->heap_size = 0;
+
+        int prev = -1, last = sep->active[0];
+        attach(sep, last);
+        for (int step = 1; step < num_active; step++) {
+            int best = heap_pop(sep);
+            // Only a group without any edge to the set is missing from the heap
+            for (int k = 0; best == -1; k++)
+                if (!sep->added[sep->active[k]]) best = sep->active[k];
+            prev = last;
+            last = best;
+            if (step + 1 < num_active) attach(sep, best);
+        }
+
+        if (sep->key[last] < threshold) emit_group(sep, last, sep->key[last]);
+
+        // Merge last into prev: their lists are joined, the edges between them become loops
+        if (sep->adj_head[last] != -1) {
+            if (sep->adj_head[prev] == -1) sep->adj_head[prev] = sep->adj_head[last];
+            else sep->adj_next[sep->adj_tail[prev]] = sep->adj_head[last];
+            sep->adj_tail[prev] = sep->adj_tail[last];
+        }
+        for (int s = last; s != -1; s = sep->group_next[s]) sep->owner[s] = prev;
+        sep->group_next[sep->group_tail[prev]] = last;
+        sep->group_tail[prev] = sep->group_tail[last];
+
+        for (int k = 0; k < num_active; k++) {
+            if (sep->active[k] == last) {
+                sep->active[k] = sep->active[--num_active];
+                break;
+            }
+        }
+    }
+}
+
+// Appends to to the adjacency list of from
+static void append_adj(MinCutSeparator *sep, const int from, const int to, const double value) {
+    if (sep->num_adj == sep->adj_capacity) {
+        sep->adj_capacity = sep->adj_capacity ? 2 * sep->adj_capacity : 8 * sep->n;
+        sep->adj_next = tsp_realloc(sep->adj_next, sep->adj_capacity * sizeof(int));
+        sep->adj_to = tsp_realloc(sep->adj_to, sep->adj_capacity * sizeof(int));
+        sep->adj_weight = tsp_realloc(sep->adj_weight, sep->adj_capacity * sizeof(double));
+    }
+    const int e = sep->num_adj++;
+    sep->adj_to[e] = to;
+    sep->adj_weight[e] = value;
+    sep->adj_next[e] = -1;
+    if (sep->adj_head[from] == -1) sep->adj_head[from] = e;
+    else sep->adj_next[sep->adj_tail[from]] = e;
+    sep->adj_tail[from] = e;
+}
+
+// Parallel edges between two supernodes stay separate entries: their weights add up in the keys
+static void add_weight(MinCutSeparator *sep, const int i, const int j, const double value) {
+    const int a = sep->super_of[i], b = sep->super_of[j];
+    if (value <= SUPPORT_EPS || a == b) return;
+    append_adj(sep, a, b, value);
+    append_adj(sep, b, a, value);
+}
+
+static int run(MinCutSeparator *sep, const SupportGraph *g, const double tolerance, const int max_cuts) {
+    const int n = sep->n;
+    sep->num_cuts = 0;
+    if (n < 4 || max_cuts <= 0) return 0;
+
+    const int components = union_edges(sep, g, SUPPORT_EPS);
+    if (components > 1) return separate_components(sep, components, max_cuts);
+
+    const int m = union_edges(sep, g, 1.0 - SHRINK_EPS);
+    if (m < 2 || m > MIN_CUT_MAX_SUPERNODES) return 0;
+    bucket_members(sep, m);
+
+    for (int s = 0; s < m; s++) sep->adj_head[s] = -1;
+    sep->num_adj = 0;
+    if (g->edge_u) {
+        for (int e = 0; e < g->num_edges; e++) add_weight(sep, g->edge_u[e], g->edge_v[e], g->x[e]);
+    } else {
+        for (int i = 0; i < n; i++) {
+            const int base = row_base(i, n);
+            for (int j = i + 1; j < n; j++) add_weight(sep, i, j, g->x[base + j]);
+        }
+    }
+    // A phase pushes at most one entry per list entry, plus its first supernode
+    if (sep->num_adj + 1 > sep->heap_capacity) {
+        sep->heap_capacity = sep->num_adj + 1;
+        sep->heap_node = tsp_realloc(sep->heap_node, sep->heap_capacity * sizeof(int));
+        sep->heap_key = tsp_realloc(sep->heap_key, sep->heap_capacity * sizeof(double));
+    }
+
+    stoer_wagner(sep, m, 2.0 - tolerance, max_cuts);
+    return sep->num_cuts;
+}
+
+int min_cut_separator_run(MinCutSeparator *sep, const double *x_star, const double tolerance, const int max_cuts) {
+    const SupportGraph g = {.x = x_star, .edge_u = NULL, .edge_v = NULL, .num_edges = 0};
+    return run(sep, &g, tolerance, max_cuts);
+}
+
+int min_cut_separator_run_sparse(MinCutSeparator *sep, const int *edge_u, const int *edge_v, const double *x,
+                                 const int num_edges, const double tolerance, const int max_cuts) {
+    const SupportGraph g = {.x = x, .edge_u = edge_u, .edge_v = edge_v, .num_edges = num_edges};
+    return run(sep, &g, tolerance, max_cuts);
+}
+
+const int *min_cut_separator_get_cut(const MinCutSeparator *sep, const int k, int *size, double *cut_value) {
+    *size = sep->cut_beg[k + 1] - sep->cut_beg[k];
+    if (cut_value) *cut_value = sep->cut_value[k];
+    return sep->cut_nodes + sep->cut_beg[k];
+}
@@ -0,0 +1,12 @@
+#include "mip_backend.h"
+#include <stddef.h>
+
+const MipBackend *mip_backend_default(void) {
+#if defined(ENABLE_CPLEX)
+    return &CPLEX_MIP_BACKEND;
+#elif defined(ENABLE_GLPK)
+    return &GLPK_MIP_BACKEND;
+#else
+    return NULL;
+#endif
+}
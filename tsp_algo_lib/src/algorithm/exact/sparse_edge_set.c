@@ -0,0 +1,140 @@
+#include "sparse_edge_set.h"
+#include "c_util.h"
+#include <stdint.h>
+#include <string.h>
+
+SparseEdgeSet *sparse_edge_set_create(const int num_nodes) {
+    SparseEdgeSet *set = tsp_malloc(sizeof(SparseEdgeSet));
+    const int size = num_nodes > 0 ? num_nodes : 1;
+    set->num_nodes = num_nodes;
+    set->num_edges = 0;
+    set->capacity = 4 * size;
+    set->edge_u = tsp_malloc(set->capacity * sizeof(int));
+    set->edge_v = tsp_malloc(set->capacity * sizeof(int));
+    set->head = tsp_malloc(size * sizeof(int));
+    set->next = tsp_malloc(2 * set->capacity * sizeof(int));
+    memset(set->head, -1, size * sizeof(int));
+
+    int slots = 16;
+    while (slots < 2 * set->capacity) slots *= 2;
+    set->slots = tsp_malloc(slots * sizeof(int));
+    set->slot_mask = slots - 1;
+    memset(set->slots, -1, slots * sizeof(int));
+    return set;
+}
+
+void sparse_edge_set_destroy(SparseEdgeSet *set) {
+    if (!set) return;
+    tsp_free(set->edge_u);
+    tsp_free(set->edge_v);
+    tsp_free(set->head);
+    tsp_free(set->next);
+    tsp_free(set->slots);
+    tsp_free(set);
+}
+
+static int slot_of(const SparseEdgeSet *set, const int u, const int v) {
+    const uint64_t key = (uint64_t) u * (uint64_t) set->num_nodes + (uint64_t) v;
+    return (int) (((key * 0x9E3779B97F4A7C15ULL) >> 32) & (uint64_t) set->slot_mask);
+}
+
+int sparse_edge_set_find(const SparseEdgeSet *set, int u, int v) {
+    if (u > v) swap_int(&u, &v);
+    for (int s = slot_of(set, u, v);; s = (s + 1) & set->slot_mask) {
+        const int col = set->slots[s];
+        if (col == -1) return -1;
+        if (set->edge_u[col] == u && set->edge_v[col] == v) return col;
+    }
+}
+
+static void insert_slot(SparseEdgeSet *set, const int col) {
+    int s = slot_of(set, set->edge_u[col], set->edge_v[col]);
+    while (set->slots[s] != -1) s = (s + 1) & set->slot_mask;
+    set->slots[s] = col;
+}
+
+// Doubles the column arrays and the table, which stays at most half full
+static void grow(SparseEdgeSet *set) {
+    set->capacity *= 2;
+    set->edge_u = tsp_realloc(set->edge_u, set->capacity * sizeof(int));
+    set->edge_v = tsp_realloc(set->edge_v, set->capacity * sizeof(int));
+    set->next = tsp_realloc(set->next, 2 * set->capacity * sizeof(int));
+
+    const int slots = 2 * (set->slot_mask + 1);
+    tsp_free(set->slots);
+    set->slots = tsp_malloc(slots * sizeof(int));
+    set->slot_mask = slots - 1;
+    memset(set->slots, -1, slots * sizeof(int));
+    for (int col = 0; col < set->num_edges; col++) insert_slot(set, col);
+}
+
+int sparse_edge_set_add(SparseEdgeSet *set, int u, int v) {
+    if (u > v) swap_int(&u, &v);
+    const int found = sparse_edge_set_find(set, u, v);
+    if (found != -1) return found;
+
+    if (set->num_edges == set->capacity) grow(set);
+    const int col = set->num_edges++;
+    set->edge_u[col] = u;
+    set->edge_v[col] = v;
+    insert_slot(set, col);
+
+    set->next[2 * col] = set->head[u];
+    set->head[u] = 2 * col;
+    set->next[2 * col + 1] = set->head[v];
+    set->head[v] = 2 * col + 1;
+    return col;
+}
+
+void sparse_edge_set_add_candidates(SparseEdgeSet *set, const CandidateLists *candidates) {
+    const int k = candidate_lists_get_k(candidates);
+    for (int u = 0; u < set->num_nodes; u++) {
+        const int *neighbors = candidate_lists_get(candidates, u);
+        for (int r = 0; r < k; r++) sparse_edge_set_add(set, u, neighbors[r]);
+    }
+}
+
+// Endpoint of the column of incidence entry e that is not the node the entry belongs to
+static int other_end(const SparseEdgeSet *set, const int e) {
+    return e & 1 ? set->edge_u[e >> 1] : set->edge_v[e >> 1];
+}
+
+int sparse_edge_set_price(SparseEdgeSet *set, const double *costs, const double *node_duals, const double threshold,
+                          const int max_per_node) {
+    const int n = set->num_nodes;
+    const int keep = max_per_node > 0 ? max_per_node : n;
+    unsigned char *present = tsp_calloc(n > 0 ? n : 1, sizeof(unsigned char));
+    int *best = tsp_malloc(keep * sizeof(int));
+    double *best_rc = tsp_malloc(keep * sizeof(double));
+    int added = 0;
+
+    for (int u = 0; u < n; u++) {
+        for (int e = set->head[u]; e != -1; e = set->next[e]) present[other_end(set, e)] = 1;
+
+        // Bounded insertion sort on the reduced cost, most negative first
+        int size = 0;
+        const double *cost_row = costs + (size_t) u * n;
+        for (int v = u + 1; v < n; v++) {
+            if (present[v]) continue;
+            const double rc = cost_row[v] - node_duals[u] - node_duals[v];
+            if (rc >= threshold || (size == keep && rc >= best_rc[size - 1])) continue;
+            int pos = size < keep ? size++ : keep - 1;
+            while (pos > 0 && best_rc[pos - 1] > rc) {
+                best[pos] = best[pos - 1];
+                best_rc[pos] = best_rc[pos - 1];
+                pos--;
+            }
+            best[pos] = v;
+            best_rc[pos] = rc;
+        }
+
+        for (int e = set->head[u]; e != -1; e = set->next[e]) present[other_end(set, e)] = 0;
+        for (int r = 0; r < size; r++) sparse_edge_set_add(set, u, best[r]);
+        added += size;
+    }
+
+    tsp_free(present);
+    tsp_free(best);
+    tsp_free(best_rc);
+    return added;
+}
@@ -1,23 +1,20 @@
 #include "subtour_separator.h"
-#include "cplex_solver_wrapper.h" // For xpos
 #include "c_util.h"
-#include <stdlib.h>
 #include <string.h>
 
-// Helper structure for sparse graph traversal
-typedef struct {
-    int *head;
-    int *next;
-    int *to;
-    int edge_count;
-} AdjacencyList;
-
 ConnectedComponents *connected_components_create(int num_nodes) {
     ConnectedComponents *cc = tsp_malloc(sizeof(ConnectedComponents));
+    const int size = num_nodes > 0 ? num_nodes : 1;
 
-    cc->component_of_node = tsp_malloc(num_nodes * sizeof(int));
-    cc->nodes_in_component = tsp_malloc(num_nodes * sizeof(int)); // Helper counter
+    cc->num_components = 0;
+    cc->component_of_node = tsp_malloc(size * sizeof(int));
+    cc->nodes_in_component = tsp_malloc(size * sizeof(int));
+    cc->component_start = tsp_malloc((size + 1) * sizeof(int));
+    cc->component_nodes = tsp_malloc(size * sizeof(int));
 
+    // Union-find forest and bucketing cursor, sized once
+    cc->parent = tsp_malloc(size * sizeof(int));
+    cc->cursor = tsp_malloc(size * sizeof(int));
 
     return cc;
 }
@@ -26,87 +23,75 @@ void connected_components_destroy(ConnectedComponents *cc) {
     if (!cc) return;
     tsp_free(cc->component_of_node);
     tsp_free(cc->nodes_in_component);
+    tsp_free(cc->component_start);
+    tsp_free(cc->component_nodes);
+    tsp_free(cc->parent);
+    tsp_free(cc->cursor);
     tsp_free(cc);
 }
 
-// Iterative DFS to mark connected components
-static void dfs(int start_node, int comp_id, int *comp_array, const AdjacencyList *adj) {
-    // Stack size is conservative (num edges)
-    int *stack = tsp_malloc((adj->edge_count + 100) * sizeof(int));
-
-    int top = 0;
-
-    stack[top++] = start_node;
-    comp_array[start_node] = comp_id;
+// Root of the set of v, halving the path on the way
+static int find_root(int *parent, int v) {
+    while (parent[v] != v) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
 
-    while (top > 0) {
-        int u = stack[--top];
+// The smaller root wins, so every root is the smallest node of its set
+static void join(int *parent, const int u, const int v) {
+    const int a = find_root(parent, u), b = find_root(parent, v);
+    if (a != b) parent[a > b ? a : b] = a < b ? a : b;
+}
 
-        // Iterate neighbors of u
-        for (int e = adj->head[u]; e != -1; e = adj->next[e]) {
-            int v = adj->to[e];
-            if (comp_array[v] == -1) {
-                comp_array[v] = comp_id;
-                stack[top++] = v;
-            }
-        }
-    }
-    tsp_free(stack);
+static void reset(ConnectedComponents *cc, const int num_nodes) {
+    for (int i = 0; i < num_nodes; i++) cc->parent[i] = i;
 }
 
-void find_connected_components(ConnectedComponents *cc, int num_nodes, const double *x_star) {
-    // Reset state
-    cc->num_components = 0;
+/*
+ * Numbers the sets by smallest node and buckets the nodes per set: one pass labels and counts,
+ * a counting sort places them (nodes stay in increasing order).
+ */
+static void label_components(ConnectedComponents *cc, const int num_nodes) {
+    int k = 0;
     for (int i = 0; i < num_nodes; i++) {
-        cc->component_of_node[i] = -1;
-        cc->nodes_in_component[i] = 0; // Not strictly used for logic but good for debugging
+        const int root = find_root(cc->parent, i);
+        if (root == i) {
+            cc->component_of_node[i] = ++k;
+            cc->nodes_in_component[k - 1] = 1;
+        } else {
+            cc->component_of_node[i] = cc->component_of_node[root];
+            cc->nodes_in_component[cc->component_of_node[i] - 1]++;
+        }
     }
+    cc->num_components = k;
 
-    // Build temporary Adjacency List from x_star solution
-    // We assume x_star contains edges (val > 0.5)
-    // Max directed edges for a tour is 2*N
-    int max_edges = num_nodes * 4;
-    int *adj_head = tsp_malloc(num_nodes * sizeof(int));
-    int *adj_next = tsp_malloc(max_edges * sizeof(int));
-    int *adj_to = tsp_malloc(max_edges * sizeof(int));
-
-
-    // Initialize list heads to -1 (end of list)
-    memset(adj_head, -1, num_nodes * sizeof(int));
+    cc->component_start[0] = 0;
+    for (int c = 0; c < k; c++) cc->component_start[c + 1] = cc->component_start[c] + cc->nodes_in_component[c];
+    memcpy(cc->cursor, cc->component_start, k * sizeof(int));
+    for (int i = 0; i < num_nodes; i++) cc->component_nodes[cc->cursor[cc->component_of_node[i] - 1]++] = i;
+}
 
-    int edge_idx = 0;
+void find_connected_components(ConnectedComponents *cc, int num_nodes, const double *x_star) {
+    reset(cc, num_nodes);
 
+    // One linear pass over x_star: row i holds the edges (i, j > i) from xpos(i, i + 1) on
+    int idx = 0;
     for (int i = 0; i < num_nodes; i++) {
-        for (int j = i + 1; j < num_nodes; j++) {
-            int idx = xpos(i, j, num_nodes);
-
-            // If edge is selected in CPLEX solution
-            if (x_star[idx] > 0.5) {
-                // Add Edge i -> j
-                adj_to[edge_idx] = j;
-                adj_next[edge_idx] = adj_head[i];
-                adj_head[i] = edge_idx++;
-
-                // Add Edge j -> i
-                adj_to[edge_idx] = i;
-                adj_next[edge_idx] = adj_head[j];
-                adj_head[j] = edge_idx++;
-            }
+        for (int j = i + 1; j < num_nodes; j++, idx++) {
+            if (x_star[idx] > 0.5) join(cc->parent, i, j);
         }
     }
 
-    AdjacencyList adj = {.head = adj_head, .next = adj_next, .to = adj_to, .edge_count = edge_idx};
+    label_components(cc, num_nodes);
+}
 
-    // Run DFS on unvisited nodes to find components
-    for (int i = 0; i < num_nodes; i++) {
-        if (cc->component_of_node[i] == -1) {
-            cc->num_components++;
-            dfs(i, cc->num_components, cc->component_of_node, &adj);
-        }
+void find_connected_components_sparse(ConnectedComponents *cc, int num_nodes, const int *edge_u, const int *edge_v,
+                                      const double *x, int num_edges) {
+    reset(cc, num_nodes);
+    for (int e = 0; e < num_edges; e++) {
+        if (!x || x[e] > 0.5) join(cc->parent, edge_u[e], edge_v[e]);
     }
-
-    // Cleanup
-    tsp_free(adj_head);
-    tsp_free(adj_next);
-    tsp_free(adj_to);
+    label_components(cc, num_nodes);
 }
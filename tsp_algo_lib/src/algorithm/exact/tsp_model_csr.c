@@ -0,0 +1,142 @@
+#include "tsp_model_csr.h"
+#include "cplex_solver_wrapper.h"
+#include "c_util.h"
+
+#include <pthread.h>
+#include <stdio.h>
+
+// Below this many nodes the fill takes less than a thread start
+#define CSR_MIN_NODES_PER_THREAD 256
+
+typedef struct {
+    TspModelCsr *model;
+    const double *costs;
+    int first_row;
+    int last_row;
+} CsrFillTask;
+
+/*
+ * Row h of the degree constraints and the columns x_h_j (j > h) are written by the same task:
+ * the columns of node h are contiguous in xpos order, so tasks never touch the same entries.
+ */
+static void *fill_rows(void *arg) {
+    const CsrFillTask *task = arg;
+    TspModelCsr *m = task->model;
+    const int n = m->num_nodes;
+
+    for (int h = task->first_row; h < task->last_row; h++) {
+        const int row_start = h * (n - 1);
+        m->rmatbeg[h] = row_start;
+        m->rhs[h] = 2.0;
+        m->sense[h] = 'E';
+
+        int nnz = row_start;
+        for (int i = 0; i < n; i++) {
+            if (i == h) continue;
+            m->rmatind[nnz] = xpos(h, i, n);
+            m->rmatval[nnz++] = 1.0;
+        }
+
+        if (h + 1 < n) {
+            const int col_start = xpos(h, h + 1, n);
+            for (int j = h + 1; j < n; j++) {
+                const int col = col_start + (j - h - 1);
+                m->obj[col] = task->costs[h * n + j];
+                m->ub[col] = 1.0;
+                m->ctype[col] = 'B';
+            }
+        }
+    }
+    return NULL;
+}
+
+static void fill_names(TspModelCsr *m) {
+    const int n = m->num_nodes;
+    // "x_" + two 10-digit numbers + separator + terminator, or "deg_" + one number
+    const size_t col_len = 24, row_len = 16;
+    m->name_buffer = tsp_malloc((size_t) m->num_cols * col_len + (size_t) n * row_len);
+    m->colname = tsp_malloc(m->num_cols * sizeof(char *));
+    m->rowname = tsp_malloc(n * sizeof(char *));
+
+    char *p = m->name_buffer;
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            m->colname[xpos(i, j, n)] = p;
+            p += snprintf(p, col_len, "x_%d_%d", i + 1, j + 1) + 1;
+        }
+    }
+    for (int h = 0; h < n; h++) {
+        m->rowname[h] = p;
+        p += snprintf(p, row_len, "deg_%d", h + 1) + 1;
+    }
+}
+
+TspModelCsr *tsp_model_csr_build(const TspInstance *inst, const bool with_names, int num_threads) {
+    const int n = tsp_instance_get_num_nodes(inst);
+    TspModelCsr *m = tsp_calloc(1, sizeof(TspModelCsr));
+    m->num_nodes = n;
+    m->num_cols = n * (n - 1) / 2;
+    m->num_rows = n;
+    m->nnz = n * (n - 1);
+
+    m->obj = tsp_malloc((m->num_cols > 0 ? m->num_cols : 1) * sizeof(double));
+    m->ub = tsp_malloc((m->num_cols > 0 ? m->num_cols : 1) * sizeof(double));
+    m->ctype = tsp_malloc((m->num_cols > 0 ? m->num_cols : 1) * sizeof(char));
+    m->rmatbeg = tsp_malloc((n > 0 ? n : 1) * sizeof(int));
+    m->rmatind = tsp_malloc((m->nnz > 0 ? m->nnz : 1) * sizeof(int));
+    m->rmatval = tsp_malloc((m->nnz > 0 ? m->nnz : 1) * sizeof(double));
+    m->rhs = tsp_malloc((n > 0 ? n : 1) * sizeof(double));
+    m->sense = tsp_malloc((n > 0 ? n : 1) * sizeof(char));
+
+    if (num_threads <= 0) num_threads = (int) get_max_threads();
+    if (num_threads > n / CSR_MIN_NODES_PER_THREAD) num_threads = n / CSR_MIN_NODES_PER_THREAD;
+    if (num_threads < 1) num_threads = 1;
+
+    CsrFillTask *tasks = tsp_malloc(num_threads * sizeof(CsrFillTask));
+    pthread_t *threads = tsp_malloc(num_threads * sizeof(pthread_t));
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+
+    const int chunk = (n + num_threads - 1) / num_threads;
+    for (int t = 0; t < num_threads; t++) {
+        tasks[t] = (CsrFillTask){
+            .model = m,
+            .costs = costs,
+            .first_row = t * chunk < n ? t * chunk : n,
+            .last_row = (t + 1) * chunk < n ? (t + 1) * chunk : n
+        };
+    }
+
+    // The calling thread takes the first chunk; a chunk whose thread cannot start is filled inline
+    bool *running = tsp_calloc(num_threads, sizeof(bool));
+    for (int t = 1; t < num_threads; t++) {
+        running[t] = pthread_create(&threads[t], NULL, fill_rows, &tasks[t]) == 0;
+        if (!running[t]) fill_rows(&tasks[t]);
+    }
+    fill_rows(&tasks[0]);
+    for (int t = 1; t < num_threads; t++) {
+        if (running[t]) pthread_join(threads[t], NULL);
+    }
+
+    if (with_names) fill_names(m);
+
+    tsp_free(running);
+    tsp_free(threads);
+    tsp_free(tasks);
+    return m;
+}
+
+void tsp_model_csr_destroy(TspModelCsr *model) {
+    if (!model) return;
+    tsp_free(model->obj);
+    tsp_free(model->ub);
+    tsp_free(model->ctype);
+    tsp_free(model->rmatbeg);
+    tsp_free(model->rmatind);
+    tsp_free(model->rmatval);
+    tsp_free(model->rhs);
+    tsp_free(model->sense);
+    tsp_free(model->colname);
+    tsp_free(model->rowname);
+    tsp_free(model->name_buffer);
+    tsp_free(model);
+}
@@ -17,6 +17,7 @@ static void run_em(const TspInstance *instance,
 
     TimeLimiter timer = time_limiter_create(cfg->time_limit);
     time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(solution));
 
     int *tour = tsp_malloc((n + 1) * sizeof(int));
 
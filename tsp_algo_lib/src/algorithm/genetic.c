@@ -2,35 +2,48 @@
 #include "tsp_math.h"
 #include "constructive.h"
 #include "local_search.h"
+#include "eax.h"
+#include "migration_queue.h"
+#include "tour_hash.h"
+#include "constants.h"
 #include "c_util.h"
+#include "arena.h"
 #include "logger.h"
 #include "time_limiter.h"
 #include <stdlib.h>
 #include <string.h>
 #include <float.h>
+#include <pthread.h>
+#include <stdbool.h>
 
 #include "random.h"
 
 typedef struct {
     int *genes;
     double *costs;
+    uint64_t *hashes; // tour_hash of every individual, maintained only with deduplication
     int n; // Number of nodes
     int stride; // Actual size in memory (n + 1) to include closing node
     int pop_size;
 } Population;
 
-static void population_alloc(Population *pop, const int size, const int n) {
+// Populations live in the run arena and are released with it
+static void population_alloc(Population *pop, const int size, const int n, Arena *arena) {
     pop->n = n;
     pop->stride = n + 1; // Extra space for closing node
     pop->pop_size = size;
-    // Use tsp_calloc for safety (initializes to 0)
-    pop->genes = tsp_calloc(size * pop->stride, sizeof(int));
-    pop->costs = tsp_calloc(size, sizeof(double));
+    pop->genes = arena_calloc(arena, (size_t) size * pop->stride, sizeof(int));
+    pop->costs = arena_calloc(arena, size, sizeof(double));
+    pop->hashes = arena_calloc(arena, size, sizeof(uint64_t));
 }
 
-static void population_free(const Population *pop) {
-    tsp_free(pop->genes);
-    tsp_free(pop->costs);
+/*
+ * Bytes of the run arena: two populations plus the RCL buffers of the GRASP initialization.
+ */
+static size_t run_arena_bytes(const GeneticConfig *cfg, const int n) {
+    const size_t population = (size_t) cfg->population_size * ((n + 1) * sizeof(int) + sizeof(double) + sizeof(uint64_t));
+    const size_t rcl = (size_t) cfg->init_grasp_rcl_size * (sizeof(int) + sizeof(double));
+    return 2 * population + rcl + 256;
 }
 
 static void population_copy_individual(const Population *dest, int dest_idx,
@@ -39,31 +52,37 @@ static void population_copy_individual(const Population *dest, int dest_idx,
            &src->genes[src_idx * src->stride],
            dest->stride * sizeof(int));
     dest->costs[dest_idx] = src->costs[src_idx];
+    dest->hashes[dest_idx] = src->hashes[src_idx];
 }
 
 static void population_swap(Population *pop, int idx1, int idx2) {
     if (idx1 == idx2) return;
 
-    double temp_cost = pop->costs[idx1];
-    pop->costs[idx1] = pop->costs[idx2];
-    pop->costs[idx2] = temp_cost;
+    swap_array_double(pop->costs, idx1, idx2);
+    const uint64_t temp_hash = pop->hashes[idx1];
+    pop->hashes[idx1] = pop->hashes[idx2];
+    pop->hashes[idx2] = temp_hash;
 
-    int *temp_genes = tsp_malloc(pop->stride * sizeof(int));
-
-
-    memcpy(temp_genes, &pop->genes[idx1 * pop->stride], pop->stride * sizeof(int));
-    memcpy(&pop->genes[idx1 * pop->stride], &pop->genes[idx2 * pop->stride], pop->stride * sizeof(int));
-    memcpy(&pop->genes[idx2 * pop->stride], temp_genes, pop->stride * sizeof(int));
-
-    tsp_free(temp_genes);
+    // In place: no temporary tour
+    int *genes1 = &pop->genes[idx1 * pop->stride];
+    int *genes2 = &pop->genes[idx2 * pop->stride];
+    for (int i = 0; i < pop->stride; i++)
+        swap_int(&genes1[i], &genes2[i]);
 }
 
-static void repair_child(int *child, int n, const double *costs) {
-    int *visited = tsp_calloc(n, sizeof(int));
-
-
-    int *temp_tour = tsp_malloc(n * sizeof(int));
+/*
+ * Per-thread scratch for the cut crossover repair (3n ints).
+ */
+typedef struct {
+    int *visited;
+    int *temp_tour;
+    int *missing;
+} RepairScratch;
 
+static void repair_child(int *child, int n, const double *costs, const RepairScratch *scratch) {
+    int *visited = scratch->visited;
+    int *temp_tour = scratch->temp_tour;
+    memset(visited, 0, n * sizeof(int));
 
     int current_len = 0;
 
@@ -79,9 +98,7 @@ static void repair_child(int *child, int n, const double *costs) {
     }
 
     // Phase 2: Identify missing nodes
-    int *missing = tsp_malloc(n * sizeof(int));
-
-
+    int *missing = scratch->missing;
     int missing_count = 0;
     for (int i = 0; i < n; i++) {
         if (!visited[i])
@@ -124,16 +141,16 @@ static void repair_child(int *child, int n, const double *costs) {
 
     // Crucial: Explicitly close the tour
     child[n] = child[0];
-
-    tsp_free(missing);
-    tsp_free(temp_tour);
-    tsp_free(visited);
 }
 
+/*
+ * One-point cut crossover followed by the greedy repair. Local search is left to the caller,
+ * which may reject the child first.
+ */
 static void crossover_operator(const int *parent1, const int *parent2,
                                int *child, const int n, const double *costs_matrix,
-                               const TimeLimiter *timer, const int cut_min, const int cut_max,
-                               RandomState *rng) {
+                               const int cut_min, const int cut_max,
+                               const RepairScratch *scratch, RandomState *rng) {
     const int range = cut_max - cut_min;
     const int ratio = cut_min + random_int(rng, 0, range);
     const int cut_point = n * ratio / 100;
@@ -143,8 +160,7 @@ static void crossover_operator(const int *parent1, const int *parent2,
            parent2 + cut_point,
            (n - cut_point) * sizeof(int));
 
-    repair_child(child, n, costs_matrix);
-    two_opt(child, n, costs_matrix, *timer);
+    repair_child(child, n, costs_matrix, scratch);
 }
 
 static void mutate(int *tour, const int n, RandomState *rng) {
@@ -172,49 +188,326 @@ static int tournament_selection(const Population *pop, int k, RandomState *rng)
     return best_idx;
 }
 
-static void run_genetic(const TspInstance *instance,
-                        TspSolution *solution,
-                        const void *config_void,
-                        CostRecorder *recorder) {
-    const GeneticConfig *cfg = config_void;
+/*
+ * Offspring generation. Child indices [elite_count, pop_size) are split statically among the
+ * workers; every worker owns its random stream, scratch buffers and deduplication state, so a
+ * generation depends only on the seed and the thread count. The main thread acts as worker 0.
+ * Workers only reject clones of the elites and of their own children; clones across workers are
+ * regenerated after the join, serially and in child order.
+ */
+typedef struct OffspringContext OffspringContext;
+
+typedef struct {
+    OffspringContext *ctx;
+    int begin;
+    int end;
     RandomState rng;
-    random_init(&rng, cfg->seed);
-    const int n = tsp_instance_get_num_nodes(instance);
-    const double *costs_matrix = tsp_instance_get_cost_matrix(instance);
+    RepairScratch repair;
+    EaxWorkspace *eax_ws;
+    Arena *arena; // Owns the repair scratch
+    TourHashSet *seen; // Elites and children of this worker in the current generation (NULL without dedup)
+    TourCache *cache; // Repaired cut children already optimized by 2-opt: hash -> local optimum cost
+    long duplicates; // Children rejected by the deduplication
+    pthread_t thread;
+    bool started;
+    unsigned long seen_generation;
+} OffspringWorker;
+
+struct OffspringContext {
+    const GeneticConfig *cfg;
+    int n;
+    const double *costs;
+    const CandidateLists *candidates;
+    const TimeLimiter *timer;
+    const Population *current;
+    Population *next;
+
+    // Deduplication (NULL when disabled)
+    TourHashSet *generation_set; // Hashes of the next population, borrowed; main thread only
+
+    OffspringWorker *workers;
+    int num_workers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t start_cv;
+    pthread_cond_t done_cv;
+    unsigned long generation;
+    int pending;
+    bool stop;
+};
+
+/*
+ * Builds one child in place, with its tour_hash when deduplication is enabled and its cost when
+ * already known (negative otherwise). With `reject_known`, a cut child whose repaired tour was
+ * already optimized is dropped before the 2-opt and the function returns false.
+ */
+static bool make_child(const OffspringContext *ctx, OffspringWorker *w, int *child, const bool reject_known,
+                       uint64_t *hash, double *cost) {
+    const GeneticConfig *cfg = ctx->cfg;
+    const Population *current = ctx->current;
+    const int n = ctx->n;
+    const bool dedup = ctx->generation_set != NULL;
+
+    const int p1 = tournament_selection(current, cfg->tournament_size, &w->rng);
+    const int p2 = tournament_selection(current, cfg->tournament_size, &w->rng);
+    *cost = -1.0;
+
+    if (w->eax_ws) {
+        double child_cost;
+        // Identical parents have no AB-cycle: the child is a copy of the first one
+        if (!eax_crossover(&current->genes[p1 * current->stride],
+                           current->costs[p1],
+                           &current->genes[p2 * current->stride],
+                           n, ctx->costs, ctx->candidates, EAX_TRIALS,
+                           child, &child_cost,
+                           w->eax_ws, &w->rng)) {
+            memcpy(child, &current->genes[p1 * current->stride], current->stride * sizeof(int));
+        }
+        if (dedup) *hash = tour_hash(child, n);
+    } else {
+        crossover_operator(
+            &current->genes[p1 * current->stride],
+            &current->genes[p2 * current->stride],
+            child,
+            n, ctx->costs,
+            cfg->crossover_cut_min_ratio,
+            cfg->crossover_cut_max_ratio,
+            &w->repair,
+            &w->rng
+        );
+
+        if (dedup) {
+            const uint64_t repaired = tour_hash(child, n);
+            double known_cost;
+            if (reject_known && tour_cache_lookup(w->cache, repaired, &known_cost))
+                return false;
+
+            *hash = repaired;
+            two_opt_hashed(child, n, ctx->costs, *ctx->timer, hash);
+            *cost = calculate_tour_cost(child, n, ctx->costs);
+            tour_cache_store(w->cache, repaired, *cost);
+        } else {
+            two_opt(child, n, ctx->costs, *ctx->timer);
+        }
+    }
 
-    if_verbose(VERBOSE_INFO,
-               "Genetic: Pop=%d, Elite=%d, Mut=%.2f, Time=%.2f\n",
-               cfg->population_size,
-               cfg->elite_count,
-               cfg->mutation_rate,
-               cfg->time_limit);
+    if (random_double(&w->rng) < cfg->mutation_rate) {
+        mutate(child, n, &w->rng);
+        if (dedup) *hash = tour_hash(child, n);
+        *cost = -1.0;
+    }
+    return true;
+}
 
-    TimeLimiter timer = time_limiter_create(cfg->time_limit);
-    time_limiter_start(&timer);
+/*
+ * Builds child i of the next population with the stream of w. Clones of tours already in `seen`
+ * are regenerated; the last attempt is always kept.
+ */
+static void build_child(const OffspringContext *ctx, OffspringWorker *w, const int i, TourHashSet *seen) {
+    Population *next = ctx->next;
+    int *child = &next->genes[i * next->stride];
+    uint64_t hash = 0;
+    double cost;
+
+    for (int attempt = 1; ; attempt++) {
+        const bool last = !seen || attempt >= GA_DEDUP_ATTEMPTS;
+        if (!make_child(ctx, w, child, !last, &hash, &cost)) {
+            w->duplicates++;
+            continue;
+        }
+        if (last) {
+            if (seen) tour_hash_set_insert(seen, hash);
+            break;
+        }
+        if (tour_hash_set_insert(seen, hash)) break;
+        w->duplicates++;
+    }
 
-    Population current_pop, next_pop;
-    population_alloc(&current_pop, cfg->population_size, n);
-    population_alloc(&next_pop, cfg->population_size, n);
+    next->costs[i] = cost >= 0.0 ? cost : calculate_tour_cost(child, ctx->n, ctx->costs);
+    next->hashes[i] = hash;
+}
+
+static void generate_offspring(const OffspringContext *ctx, OffspringWorker *w) {
+    for (int i = w->begin; i < w->end; i++) build_child(ctx, w, i, w->seen);
+}
+
+static void seed_with_elites(TourHashSet *set, const OffspringContext *ctx, const Population *next) {
+    tour_hash_set_clear(set);
+    for (int k = 0; k < ctx->cfg->elite_count && k < next->pop_size; k++)
+        tour_hash_set_insert(set, next->hashes[k]);
+}
 
+// After the join: children in index order, each clone of an earlier one rebuilt by the worker that owns it
+static void dedup_across_workers(OffspringContext *ctx) {
+    Population *next = ctx->next;
+    seed_with_elites(ctx->generation_set, ctx, next);
+    for (int t = 0; t < ctx->num_workers; t++) {
+        OffspringWorker *w = &ctx->workers[t];
+        for (int i = w->begin; i < w->end; i++) {
+            if (tour_hash_set_insert(ctx->generation_set, next->hashes[i])) continue;
+            w->duplicates++;
+            build_child(ctx, w, i, ctx->generation_set);
+        }
+    }
+}
+
+static void *offspring_worker_main(void *arg) {
+    OffspringWorker *w = arg;
+    OffspringContext *ctx = w->ctx;
+
+    while (true) {
+        pthread_mutex_lock(&ctx->lock);
+        while (!ctx->stop && ctx->generation == w->seen_generation)
+            pthread_cond_wait(&ctx->start_cv, &ctx->lock);
+        if (ctx->stop) {
+            pthread_mutex_unlock(&ctx->lock);
+            break;
+        }
+        w->seen_generation = ctx->generation;
+        pthread_mutex_unlock(&ctx->lock);
+
+        generate_offspring(ctx, w);
+
+        pthread_mutex_lock(&ctx->lock);
+        if (--ctx->pending == 0)
+            pthread_cond_signal(&ctx->done_cv);
+        pthread_mutex_unlock(&ctx->lock);
+    }
+    return NULL;
+}
+
+static void offspring_init(OffspringContext *ctx, const GeneticConfig *cfg, const int num_workers,
+                           const int n, const double *costs, const CandidateLists *candidates,
+                           const TimeLimiter *timer, const RandomState *rng, TourHashSet *generation_set) {
+    *ctx = (OffspringContext){
+        .cfg = cfg,
+        .n = n,
+        .costs = costs,
+        .candidates = candidates,
+        .timer = timer,
+        .generation_set = generation_set,
+        .num_workers = num_workers
+    };
+    pthread_mutex_init(&ctx->lock, NULL);
+    pthread_cond_init(&ctx->start_cv, NULL);
+    pthread_cond_init(&ctx->done_cv, NULL);
+
+    ctx->workers = tsp_calloc(num_workers, sizeof(OffspringWorker));
+    const int children = cfg->population_size - cfg->elite_count;
+
+    for (int t = 0; t < num_workers; t++) {
+        OffspringWorker *w = &ctx->workers[t];
+        w->ctx = ctx;
+        w->begin = cfg->elite_count + children * t / num_workers;
+        w->end = cfg->elite_count + children * (t + 1) / num_workers;
+
+        // A single worker continues the main stream, so the sequential results are unchanged
+        if (num_workers == 1) w->rng = *rng;
+        else random_init(&w->rng, cfg->seed + 0x9E3779B97F4A7C15ULL * (uint64_t) (t + 1));
+
+        if (generation_set) {
+            w->seen = tour_hash_set_create(cfg->population_size);
+            w->cache = tour_cache_create(TOUR_CACHE_SLOTS);
+        }
+
+        if (cfg->crossover == GA_CROSSOVER_EAX) {
+            w->eax_ws = eax_workspace_create(n);
+        } else {
+            // One arena per worker keeps the scratch of different threads on different cache lines
+            w->arena = arena_create(3 * n * sizeof(int) + 64);
+            w->repair.visited = arena_alloc(w->arena, n * sizeof(int));
+            w->repair.temp_tour = arena_alloc(w->arena, n * sizeof(int));
+            w->repair.missing = arena_alloc(w->arena, n * sizeof(int));
+        }
+
+        if (t > 0) {
+            w->started = pthread_create(&w->thread, NULL, offspring_worker_main, w) == 0;
+            if (!w->started)
+                if_verbose(VERBOSE_INFO, "[ERROR] GA: Failed to create offspring thread %d, running it inline\n", t);
+        }
+    }
+}
+
+static void offspring_generate(OffspringContext *ctx, const Population *current, Population *next) {
+    int started = 0;
+    for (int t = 1; t < ctx->num_workers; t++)
+        if (ctx->workers[t].started) started++;
+
+    // The elites are already in the next population
+    if (ctx->generation_set) {
+        for (int t = 0; t < ctx->num_workers; t++) seed_with_elites(ctx->workers[t].seen, ctx, next);
+    }
+
+    pthread_mutex_lock(&ctx->lock);
+    ctx->current = current;
+    ctx->next = next;
+    ctx->pending = started;
+    ctx->generation++;
+    pthread_cond_broadcast(&ctx->start_cv);
+    pthread_mutex_unlock(&ctx->lock);
+
+    // Worker 0 plus the share of any worker whose thread could not be created
+    for (int t = 0; t < ctx->num_workers; t++)
+        if (t == 0 || !ctx->workers[t].started)
+            generate_offspring(ctx, &ctx->workers[t]);
+
+    pthread_mutex_lock(&ctx->lock);
+    while (ctx->pending > 0)
+        pthread_cond_wait(&ctx->done_cv, &ctx->lock);
+    pthread_mutex_unlock(&ctx->lock);
+
+    if (ctx->generation_set && ctx->num_workers > 1) dedup_across_workers(ctx);
+}
+
+static void offspring_destroy(OffspringContext *ctx) {
+    pthread_mutex_lock(&ctx->lock);
+    ctx->stop = true;
+    pthread_cond_broadcast(&ctx->start_cv);
+    pthread_mutex_unlock(&ctx->lock);
+
+    long duplicates = 0;
+    for (int t = 0; t < ctx->num_workers; t++) {
+        OffspringWorker *w = &ctx->workers[t];
+        if (w->started) pthread_join(w->thread, NULL);
+        eax_workspace_destroy(w->eax_ws);
+        arena_destroy(w->arena);
+        tour_hash_set_destroy(w->seen);
+        tour_cache_destroy(w->cache);
+        duplicates += w->duplicates;
+    }
+    if (ctx->generation_set)
+        if_verbose(VERBOSE_INFO, "GA: %ld duplicate children rejected\n", duplicates);
+    tsp_free(ctx->workers);
+    pthread_cond_destroy(&ctx->done_cv);
+    pthread_cond_destroy(&ctx->start_cv);
+    pthread_mutex_destroy(&ctx->lock);
+}
+
+static void initialize_population(const GeneticConfig *cfg, Population *pop, const int n,
+                                  const double *costs_matrix, const TimeLimiter *timer, RandomState *rng,
+                                  Arena *scratch, TourHashSet *seen) {
     int grasp_count = (cfg->population_size * cfg->init_grasp_percent) / 100;
 
     if_verbose(VERBOSE_INFO,
                "GA: Initializing population (%d GRASP, %d random)\n",
                grasp_count, cfg->population_size - grasp_count);
 
-    for (int i = 0; i < cfg->population_size; i++) {
+    if (seen) tour_hash_set_clear(seen);
+
+    for (int i = 0, attempt = 1; i < cfg->population_size; attempt++) {
         // Access individual using correct stride
-        int *tour = &current_pop.genes[i * current_pop.stride];
+        int *tour = &pop->genes[i * pop->stride];
 
         if (i < grasp_count) {
             double c;
-            int res = grasp_nearest_neighbor_tour(random_int(&rng, 0, n - 1),
+            int res = grasp_nearest_neighbor_tour(random_int(rng, 0, n - 1),
                                                   tour,
                                                   n,
                                                   costs_matrix, &c,
                                                   cfg->init_grasp_rcl_size,
                                                   cfg->init_grasp_prob,
-                                                  &rng);
+                                                  rng,
+                                                  scratch);
             // grasp_nearest_neighbor_tour already closes the tour (tour[n] = tour[0])
 
             if (res != 0) {
@@ -226,7 +519,7 @@ static void run_genetic(const TspInstance *instance,
             for (int k = 0; k < n; k++) tour[k] = k;
             // Fisher-Yates
             for (int k = n - 1; k > 0; k--) {
-                const int j = random_int(&rng, 0, k);
+                const int j = random_int(rng, 0, k);
                 const int temp = tour[k];
                 tour[k] = tour[j];
                 tour[j] = temp;
@@ -234,73 +527,337 @@ static void run_genetic(const TspInstance *instance,
             tour[n] = tour[0]; // Explicitly close
         }
 
-        two_opt(tour, n, costs_matrix, timer);
-        current_pop.costs[i] = calculate_tour_cost(tour, n, costs_matrix);
+        if (seen) {
+            uint64_t hash = tour_hash(tour, n);
+            two_opt_hashed(tour, n, costs_matrix, *timer, &hash);
+            // A clone is rebuilt a few times before being accepted
+            if (!tour_hash_set_insert(seen, hash) && attempt < GA_DEDUP_ATTEMPTS) continue;
+            pop->hashes[i] = hash;
+        } else {
+            two_opt(tour, n, costs_matrix, *timer);
+        }
+        pop->costs[i] = calculate_tour_cost(tour, n, costs_matrix);
+        i++;
+        attempt = 0;
     }
+}
 
+/*
+ * Island model: every island evolves its own population in its own thread and, every
+ * migration_interval generations, sends copies of its best individuals to a neighbor through
+ * an SPSC queue (one per ordered pair of islands). Immigrants replace the worst individuals.
+ */
+typedef struct Archipelago Archipelago;
+
+typedef struct {
+    int id;
+    Archipelago *archipelago;
+    Population current;
+    Population next;
+    RandomState rng;
+    CostRecorder *recorder;
+    Arena *arena; // Populations and migration buffers
+    int *migrant_idx; // migration_count best indices
+    int *immigrant; // n + 1
+    pthread_t thread;
+    bool started;
+    int generations;
+} Island;
+
+struct Archipelago {
+    const GeneticConfig *cfg;
+    int n;
+    const double *costs;
+    const CandidateLists *candidates;
+    TspSolution *solution;
+    TimeLimiter timer;
+    int num_islands;
+    Island *islands;
+    MigrationQueue **queues; // queues[from * num_islands + to]
+};
+
+static void send_migrants(const Archipelago *arch, Island *island) {
+    const int k = arch->num_islands;
+    const Population *pop = &island->current;
+    int to = (island->id + 1) % k;
+    if (arch->cfg->migration_topology == MIGRATION_RANDOM) {
+        to = random_int(&island->rng, 0, k - 2);
+        if (to >= island->id) to++;
+    }
+
+    // Partial selection of the best individuals
+    const int count = arch->cfg->migration_count < pop->pop_size ? arch->cfg->migration_count : pop->pop_size;
+    for (int m = 0; m < count; m++) {
+        int best = -1;
+        for (int i = 0; i < pop->pop_size; i++) {
+            bool taken = false;
+            for (int j = 0; j < m && !taken; j++) taken = island->migrant_idx[j] == i;
+            if (!taken && (best < 0 || pop->costs[i] < pop->costs[best])) best = i;
+        }
+        island->migrant_idx[m] = best;
+        // A full queue means the neighbor is lagging behind: the migrant is dropped
+        migration_queue_push(arch->queues[island->id * k + to], &pop->genes[best * pop->stride], pop->costs[best]);
+    }
+}
+
+static void receive_migrants(const Archipelago *arch, Island *island) {
+    const int k = arch->num_islands;
+    Population *pop = &island->current;
+    double cost;
+
+    for (int from = 0; from < k; from++) {
+        MigrationQueue *queue = arch->queues[from * k + island->id];
+        if (!queue) continue;
+        while (migration_queue_pop(queue, island->immigrant, &cost)) {
+            int worst = 0;
+            for (int i = 1; i < pop->pop_size; i++)
+                if (pop->costs[i] > pop->costs[worst]) worst = i;
+            if (cost >= pop->costs[worst]) continue;
+
+            // With deduplication, an immigrant already living on the island is dropped
+            uint64_t hash = 0;
+            if (arch->cfg->deduplicate) {
+                hash = tour_hash(island->immigrant, pop->n);
+                bool clone = false;
+                for (int i = 0; i < pop->pop_size && !clone; i++) clone = pop->hashes[i] == hash;
+                if (clone) continue;
+            }
+
+            memcpy(&pop->genes[worst * pop->stride], island->immigrant, pop->stride * sizeof(int));
+            pop->costs[worst] = cost;
+            pop->hashes[worst] = hash;
+        }
+    }
+}
+
+/*
+ * Replaces the worst individual with the shared incumbent when it beats the whole population,
+ * which happens when other algorithms (or islands) write into the same solution.
+ */
+static void adopt_incumbent(TspSolution *solution, Population *pop, const bool deduplicate) {
+    int best = 0, worst = 0;
+    for (int i = 1; i < pop->pop_size; i++) {
+        if (pop->costs[i] < pop->costs[best]) best = i;
+        if (pop->costs[i] > pop->costs[worst]) worst = i;
+    }
+    double cost = pop->costs[best];
+    int *slot = &pop->genes[worst * pop->stride];
+    if (!tsp_solution_fetch_if_better(solution, slot, &cost)) return;
+
+    if_verbose(VERBOSE_DEBUG, "GA: adopting shared incumbent %.2f\n", cost);
+    pop->costs[worst] = cost;
+    pop->hashes[worst] = deduplicate ? tour_hash(slot, pop->n) : 0;
+}
+
+/*
+ * Main GA loop on one population. With an archipelago the island also exchanges migrants.
+ */
+static int evolve_population(const GeneticConfig *cfg, Population *current_pop, Population *next_pop,
+                             OffspringContext *offspring, TspSolution *solution, CostRecorder *recorder,
+                             const TimeLimiter *timer, const Archipelago *arch, Island *island) {
     int generation = 0;
-    while (!time_limiter_is_over(&timer)) {
+    while (!time_limiter_is_over(timer)) {
         // Lowered verbosity: Per-generation spam moves to VERBOSE_DEBUG (Level 2)
         if_verbose(VERBOSE_ALL, "GA: Generation %d\n", generation);
 
+        if (arch) receive_migrants(arch, island);
+        // Only island 0 looks at the shared solution: migration spreads it, the other islands keep their diversity
+        if (!arch || island->id == 0) adopt_incumbent(solution, current_pop, cfg->deduplicate);
+
         // Elitism: move best individuals to the beginning
         for (int k = 0; k < cfg->elite_count && k < cfg->population_size; k++) {
             int best_idx = k;
             for (int i = k + 1; i < cfg->population_size; i++) {
-                if (current_pop.costs[i] < current_pop.costs[best_idx]) {
+                if (current_pop->costs[i] < current_pop->costs[best_idx]) {
                     best_idx = i;
                 }
             }
-            population_swap(&current_pop, k, best_idx);
-            population_copy_individual(&next_pop, k, &current_pop, k);
+            population_swap(current_pop, k, best_idx);
+            population_copy_individual(next_pop, k, current_pop, k);
         }
 
-        double best_gen_cost = current_pop.costs[0];
+        double best_gen_cost = current_pop->costs[0];
 
         // Lowered verbosity: Result of generation moves to VERBOSE_DEBUG (Level 2)
         if_verbose(VERBOSE_DEBUG, "GA: Gen %d best=%.2f\n", generation, best_gen_cost);
 
         // Update solution (index 0 is the best after elitism swap)
         tsp_solution_update_if_better(solution,
-                                      &current_pop.genes[0],
+                                      &current_pop->genes[0],
                                       best_gen_cost);
 
         cost_recorder_add(recorder, best_gen_cost);
 
+        if (arch && generation > 0 && generation % cfg->migration_interval == 0)
+            send_migrants(arch, island);
+
         // Crossover and Mutation for the rest
-        for (int i = cfg->elite_count; i < cfg->population_size; i++) {
-            const int p1 = tournament_selection(&current_pop, cfg->tournament_size, &rng);
-            const int p2 = tournament_selection(&current_pop, cfg->tournament_size, &rng);
-
-            crossover_operator(
-                &current_pop.genes[p1 * current_pop.stride],
-                &current_pop.genes[p2 * current_pop.stride],
-                &next_pop.genes[i * next_pop.stride],
-                n, costs_matrix, &timer,
-                cfg->crossover_cut_min_ratio,
-                cfg->crossover_cut_max_ratio,
-                &rng
-            );
-
-            if (random_double(&rng) < cfg->mutation_rate) {
-                mutate(&next_pop.genes[i * next_pop.stride], n, &rng);
-            }
+        offspring_generate(offspring, current_pop, next_pop);
+
+        const Population tmp = *current_pop;
+        *current_pop = *next_pop;
+        *next_pop = tmp;
+
+        generation++;
+    }
+    return generation;
+}
+
+static void *island_main(void *arg) {
+    Island *island = arg;
+    const Archipelago *arch = island->archipelago;
+    const GeneticConfig *cfg = arch->cfg;
+
+    TourHashSet *seen = cfg->deduplicate ? tour_hash_set_create(cfg->population_size) : NULL;
+    initialize_population(cfg, &island->current, arch->n, arch->costs, &arch->timer, &island->rng, island->arena,
+                          seen);
+
+    // Islands already use one thread each: offspring are generated sequentially
+    OffspringContext offspring;
+    offspring_init(&offspring, cfg, 1, arch->n, arch->costs, arch->candidates, &arch->timer, &island->rng, seen);
+    island->generations = evolve_population(cfg, &island->current, &island->next, &offspring,
+                                            arch->solution, island->recorder, &arch->timer, arch, island);
+    offspring_destroy(&offspring);
+    tour_hash_set_destroy(seen);
+    return NULL;
+}
+
+static void run_islands(const GeneticConfig *cfg, const int n, const double *costs_matrix,
+                        const CandidateLists *candidates, TspSolution *solution, CostRecorder *recorder,
+                        const TimeLimiter *timer) {
+    const int k = cfg->num_islands;
+    if_verbose(VERBOSE_INFO, "GA: Island model with %d islands (%s, every %d gens, %d migrants)\n",
+               k, migration_topology_to_string(cfg->migration_topology),
+               cfg->migration_interval, cfg->migration_count);
+
+    Archipelago arch = {
+        .cfg = cfg,
+        .n = n,
+        .costs = costs_matrix,
+        .candidates = candidates,
+        .solution = solution,
+        .timer = *timer,
+        .num_islands = k,
+        .islands = tsp_calloc(k, sizeof(Island)),
+        .queues = tsp_calloc((size_t) k * k, sizeof(MigrationQueue *))
+    };
 
-            next_pop.costs[i] =
-                    calculate_tour_cost(&next_pop.genes[i * next_pop.stride], n, costs_matrix);
+    // Two batches of room: a slow island drops migrants instead of stalling its neighbors
+    const int capacity = 2 * (cfg->migration_count > 0 ? cfg->migration_count : 1);
+    for (int from = 0; from < k; from++) {
+        for (int to = 0; to < k; to++) {
+            const bool linked = cfg->migration_topology == MIGRATION_RANDOM ? from != to : to == (from + 1) % k;
+            if (linked && cfg->migration_count > 0)
+                arch.queues[from * k + to] = migration_queue_create(capacity, n);
         }
+    }
 
-        const Population tmp = current_pop;
-        current_pop = next_pop;
-        next_pop = tmp;
+    for (int i = 0; i < k; i++) {
+        Island *island = &arch.islands[i];
+        island->id = i;
+        island->archipelago = &arch;
+        const int migrants = cfg->migration_count > 0 ? cfg->migration_count : 1;
+        island->arena = arena_create(run_arena_bytes(cfg, n) + (migrants + n + 1) * sizeof(int));
+        population_alloc(&island->current, cfg->population_size, n, island->arena);
+        population_alloc(&island->next, cfg->population_size, n, island->arena);
+        random_init(&island->rng, cfg->seed + 0xD1B54A32D192ED03ULL * (uint64_t) i);
+        island->recorder = recorder ? cost_recorder_create_child(recorder, i) : NULL;
+        island->migrant_idx = arena_alloc(island->arena, migrants * sizeof(int));
+        island->immigrant = arena_alloc(island->arena, (n + 1) * sizeof(int));
+    }
 
-        generation++;
+    // Island 0 runs on the calling thread
+    for (int i = 1; i < k; i++) {
+        Island *island = &arch.islands[i];
+        island->started = pthread_create(&island->thread, NULL, island_main, island) == 0;
+        if (!island->started)
+            if_verbose(VERBOSE_INFO, "[ERROR] GA: Failed to create island thread %d\n", i);
     }
+    island_main(&arch.islands[0]);
+
+    for (int i = 0; i < k; i++) {
+        Island *island = &arch.islands[i];
+        if (island->started) pthread_join(island->thread, NULL);
+        if_verbose(VERBOSE_DEBUG, "GA: Island %d stopped at gen %d\n", i, island->generations);
+
+        if (recorder && island->recorder) cost_recorder_merge(recorder, island->recorder);
+        cost_recorder_destroy(island->recorder);
+        arena_destroy(island->arena);
+    }
+
+    if_verbose(VERBOSE_INFO, "GA: Time limit reached at gen %d (island 0)\n", arch.islands[0].generations);
+
+    for (int q = 0; q < k * k; q++) migration_queue_destroy(arch.queues[q]);
+    tsp_free(arch.queues);
+    tsp_free(arch.islands);
+}
+
+static void run_genetic(const TspInstance *instance,
+                        TspSolution *solution,
+                        const void *config_void,
+                        CostRecorder *recorder) {
+    const GeneticConfig *cfg = config_void;
+    RandomState rng;
+    random_init(&rng, cfg->seed);
+    const int n = tsp_instance_get_num_nodes(instance);
+    const double *costs_matrix = tsp_instance_get_cost_matrix(instance);
+
+    if_verbose(VERBOSE_INFO,
+               "Genetic: Pop=%d, Elite=%d, Mut=%.2f, Crossover=%s, Time=%.2f\n",
+               cfg->population_size,
+               cfg->elite_count,
+               cfg->mutation_rate,
+               genetic_crossover_to_string(cfg->crossover),
+               cfg->time_limit);
+
+    TimeLimiter timer = time_limiter_create(cfg->time_limit);
+    time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(solution));
+    // Islands and offspring workers hold copies of the timer: the first one out of time stops them all
+    CancelToken *expired = cancel_token_create();
+    time_limiter_share_expiry(&timer, expired);
+
+    // The candidate lists used by EAX are cached by the instance
+    const CandidateLists *candidates = cfg->crossover == GA_CROSSOVER_EAX
+                                           ? tsp_instance_get_candidate_lists(instance)
+                                           : NULL;
+
+    if (cfg->num_islands > 1) {
+        run_islands(cfg, n, costs_matrix, candidates, solution, recorder, &timer);
+        cancel_token_destroy(expired);
+        return;
+    }
+
+    // 0 implies auto-detect; never more workers than children
+    int num_threads = cfg->num_threads > 0 ? cfg->num_threads : (int) get_max_threads();
+    const int children = cfg->population_size - cfg->elite_count;
+    if (num_threads > children) num_threads = children > 0 ? children : 1;
+
+    // Everything the run needs is allocated up front: the generation loop never calls malloc
+    Arena *arena = arena_create(run_arena_bytes(cfg, n));
+    Population current_pop, next_pop;
+    population_alloc(&current_pop, cfg->population_size, n, arena);
+    population_alloc(&next_pop, cfg->population_size, n, arena);
+
+    // Hashes of the population being built, shared by the offspring workers
+    TourHashSet *seen = cfg->deduplicate ? tour_hash_set_create(cfg->population_size) : NULL;
+    initialize_population(cfg, &current_pop, n, costs_matrix, &timer, &rng, arena, seen);
+
+    // Workers are created once per run and take over the stream of the main generator
+    OffspringContext offspring;
+    offspring_init(&offspring, cfg, num_threads, n, costs_matrix, candidates, &timer, &rng, seen);
+    if (num_threads > 1)
+        if_verbose(VERBOSE_INFO, "GA: Generating offspring with %d threads\n", num_threads);
+
+    const int generation = evolve_population(cfg, &current_pop, &next_pop, &offspring,
+                                             solution, recorder, &timer, NULL, NULL);
 
     if_verbose(VERBOSE_INFO, "GA: Time limit reached at gen %d\n", generation);
 
-    population_free(&current_pop);
-    population_free(&next_pop);
+    offspring_destroy(&offspring);
+    tour_hash_set_destroy(seen);
+    arena_destroy(arena);
+    cancel_token_destroy(expired);
 }
 
 static void *genetic_clone_config(const void *config, uint64_t seed_offset) {
@@ -315,6 +872,22 @@ static void free_genetic_config(void *config) {
     tsp_free(config);
 }
 
+const char *migration_topology_to_string(const MigrationTopology topology) {
+    switch (topology) {
+        case MIGRATION_RANDOM: return "random";
+        case MIGRATION_RING:
+        default: return "ring";
+    }
+}
+
+const char *genetic_crossover_to_string(const GeneticCrossover crossover) {
+    switch (crossover) {
+        case GA_CROSSOVER_EAX: return "eax";
+        case GA_CROSSOVER_CUT:
+        default: return "cut";
+    }
+}
+
 TspAlgorithm genetic_create(GeneticConfig config) {
     GeneticConfig *cfg_copy = tsp_malloc(sizeof(GeneticConfig));
 
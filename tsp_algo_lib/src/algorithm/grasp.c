@@ -1,10 +1,44 @@
 #include "grasp.h"
 #include "c_util.h"
+#include "arena.h"
 #include "time_limiter.h"
 #include "logger.h"
+#include <math.h>
 #include <stdlib.h>
+#include <string.h>
+#include "constants.h"
 #include "constructive.h"
 #include "local_search.h"
+#include "tour_hash.h"
+
+/*
+ * Relinks the local optimum with an elite tour in the configured direction(s).
+ * Returns the cost of the best intermediate written to out_tour, or INFINITY if none exists.
+ */
+static double relink_with_elite(const GraspConfig *cfg,
+                                const int *tour,
+                                const double cost,
+                                const int *elite,
+                                const double elite_cost,
+                                const int n,
+                                const double *costs,
+                                int *out_tour,
+                                int *scratch,
+                                PathRelinkWorkspace *ws) {
+    double best = INFINITY;
+    double candidate_cost;
+
+    if (cfg->relinking != RELINK_FORWARD &&
+        path_relink(elite, elite_cost, tour, n, costs, out_tour, &candidate_cost, ws)) {
+        best = candidate_cost;
+    }
+    if (cfg->relinking != RELINK_BACKWARD &&
+        path_relink(tour, cost, elite, n, costs, scratch, &candidate_cost, ws) && candidate_cost < best) {
+        best = candidate_cost;
+        memcpy(out_tour, scratch, (n + 1) * sizeof(int));
+    }
+    return best;
+}
 
 static void run_grasp(const TspInstance *instance,
                       TspSolution *solution,
@@ -15,25 +49,57 @@ static void run_grasp(const TspInstance *instance,
     random_init(&rng, cfg->seed);
     if_verbose(VERBOSE_INFO, "GRASP: RCL=%d, Prob=%.2f, Stagnation=%d, Time=%.2f\n",
                cfg->rcl_size, cfg->probability, cfg->max_stagnation, cfg->time_limit);
+    if (cfg->use_candidate_lists)
+        if_verbose(VERBOSE_INFO, "GRASP: RCL drawn from %d-nearest-neighbor lists\n", CANDIDATE_LIST_SIZE);
+    if (cfg->elite_pool)
+        if_verbose(VERBOSE_INFO, "GRASP: path relinking (%s), elite size=%d, min diversity=%.2f\n",
+                   relinking_mode_to_string(cfg->relinking), cfg->elite_size, cfg->elite_min_diversity);
 
     const int n = tsp_instance_get_num_nodes(instance);
     const double *costs = tsp_instance_get_cost_matrix(instance);
 
     TimeLimiter timer = time_limiter_create(cfg->time_limit);
     time_limiter_start(&timer);
-
-    int *current_tour = tsp_malloc((n + 1) * sizeof(int));
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(solution));
+
+    // Per-run arena: tours, start nodes and the RCL scratch of the full-scan construction
+    const size_t tour_bytes = (n + 1) * sizeof(int);
+    Arena *arena = arena_create(4 * tour_bytes + n * sizeof(int) +
+                                cfg->rcl_size * (sizeof(int) + sizeof(double)) + 512);
+    int *current_tour = arena_alloc(arena, tour_bytes);
+
+    // Candidate-list construction needs per-run scratch; the lists themselves are cached by the instance
+    const CandidateLists *candidates = NULL;
+    GraspWorkspace *construction_ws = NULL;
+    if (cfg->use_candidate_lists) {
+        candidates = tsp_instance_get_candidate_lists(instance);
+        construction_ws = grasp_workspace_create(tsp_instance_get_nodes(instance), n, cfg->rcl_size);
+    }
 
 
     // Get initial solution state (if any)
     tsp_solution_get_tour(solution, current_tour);
 
     // Prepare starting nodes for multi-start
-    int *starting_nodes = tsp_malloc(n * sizeof(int));
+    int *starting_nodes = arena_alloc(arena, n * sizeof(int));
 
     for (int i = 0; i < n; i++) starting_nodes[i] = i;
     shuffle_int_array(starting_nodes, n, &rng);
 
+    // Relinking buffers, allocated once per run
+    int *elite_tour = NULL, *relinked_tour = NULL, *relink_scratch = NULL;
+    PathRelinkWorkspace *relink_ws = NULL;
+    if (cfg->elite_pool) {
+        elite_tour = arena_alloc(arena, tour_bytes);
+        relinked_tour = arena_alloc(arena, tour_bytes);
+        relink_scratch = arena_alloc(arena, tour_bytes);
+        relink_ws = path_relink_workspace_create(n);
+    }
+
+    // Deduplication: constructions and local optima already seen, keyed by tour_hash
+    TourCache *seen = cfg->deduplicate ? tour_cache_create(TOUR_CACHE_SLOTS) : NULL;
+    int duplicates = 0;
+
     double current_cost;
     int iter = 0;
     int stagnation_counter = 0;
@@ -43,20 +109,81 @@ static void run_grasp(const TspInstance *instance,
     while (!time_limiter_is_over(&timer) && iter < n && stagnation_counter < cfg->max_stagnation) {
         const int start_node = starting_nodes[iter];
 
-        const int res = grasp_nearest_neighbor_tour(
-            start_node,
-            current_tour,
-            n,
-            costs,
-            &current_cost,
-            cfg->rcl_size,
-            cfg->probability,
-            &rng
-        );
+        const int res = construction_ws
+                            ? grasp_candidate_tour(
+                                start_node,
+                                current_tour,
+                                n,
+                                costs,
+                                candidates,
+                                &current_cost,
+                                cfg->rcl_size,
+                                cfg->probability,
+                                &rng,
+                                construction_ws
+                            )
+                            : grasp_nearest_neighbor_tour(
+                                start_node,
+                                current_tour,
+                                n,
+                                costs,
+                                &current_cost,
+                                cfg->rcl_size,
+                                cfg->probability,
+                                &rng,
+                                arena
+                            );
+
+        uint64_t constructed = 0, optimum = 0;
+        double known_cost;
+        if (res == 0 && seen) {
+            constructed = tour_hash(current_tour, n);
+            // Same construction as before: its local optimum is known, the 2-opt is skipped
+            if (tour_cache_lookup(seen, constructed, &known_cost)) {
+                duplicates++;
+                cost_recorder_add(recorder, known_cost);
+                stagnation_counter++;
+                iter++;
+                continue;
+            }
+        }
 
         if (res == 0) {
             // Local Search Phase: 2-Opt
-            current_cost += two_opt(current_tour, n, costs, timer);
+            bool known_optimum = false;
+            if (seen) {
+                optimum = constructed;
+                current_cost += two_opt_hashed(current_tour, n, costs, timer, &optimum);
+                // A local optimum reached before has already been relinked
+                known_optimum = tour_cache_lookup(seen, optimum, &known_cost);
+                if (known_optimum) duplicates++;
+                tour_cache_store(seen, constructed, current_cost);
+                tour_cache_store(seen, optimum, current_cost);
+            } else {
+                current_cost += two_opt(current_tour, n, costs, timer);
+            }
+
+            // Path Relinking Phase: explore the trajectory between this optimum and an elite tour
+            if (cfg->elite_pool && !known_optimum) {
+                double elite_cost;
+                const bool has_elite = elite_pool_sample(cfg->elite_pool, &rng, elite_tour, &elite_cost);
+                elite_pool_try_add(cfg->elite_pool, current_tour, n, current_cost);
+
+                double relinked_cost = has_elite
+                                           ? relink_with_elite(cfg, current_tour, current_cost, elite_tour,
+                                                               elite_cost, n, costs, relinked_tour,
+                                                               relink_scratch, relink_ws)
+                                           : INFINITY;
+                if (relinked_cost < INFINITY) {
+                    relinked_cost += two_opt(relinked_tour, n, costs, timer);
+                    elite_pool_try_add(cfg->elite_pool, relinked_tour, n, relinked_cost);
+
+                    if (relinked_cost < current_cost - EPSILON) {
+                        memcpy(current_tour, relinked_tour, (n + 1) * sizeof(int));
+                        current_cost = relinked_cost;
+                    }
+                }
+            }
 
             cost_recorder_add(recorder, current_cost);
 
@@ -79,10 +206,13 @@ static void run_grasp(const TspInstance *instance,
         if_verbose(VERBOSE_INFO, "\tGRASP: Max stagnation reached.\n");
     }
     if_verbose(VERBOSE_DEBUG, "GRASP: Finished after %d iterations.\n", iter);
+    if (seen) if_verbose(VERBOSE_INFO, "\tGRASP: %d duplicate tours skipped.\n", duplicates);
 
     // Cleanup
-    tsp_free(starting_nodes);
-    tsp_free(current_tour);
+    tour_cache_destroy(seen);
+    path_relink_workspace_destroy(relink_ws);
+    grasp_workspace_destroy(construction_ws);
+    arena_destroy(arena);
 }
 
 static void *grasp_clone_config(const void *config, uint64_t seed_offset) {
@@ -90,11 +220,14 @@ static void *grasp_clone_config(const void *config, uint64_t seed_offset) {
     GraspConfig *dest = tsp_malloc(sizeof(GraspConfig));
     *dest = *src;
     dest->seed += seed_offset;
+    dest->elite_pool = elite_pool_retain(src->elite_pool);
     return dest;
 }
 
 static void free_grasp_config(void *config) {
-    tsp_free(config);
+    GraspConfig *cfg = config;
+    elite_pool_release(cfg->elite_pool);
+    tsp_free(cfg);
 }
 
 
@@ -103,6 +236,14 @@ TspAlgorithm grasp_create(GraspConfig config) {
 
     *cfg_copy = config;
 
+    if (cfg_copy->elite_size > 0) {
+        cfg_copy->elite_pool = cfg_copy->elite_pool
+                                   ? elite_pool_retain(cfg_copy->elite_pool)
+                                   : elite_pool_create(cfg_copy->elite_size, cfg_copy->elite_min_diversity);
+    } else {
+        cfg_copy->elite_pool = NULL;
+    }
+
     return (TspAlgorithm){
         .name = "GRASP",
         .config = cfg_copy,
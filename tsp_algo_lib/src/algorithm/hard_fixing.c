@@ -1,6 +1,7 @@
 #include "hard_fixing.h"
 #include "matheuristic_utils.h"
 #include "cplex_solver_wrapper.h"
+#include "mip_backend.h"
 #include "time_limiter.h"
 #include "logger.h"
 #include "c_util.h"
@@ -9,12 +10,32 @@
 
 #include "constants.h"
 
+// Clones fix fewer edges in turn, so that parallel workers explore neighborhoods of HF_RATE_LEVELS sizes
+#define HF_RATE_LEVELS 3
+#define HF_RATE_STEP 0.1
+
 static void free_hf_config(void *cfg_void) {
     HardFixingConfig *cfg = cfg_void;
     matheuristic_free_args(cfg->heuristic_args);
     tsp_free(cfg);
 }
 
+/*
+ * Worker i of execute_parallel: its own seed (also for the warm-start heuristic) and a fixing rate lowered
+ * by (i mod HF_RATE_LEVELS) steps.
+ * The workers share the solution, through which they re-center on each other's improvements.
+ */
+static void *hf_clone_config(const void *config, uint64_t seed_offset) {
+    const HardFixingConfig *src = config;
+    HardFixingConfig *dest = tsp_malloc(sizeof(HardFixingConfig));
+    *dest = *src;
+    dest->seed += seed_offset;
+    dest->heuristic_args = matheuristic_clone_args(src->heuristic_type, src->heuristic_args, seed_offset);
+    dest->fixing_rate -= HF_RATE_STEP * (double) (seed_offset % HF_RATE_LEVELS);
+    if (dest->fixing_rate < 0.0) dest->fixing_rate = 0.0;
+    return dest;
+}
+
 static void run_hard_fixing(const TspInstance *inst,
                             TspSolution *sol,
                             const void *cfg_void,
@@ -26,6 +47,7 @@ static void run_hard_fixing(const TspInstance *inst,
 
     TimeLimiter timer = time_limiter_create(cfg->time_limit);
     time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(sol));
 
     // Warm Start: allocate a portion of the time budget for the initial heuristic
     double heuristic_time = cfg->time_limit * cfg->heuristic_time_ratio;
@@ -41,10 +63,15 @@ static void run_hard_fixing(const TspInstance *inst,
     };
     matheuristic_run_warm_start(&ws_params, inst, sol, rec);
 
+    const MipBackend *mip = mip_backend_default();
+    if (!mip) {
+        if_verbose(VERBOSE_INFO, "[ERROR] Hard fixing sub-MIPs unavailable (no MIP solver)\n");
+        return;
+    }
     if (time_limiter_is_over(&timer)) return;
 
-#ifdef ENABLE_CPLEX
     int *current_tour = tsp_malloc((n + 1) * sizeof(int));
+    int *fixed_cols = tsp_malloc(n * sizeof(int));
 
     tsp_solution_get_tour(sol, current_tour);
     double current_cost = tsp_solution_get_cost(sol);
@@ -52,6 +79,25 @@ static void run_hard_fixing(const TspInstance *inst,
     RandomState rng;
     random_init(&rng, cfg->seed);
 
+    // One model for the whole run: each iteration only swaps the fixings and the MIP start,
+    // and the SECs separated so far stay in the model as rows
+    void *model = mip->create(inst);
+    if (!model || mip->build_model(model, inst) != 0) {
+        if (model) mip->destroy(model);
+        tsp_free(fixed_cols);
+        tsp_free(current_tour);
+        return;
+    }
+    // Concurrent workers split the cores instead of each taking all of them
+    int mip_threads = cfg->num_threads;
+    if (mip_threads <= 0 && cfg->num_workers > 1) {
+        mip_threads = (int) get_max_threads() / cfg->num_workers;
+        if (mip_threads < 1) mip_threads = 1;
+    }
+    mip->set_threads(model, mip_threads);
+    mip->install_sec_callback(model, inst);
+    mip->keep_sec_cuts(model, true);
+
     int iter = 0;
 
     while (!time_limiter_is_over(&timer)) {
@@ -62,7 +108,7 @@ static void run_hard_fixing(const TspInstance *inst,
         // Determine time budget for this specific iteration based on config
         double iter_limit = current_remaining * cfg->time_slice_factor;
 
-        // Ensure CPLEX has at least the minimum configured time to perform work
+        // Ensure the solver has at least the minimum configured time to perform work
         if (iter_limit < cfg->min_time_slice) {
             iter_limit = cfg->min_time_slice;
         }
@@ -72,49 +118,45 @@ static void run_hard_fixing(const TspInstance *inst,
             iter_limit = current_remaining;
         }
 
-        if (iter_limit < 1.0) break; // Stop if time is too short to initialize CPLEX
+        if (iter_limit < 1.0) break; // Stop if time is too short for a meaningful solve
 
-        CplexSolverContext *ctx = cplex_solver_create(inst);
-        if (!ctx) break;
+        // Re-center on the best tour of the run, which parallel workers may have improved
+        if (tsp_solution_fetch_if_better(sol, current_tour, &current_cost))
+            if_verbose(VERBOSE_DEBUG, "HF [Iter %d]: re-centered on the shared tour (%.2f)\n", iter, current_cost);
 
-        if (cplex_solver_build_base_model(ctx, inst) != 0) {
-            cplex_solver_destroy(ctx);
-            break;
-        }
+        // Undo the previous fixings
+        if (mip->reset_bounds(model) != 0) break;
 
         // Use the current best solution as MIP Start to prune the search tree
-        cplex_solver_add_mip_start(ctx, n, current_tour);
+        mip->clear_mip_starts(model);
+        mip->add_mip_start(model, n, current_tour);
 
         // HARD FIXING: Randomly fix edges present in the current tour
         int fixed_count = 0;
         for (int i = 0; i < n; i++) {
-            int u = current_tour[i];
-            int v = current_tour[i + 1];
-
-            if (random_double(&rng) < cfg->fixing_rate) {
-                cplex_solver_fix_edge(ctx, u, v, 1.0, n);
-                fixed_count++;
-            }
+            if (random_double(&rng) < cfg->fixing_rate)
+                fixed_cols[fixed_count++] = xpos(current_tour[i], current_tour[i + 1], n);
         }
+        if (mip->fix_edges(model, fixed_cols, fixed_count, 1.0) != 0) break;
 
-        cplex_solver_install_sec_callback(ctx, inst);
-        cplex_solver_set_time_limit(ctx, iter_limit);
+        mip->set_time_limit(model, iter_limit);
 
-        // Track CPLEX execution time
+        // Track solver execution time
         double start_opt = time_limiter_get_remaining(&timer);
-        int status = cplex_solver_optimize(ctx);
+        int status = mip->optimize(model);
         double end_opt = time_limiter_get_remaining(&timer);
 
-        if_verbose(VERBOSE_DEBUG, "HF [Iter %d]: CPLEX finished in %.3fs (Limit: %.2fs)\n",
-                   iter, (start_opt - end_opt), iter_limit);
+        int pooled = 0;
+        mip->flush_sec_pool(model, &pooled);
+        if_verbose(VERBOSE_DEBUG, "HF [Iter %d]: %s finished in %.3fs (Limit: %.2fs), %d SECs kept\n",
+                   iter, mip->name, (start_opt - end_opt), iter_limit, pooled);
 
-        if (status == 0 && cplex_solver_has_solution(ctx)) {
+        if (status == 0 && mip->has_solution(model)) {
             double cost = 0.0;
-            cplex_solver_extract_solution(ctx, &cost);
+            mip->extract_solution(model, &cost);
 
             if (cost < current_cost - EPSILON) {
-                const double *x = cplex_solver_get_x(ctx);
-                cplex_solver_reconstruct_tour(n, x, current_tour);
+                mip->extract_tour(model, n, current_tour);
 
                 tsp_solution_update_if_better(sol, current_tour, cost);
                 cost_recorder_add(rec, cost);
@@ -126,13 +168,11 @@ static void run_hard_fixing(const TspInstance *inst,
                 current_cost = cost;
             }
         }
-
-        // Destroy context to unfix variables and reset for next iteration
-        cplex_solver_destroy(ctx);
     }
 
+    mip->destroy(model);
+    tsp_free(fixed_cols);
     tsp_free(current_tour);
-#endif
 }
 
 TspAlgorithm hard_fixing_create(HardFixingConfig config) {
@@ -143,6 +183,6 @@ TspAlgorithm hard_fixing_create(HardFixingConfig config) {
         .run = run_hard_fixing,
         .config = c,
         .free_config = free_hf_config,
-        .clone_config = NULL
+        .clone_config = hf_clone_config
     };
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "tsp_math.h"
 #include <tgmath.h>
 #include <float.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -77,7 +78,8 @@ int grasp_nearest_neighbor_tour(const int starting_node,
                                 double *cost,
                                 const int rcl_size,
                                 const double probability,
-                                RandomState *rng) {
+                                RandomState *rng,
+                                Arena *scratch) {
     if (starting_node < 0 || starting_node >= number_of_nodes) {
         if_verbose(VERBOSE_INFO,
                    "[ERROR] GRASP-NN: starting node %d out of bounds [0,%d)\n",
@@ -95,9 +97,11 @@ int grasp_nearest_neighbor_tour(const int starting_node,
                "\tGRASP-NN: start=%d, RCL=%d, prob=%.3f\n",
                starting_node, rcl_size, probability);
 
-    int *rcl_nodes = tsp_malloc(rcl_size * sizeof(int));
-    double *rcl_costs = tsp_malloc(rcl_size * sizeof(double));
-
+    // Without a caller arena the RCL buffers get a short-lived one
+    Arena *arena = scratch ? scratch : arena_create(rcl_size * (sizeof(int) + sizeof(double)) + 64);
+    const ArenaMark mark = arena_mark(arena);
+    int *rcl_nodes = arena_alloc(arena, rcl_size * sizeof(int));
+    double *rcl_costs = arena_alloc(arena, rcl_size * sizeof(double));
 
     for (int i = 0; i < number_of_nodes; i++)
         tour[i] = i;
@@ -143,8 +147,8 @@ int grasp_nearest_neighbor_tour(const int starting_node,
         if (candidates_found == 0) {
             if_verbose(VERBOSE_INFO,
                        "[ERROR] GRASP-NN: empty RCL at step %d\n", i);
-            tsp_free(rcl_nodes);
-            tsp_free(rcl_costs);
+            if (scratch) arena_rewind(scratch, mark);
+            else arena_destroy(arena);
             return -1;
         }
 
@@ -171,8 +175,117 @@ int grasp_nearest_neighbor_tour(const int starting_node,
 
     if_verbose(VERBOSE_DEBUG, "\tGRASP-NN: tour complete, cost=%.6f\n", total_cost);
 
-    tsp_free(rcl_nodes);
-    tsp_free(rcl_costs);
+    if (scratch) arena_rewind(scratch, mark);
+    else arena_destroy(arena);
+    return 0;
+}
+
+/* --- Candidate-list GRASP Implementation --- */
+struct GraspWorkspace {
+    int n;
+    int rcl_capacity;
+    bool *visited;
+    int *rcl_nodes;
+    SpatialGrid *grid;
+};
+
+GraspWorkspace *grasp_workspace_create(const Node *nodes, const int n, const int rcl_capacity) {
+    GraspWorkspace *ws = tsp_malloc(sizeof(GraspWorkspace));
+    ws->n = n;
+    ws->rcl_capacity = rcl_capacity > 0 ? rcl_capacity : 1;
+    ws->visited = tsp_malloc(n * sizeof(bool));
+    ws->rcl_nodes = tsp_malloc(ws->rcl_capacity * sizeof(int));
+    ws->grid = spatial_grid_create(nodes, n);
+    return ws;
+}
+
+void grasp_workspace_destroy(GraspWorkspace *ws) {
+    if (!ws) return;
+    spatial_grid_destroy(ws->grid);
+    tsp_free(ws->visited);
+    tsp_free(ws->rcl_nodes);
+    tsp_free(ws);
+}
+
+int grasp_candidate_tour(const int starting_node,
+                         int *tour,
+                         const int number_of_nodes,
+                         const double *edge_cost_array,
+                         const CandidateLists *candidates,
+                         double *cost,
+                         const int rcl_size,
+                         const double probability,
+                         RandomState *rng,
+                         GraspWorkspace *ws) {
+    if (starting_node < 0 || starting_node >= number_of_nodes) {
+        if_verbose(VERBOSE_INFO,
+                   "[ERROR] GRASP-CL: starting node %d out of bounds [0,%d)\n",
+                   starting_node, number_of_nodes);
+        return -1;
+    }
+    if (rcl_size < 1) {
+        if_verbose(VERBOSE_INFO,
+                   "[ERROR] GRASP-CL: RCL size %d is invalid\n",
+                   rcl_size);
+        return -1;
+    }
+
+    const int k = candidate_lists_get_k(candidates);
+    int max_rcl = rcl_size < ws->rcl_capacity ? rcl_size : ws->rcl_capacity;
+    if (max_rcl > k) max_rcl = k;
+
+    if_verbose(VERBOSE_DEBUG,
+               "\tGRASP-CL: start=%d, RCL=%d, prob=%.3f\n",
+               starting_node, max_rcl, probability);
+
+    for (int i = 0; i < number_of_nodes; i++)
+        ws->visited[i] = false;
+    spatial_grid_fill(ws->grid);
+
+    int current_node = starting_node;
+    tour[0] = current_node;
+    ws->visited[current_node] = true;
+    spatial_grid_remove(ws->grid, current_node);
+    double total_cost = 0.0;
+
+    for (int i = 1; i < number_of_nodes; i++) {
+        // Candidate lists are sorted, so the first unvisited entries are the nearest unvisited nodes
+        int candidates_found = 0;
+        if (max_rcl > 0) {
+            const int *neighbors = candidate_lists_get(candidates, current_node);
+            for (int c = 0; c < k && candidates_found < max_rcl; c++) {
+                if (ws->visited[neighbors[c]]) continue;
+                ws->rcl_nodes[candidates_found++] = neighbors[c];
+            }
+        }
+
+        int next;
+        if (candidates_found == 0) {
+            next = spatial_grid_nearest(ws->grid, current_node);
+            if (next < 0) {
+                if_verbose(VERBOSE_INFO,
+                           "[ERROR] GRASP-CL: no unvisited node at step %d\n", i);
+                return -1;
+            }
+        } else if (random_double(rng) <= probability) {
+            next = ws->rcl_nodes[random_int(rng, 0, candidates_found - 1)];
+        } else {
+            next = ws->rcl_nodes[0];
+        }
+
+        total_cost += edge_cost_array[current_node * number_of_nodes + next];
+        tour[i] = next;
+        ws->visited[next] = true;
+        spatial_grid_remove(ws->grid, next);
+        current_node = next;
+    }
+
+    total_cost += edge_cost_array[current_node * number_of_nodes + tour[0]];
+    tour[number_of_nodes] = tour[0];
+    *cost = total_cost;
+
+    if_verbose(VERBOSE_DEBUG, "\tGRASP-CL: tour complete, cost=%.6f\n", total_cost);
+
     return 0;
 }
 
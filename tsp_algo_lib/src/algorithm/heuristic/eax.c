@@ -0,0 +1,225 @@
+#include "eax.h"
+#include <float.h>
+#include <string.h>
+#include "c_util.h"
+#include "subtour_patching.h"
+
+struct EaxWorkspace {
+    int n;
+    int *adj_a; // 2n, both neighbors of every node in parent A
+    int *adj_b;
+    int *child_adj; // adjacency of the child under construction
+    int *best_adj;
+    int *rem_a; // 2n, A edges not in B still to be walked
+    int *rem_b;
+    int *cnt_a;
+    int *cnt_b;
+    int *path; // alternating walk, at most 2n edges
+    int *path_pos; // n * 2 parities * 2 entries: indices of a node in the walk
+    int *path_pos_cnt; // n * 2
+    int *cycle_nodes; // all AB-cycles back to back
+    int *cycle_start; // offsets into cycle_nodes, one more than the cycle count
+    int *order;
+    SubtourPatcher *patcher; // merges the subtours of every trial child
+};
+
+EaxWorkspace *eax_workspace_create(const int n) {
+    EaxWorkspace *ws = tsp_malloc(sizeof(EaxWorkspace));
+    ws->n = n;
+    ws->adj_a = tsp_malloc(2 * n * sizeof(int));
+    ws->adj_b = tsp_malloc(2 * n * sizeof(int));
+    ws->child_adj = tsp_malloc(2 * n * sizeof(int));
+    ws->best_adj = tsp_malloc(2 * n * sizeof(int));
+    ws->rem_a = tsp_malloc(2 * n * sizeof(int));
+    ws->rem_b = tsp_malloc(2 * n * sizeof(int));
+    ws->cnt_a = tsp_malloc(n * sizeof(int));
+    ws->cnt_b = tsp_malloc(n * sizeof(int));
+    ws->path = tsp_malloc((2 * n + 1) * sizeof(int));
+    ws->path_pos = tsp_malloc(4 * n * sizeof(int));
+    ws->path_pos_cnt = tsp_malloc(2 * n * sizeof(int));
+    ws->cycle_nodes = tsp_malloc(2 * n * sizeof(int));
+    ws->cycle_start = tsp_malloc((n + 1) * sizeof(int));
+    ws->order = tsp_malloc(n * sizeof(int));
+    ws->patcher = subtour_patcher_create(n);
+    return ws;
+}
+
+void eax_workspace_destroy(EaxWorkspace *ws) {
+    if (!ws) return;
+    tsp_free(ws->adj_a);
+    tsp_free(ws->adj_b);
+    tsp_free(ws->child_adj);
+    tsp_free(ws->best_adj);
+    tsp_free(ws->rem_a);
+    tsp_free(ws->rem_b);
+    tsp_free(ws->cnt_a);
+    tsp_free(ws->cnt_b);
+    tsp_free(ws->path);
+    tsp_free(ws->path_pos);
+    tsp_free(ws->path_pos_cnt);
+    tsp_free(ws->cycle_nodes);
+    tsp_free(ws->cycle_start);
+    tsp_free(ws->order);
+    subtour_patcher_destroy(ws->patcher);
+    tsp_free(ws);
+}
+
+static void build_adjacency(const int *tour, const int n, int *adj) {
+    for (int i = 0; i < n; i++) {
+        adj[2 * tour[i]] = tour[i == 0 ? n - 1 : i - 1];
+        adj[2 * tour[i] + 1] = tour[i + 1];
+    }
+}
+
+static bool has_edge(const int *adj, const int u, const int v) {
+    return adj[2 * u] == v || adj[2 * u + 1] == v;
+}
+
+static void replace_neighbor(int *adj, const int node, const int old_neighbor, const int new_neighbor) {
+    if (adj[2 * node] == old_neighbor) adj[2 * node] = new_neighbor;
+    else adj[2 * node + 1] = new_neighbor;
+}
+
+static void remove_remaining(int *rem, int *cnt, const int u, const int v) {
+    int *list = rem + 2 * u;
+    if (list[0] == v && cnt[u] == 2) list[0] = list[1];
+    cnt[u]--;
+}
+
+/*
+ * Decomposes (A \ B) U (B \ A) into AB-cycles with a random alternating walk.
+ * Every node has as many remaining A edges as B edges, so the walk never gets stuck;
+ * a cycle is closed as soon as the walk returns to a node at an index of the same parity.
+ * Stored cycles always start with an A edge. Returns the number of cycles.
+ */
+static int build_ab_cycles(EaxWorkspace *ws, RandomState *rng) {
+    const int n = ws->n;
+
+    for (int v = 0; v < n; v++) {
+        ws->cnt_a[v] = ws->cnt_b[v] = 0;
+        for (int s = 0; s < 2; s++) {
+            const int a = ws->adj_a[2 * v + s];
+            const int b = ws->adj_b[2 * v + s];
+            if (!has_edge(ws->adj_b, v, a)) ws->rem_a[2 * v + ws->cnt_a[v]++] = a;
+            if (!has_edge(ws->adj_a, v, b)) ws->rem_b[2 * v + ws->cnt_b[v]++] = b;
+        }
+        ws->path_pos_cnt[2 * v] = ws->path_pos_cnt[2 * v + 1] = 0;
+    }
+
+    int cycles = 0;
+    int stored = 0;
+    ws->cycle_start[0] = 0;
+
+    for (int start = 0; start < n; start++) {
+        while (ws->cnt_a[start] > 0) {
+            int len = 0;
+            ws->path[len++] = start;
+            ws->path_pos[4 * start] = 0;
+            ws->path_pos_cnt[2 * start] = 1;
+
+            while (true) {
+                const int cur = ws->path[len - 1];
+                const bool a_edge = (len - 1) % 2 == 0;
+                if (len == 1 && ws->cnt_a[cur] == 0) break;
+
+                int *rem = a_edge ? ws->rem_a : ws->rem_b;
+                int *cnt = a_edge ? ws->cnt_a : ws->cnt_b;
+                const int next = rem[2 * cur + random_int(rng, 0, cnt[cur] - 1)];
+                remove_remaining(rem, cnt, cur, next);
+                remove_remaining(rem, cnt, next, cur);
+
+                const int parity = len % 2;
+                const int slot = 2 * next + parity;
+                if (ws->path_pos_cnt[slot] == 0) {
+                    ws->path_pos[2 * slot + ws->path_pos_cnt[slot]++] = len;
+                    ws->path[len++] = next;
+                    continue;
+                }
+
+                // Closed an alternating cycle path[p..len-1]; rotate it so that it starts with an A edge
+                const int p = ws->path_pos[2 * slot + ws->path_pos_cnt[slot] - 1];
+                const int size = len - p;
+                for (int i = 0; i < size; i++)
+                    ws->cycle_nodes[stored + i] = ws->path[p + (p % 2 + i) % size];
+                stored += size;
+                ws->cycle_start[++cycles] = stored;
+
+                for (int i = len - 1; i > p; i--)
+                    ws->path_pos_cnt[2 * ws->path[i] + i % 2]--;
+                len = p + 1;
+            }
+            ws->path_pos_cnt[2 * start] = 0;
+        }
+    }
+    return cycles;
+}
+
+/*
+ * Applies one AB-cycle to parent A in child_adj: its A edges are removed, its B edges added.
+ * Returns the cost delta.
+ */
+static double apply_ab_cycle(EaxWorkspace *ws, const int cycle, const double *costs) {
+    const int n = ws->n;
+    int *adj = ws->child_adj;
+    const int *nodes = ws->cycle_nodes + ws->cycle_start[cycle];
+    const int size = ws->cycle_start[cycle + 1] - ws->cycle_start[cycle];
+    double delta = 0.0;
+
+    memcpy(adj, ws->adj_a, 2 * n * sizeof(int));
+    for (int i = 0; i < size; i += 2) {
+        const int u = nodes[i], w = nodes[(i + 1) % size];
+        replace_neighbor(adj, u, w, -1);
+        replace_neighbor(adj, w, u, -1);
+        delta -= costs[u * n + w];
+    }
+    for (int i = 1; i < size; i += 2) {
+        const int u = nodes[i], w = nodes[(i + 1) % size];
+        replace_neighbor(adj, u, -1, w);
+        replace_neighbor(adj, w, -1, u);
+        delta += costs[u * n + w];
+    }
+    return delta;
+}
+
+bool eax_crossover(const int *parent_a,
+                   const double cost_a,
+                   const int *parent_b,
+                   const int n,
+                   const double *costs,
+                   const CandidateLists *candidates,
+                   int trials,
+                   int *child,
+                   double *child_cost,
+                   EaxWorkspace *ws,
+                   RandomState *rng) {
+    if (n < 4) return false;
+
+    build_adjacency(parent_a, n, ws->adj_a);
+    build_adjacency(parent_b, n, ws->adj_b);
+
+    const int cycles = build_ab_cycles(ws, rng);
+    if (cycles == 0) return false;
+
+    // Try a random subset of the AB-cycles, each one on a fresh copy of parent A
+    for (int c = 0; c < cycles; c++) ws->order[c] = c;
+    if (trials < 1) trials = 1;
+    if (trials > cycles) trials = cycles;
+
+    double best_cost = DBL_MAX;
+    for (int t = 0; t < trials; t++) {
+        const int pick = random_int(rng, t, cycles - 1);
+        swap_int(&ws->order[t], &ws->order[pick]);
+
+        double cost = cost_a + apply_ab_cycle(ws, ws->order[t], costs);
+        cost += subtour_patcher_merge(ws->patcher, ws->child_adj, costs, candidates);
+
+        if (cost < best_cost) {
+            best_cost = cost;
+            memcpy(ws->best_adj, ws->child_adj, 2 * n * sizeof(int));
+        }
+    }
+
+    subtour_adjacency_to_tour(ws->best_adj, n, child);
+    *child_cost = best_cost;
+    return true;
+}
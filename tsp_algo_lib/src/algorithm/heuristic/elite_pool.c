@@ -0,0 +1,150 @@
+#include "elite_pool.h"
+#include <pthread.h>
+#include <string.h>
+#include "c_util.h"
+
+struct ElitePool {
+    int capacity;
+    double min_diversity;
+    int n; // 0 until the first insertion
+    int min_distance;
+    int size;
+    int *tours; // capacity * (n + 1)
+    int *adjacency; // capacity * 2n, both neighbors of every node
+    double *costs;
+    int refcount;
+    pthread_mutex_t mutex;
+};
+
+static void build_adjacency(const int *tour, const int n, int *adjacency) {
+    for (int i = 0; i < n; i++) {
+        const int prev = tour[i == 0 ? n - 1 : i - 1];
+        adjacency[2 * tour[i]] = prev;
+        adjacency[2 * tour[i] + 1] = tour[i + 1];
+    }
+}
+
+static int distance_to_adjacency(const int *tour, const int n, const int *adjacency) {
+    int distance = 0;
+    for (int i = 0; i < n; i++) {
+        const int *neighbors = adjacency + 2 * tour[i];
+        if (neighbors[0] != tour[i + 1] && neighbors[1] != tour[i + 1]) distance++;
+    }
+    return distance;
+}
+
+int tour_edge_distance(const int *tour_a, const int *tour_b, const int n, int *adjacency_scratch) {
+    build_adjacency(tour_b, n, adjacency_scratch);
+    return distance_to_adjacency(tour_a, n, adjacency_scratch);
+}
+
+ElitePool *elite_pool_create(const int capacity, const double min_diversity) {
+    ElitePool *pool = tsp_calloc(1, sizeof(ElitePool));
+    pool->capacity = capacity > 0 ? capacity : 1;
+    pool->min_diversity = min_diversity;
+    pool->refcount = 1;
+    pthread_mutex_init(&pool->mutex, NULL);
+    return pool;
+}
+
+ElitePool *elite_pool_retain(ElitePool *pool) {
+    if (!pool) return NULL;
+    pthread_mutex_lock(&pool->mutex);
+    pool->refcount++;
+    pthread_mutex_unlock(&pool->mutex);
+    return pool;
+}
+
+void elite_pool_release(ElitePool *pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->mutex);
+    const int remaining = --pool->refcount;
+    pthread_mutex_unlock(&pool->mutex);
+    if (remaining > 0) return;
+
+    pthread_mutex_destroy(&pool->mutex);
+    tsp_free(pool->tours);
+    tsp_free(pool->adjacency);
+    tsp_free(pool->costs);
+    tsp_free(pool);
+}
+
+static void store_member(ElitePool *pool, const int slot, const int *tour, const double cost) {
+    const int n = pool->n;
+    memcpy(pool->tours + (size_t) slot * (n + 1), tour, (n + 1) * sizeof(int));
+    build_adjacency(tour, n, pool->adjacency + (size_t) slot * 2 * n);
+    pool->costs[slot] = cost;
+}
+
+bool elite_pool_try_add(ElitePool *pool, const int *tour, const int n, const double cost) {
+    if (!pool) return false;
+    pthread_mutex_lock(&pool->mutex);
+
+    if (pool->n == 0) {
+        pool->n = n;
+        pool->min_distance = (int) (pool->min_diversity * n + 0.5);
+        pool->tours = tsp_malloc((size_t) pool->capacity * (n + 1) * sizeof(int));
+        pool->adjacency = tsp_malloc((size_t) pool->capacity * 2 * n * sizeof(int));
+        pool->costs = tsp_malloc(pool->capacity * sizeof(double));
+    }
+
+    int best = -1, worst = -1;
+    for (int i = 0; i < pool->size; i++) {
+        if (best < 0 || pool->costs[i] < pool->costs[best]) best = i;
+        if (worst < 0 || pool->costs[i] > pool->costs[worst]) worst = i;
+    }
+
+    const bool full = pool->size == pool->capacity;
+    if (full && cost >= pool->costs[worst]) {
+        pthread_mutex_unlock(&pool->mutex);
+        return false;
+    }
+
+    const bool new_best = best < 0 || cost < pool->costs[best];
+    int closest_worse = -1;
+    int closest_worse_distance = n + 1;
+
+    for (int i = 0; i < pool->size; i++) {
+        const int distance = distance_to_adjacency(tour, n, pool->adjacency + (size_t) i * 2 * n);
+        // Duplicates are never admitted, near-duplicates only when they improve on the best
+        if (distance == 0 || (distance < pool->min_distance && !new_best)) {
+            pthread_mutex_unlock(&pool->mutex);
+            return false;
+        }
+        if (pool->costs[i] > cost && distance < closest_worse_distance) {
+            closest_worse_distance = distance;
+            closest_worse = i;
+        }
+    }
+
+    const int slot = full ? closest_worse : pool->size++;
+    store_member(pool, slot, tour, cost);
+
+    pthread_mutex_unlock(&pool->mutex);
+    return true;
+}
+
+bool elite_pool_sample(ElitePool *pool, RandomState *rng, int *out_tour, double *out_cost) {
+    if (!pool) return false;
+    pthread_mutex_lock(&pool->mutex);
+
+    if (pool->size == 0) {
+        pthread_mutex_unlock(&pool->mutex);
+        return false;
+    }
+
+    const int i = random_int(rng, 0, pool->size - 1);
+    memcpy(out_tour, pool->tours + (size_t) i * (pool->n + 1), (pool->n + 1) * sizeof(int));
+    *out_cost = pool->costs[i];
+
+    pthread_mutex_unlock(&pool->mutex);
+    return true;
+}
+
+int elite_pool_size(ElitePool *pool) {
+    if (!pool) return 0;
+    pthread_mutex_lock(&pool->mutex);
+    const int size = pool->size;
+    pthread_mutex_unlock(&pool->mutex);
+    return size;
+}
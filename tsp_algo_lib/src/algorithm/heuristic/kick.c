@@ -0,0 +1,215 @@
+#include "kick.h"
+#include <stdbool.h>
+#include <string.h>
+#include "c_util.h"
+#include "constants.h"
+#include "tsp_tour.h"
+
+struct KickWorkspace {
+    int n;
+    int max_cuts;
+    int *cuts; // sorted edge indices, edge i joins tour[i] and tour[i + 1]
+    int *segment; // rearranged segments before being written back
+    int *position; // position of every node in the tour (near double-bridge only)
+    bool positions_valid;
+    const CandidateLists *candidates;
+};
+
+KickWorkspace *kick_workspace_create(const int n, const int max_k, const CandidateLists *candidates) {
+    KickWorkspace *ws = tsp_malloc(sizeof(KickWorkspace));
+    ws->n = n;
+    ws->max_cuts = max_k > 4 ? max_k : 4;
+    ws->cuts = tsp_malloc(ws->max_cuts * sizeof(int));
+    ws->segment = tsp_malloc((n + 1) * sizeof(int));
+    ws->candidates = candidates;
+    ws->position = candidates ? tsp_malloc(n * sizeof(int)) : NULL;
+    ws->positions_valid = false;
+    return ws;
+}
+
+void kick_workspace_destroy(KickWorkspace *ws) {
+    if (!ws) return;
+    tsp_free(ws->cuts);
+    tsp_free(ws->segment);
+    tsp_free(ws->position);
+    tsp_free(ws);
+}
+
+void kick_workspace_reset(KickWorkspace *ws) {
+    ws->positions_valid = false;
+}
+
+static void track_positions(KickWorkspace *ws, const int *tour, const int from, const int to) {
+    if (!ws->positions_valid) return;
+    for (int i = from; i <= to; i++)
+        ws->position[tour[i]] = i;
+}
+
+static bool contains(const int *values, const int count, const int value) {
+    for (int i = 0; i < count; i++)
+        if (values[i] == value) return true;
+    return false;
+}
+
+static void insert_sorted(int *values, int count, const int value) {
+    while (count > 0 && values[count - 1] > value) {
+        values[count] = values[count - 1];
+        count--;
+    }
+    values[count] = value;
+}
+
+/*
+ * Floyd's sampling: k distinct values of [lo, hi] in O(k^2) time,
+ * independent of the range size (no n-sized candidate array, no qsort).
+ */
+static void sample_sorted(int *out, const int k, const int lo, const int hi, RandomState *rng) {
+    const int range = hi - lo + 1;
+    int count = 0;
+    for (int j = range - k; j < range; j++) {
+        int value = lo + random_int(rng, 0, j);
+        if (contains(out, count, value)) value = lo + j;
+        insert_sorted(out, count++, value);
+    }
+}
+
+/*
+ * Reconnects S0 S1 S2 S3 S4 as S0 S3 S2 S1 S4, where the cuts are sorted edge indices.
+ * Only positions (cuts[0], cuts[3]] are rewritten, tour[0] never moves.
+ */
+static double apply_double_bridge(int *tour, const int n, const double *costs, const int *cuts, KickWorkspace *ws) {
+    const int p1 = cuts[0], p2 = cuts[1], p3 = cuts[2], p4 = cuts[3];
+
+    const int a1 = tour[p1], a2 = tour[p1 + 1];
+    const int b1 = tour[p2], b2 = tour[p2 + 1];
+    const int c1 = tour[p3], c2 = tour[p3 + 1];
+    const int d1 = tour[p4], d2 = tour[p4 + 1];
+
+    const double delta = costs[a1 * n + c2] + costs[d1 * n + b2] + costs[c1 * n + a2] + costs[b1 * n + d2]
+                         - costs[a1 * n + a2] - costs[b1 * n + b2] - costs[c1 * n + c2] - costs[d1 * n + d2];
+
+    int *out = ws->segment;
+    int len = 0;
+    memcpy(out + len, tour + p3 + 1, (p4 - p3) * sizeof(int));
+    len += p4 - p3;
+    memcpy(out + len, tour + p2 + 1, (p3 - p2) * sizeof(int));
+    len += p3 - p2;
+    memcpy(out + len, tour + p1 + 1, (p2 - p1) * sizeof(int));
+    len += p2 - p1;
+    memcpy(tour + p1 + 1, out, len * sizeof(int));
+
+    track_positions(ws, tour, p1 + 1, p4);
+    return delta;
+}
+
+double kick_random_n_opt(int *tour, const int n, const double *costs, int k, KickWorkspace *ws, RandomState *rng) {
+    if (k > n) k = n;
+    if (k > ws->max_cuts) k = ws->max_cuts;
+
+    // k < 2 implies no change or invalid move structure for n-opt logic
+    if (k < 2) return 0.0;
+
+    sample_sorted(ws->cuts, k, 0, n - 1, rng);
+
+    const double delta = compute_n_opt_cost(k, tour, ws->cuts, costs, n);
+    compute_n_opt_move(k, tour, ws->cuts, n);
+
+    ws->positions_valid = false;
+    return delta;
+}
+
+double kick_double_bridge(int *tour, const int n, const double *costs, KickWorkspace *ws, RandomState *rng) {
+    if (n < 8) return 0.0;
+
+    const int window = n < KICK_MAX_SEGMENT ? n : KICK_MAX_SEGMENT;
+    const int start = random_int(rng, 0, n - window);
+    sample_sorted(ws->cuts, 4, start, start + window - 1, rng);
+
+    return apply_double_bridge(tour, n, costs, ws->cuts, ws);
+}
+
+double kick_segment_reversal(int *tour, const int n, const double *costs, KickWorkspace *ws, RandomState *rng) {
+    if (n < 4) return 0.0;
+
+    const int max_len = n - 1 < KICK_MAX_SEGMENT ? n - 1 : KICK_MAX_SEGMENT;
+    const int len = random_int(rng, 2, max_len);
+    const int i = random_int(rng, 1, n - len);
+    const int j = i + len - 1;
+
+    const int a = tour[i - 1], b = tour[i];
+    const int c = tour[j], d = tour[j + 1];
+    const double delta = costs[a * n + c] + costs[b * n + d] - costs[a * n + b] - costs[c * n + d];
+
+    reverse_array_int(tour, i, j);
+    track_positions(ws, tour, i, j);
+    return delta;
+}
+
+double kick_near_double_bridge(int *tour, const int n, const double *costs, KickWorkspace *ws, RandomState *rng) {
+    const int k = candidate_lists_get_k(ws->candidates);
+    if (!ws->candidates || n < 8 || k < 3)
+        return kick_double_bridge(tour, n, costs, ws, rng);
+
+    if (!ws->positions_valid) {
+        for (int i = 0; i < n; i++)
+            ws->position[tour[i]] = i;
+        ws->positions_valid = true;
+    }
+
+    int picked[3];
+    for (int attempt = 0; attempt < 4; attempt++) {
+        const int p = random_int(rng, 0, n - 1);
+        const int *near = candidate_lists_get(ws->candidates, tour[p]);
+
+        int count = 0;
+        ws->cuts[count++] = p;
+        sample_sorted(picked, 3, 0, k - 1, rng);
+        for (int q = 0; q < 3; q++) {
+            const int pos = ws->position[near[picked[q]]];
+            if (!contains(ws->cuts, count, pos))
+                insert_sorted(ws->cuts, count++, pos);
+        }
+
+        if (count == 4)
+            return apply_double_bridge(tour, n, costs, ws->cuts, ws);
+    }
+
+    return kick_double_bridge(tour, n, costs, ws, rng);
+}
+
+double kick_apply(const KickType type,
+                  int *tour,
+                  const int n,
+                  const double *costs,
+                  const int strength,
+                  KickWorkspace *ws,
+                  RandomState *rng) {
+    double delta = 0.0;
+    switch (type) {
+        case KICK_DOUBLE_BRIDGE:
+            for (int i = 0; i < (strength / 4 > 0 ? strength / 4 : 1); i++)
+                delta += kick_double_bridge(tour, n, costs, ws, rng);
+            return delta;
+        case KICK_SEGMENT_REVERSAL:
+            for (int i = 0; i < (strength / 2 > 0 ? strength / 2 : 1); i++)
+                delta += kick_segment_reversal(tour, n, costs, ws, rng);
+            return delta;
+        case KICK_NEAR_DOUBLE_BRIDGE:
+            for (int i = 0; i < (strength / 4 > 0 ? strength / 4 : 1); i++)
+                delta += kick_near_double_bridge(tour, n, costs, ws, rng);
+            return delta;
+        case KICK_RANDOM_N_OPT:
+        default:
+            return kick_random_n_opt(tour, n, costs, strength, ws, rng);
+    }
+}
+
+const char *kick_type_to_string(const KickType type) {
+    switch (type) {
+        case KICK_DOUBLE_BRIDGE: return "double-bridge";
+        case KICK_SEGMENT_REVERSAL: return "segment";
+        case KICK_NEAR_DOUBLE_BRIDGE: return "near-double-bridge";
+        case KICK_RANDOM_N_OPT:
+        default: return "nopt";
+    }
+}
@@ -1,13 +1,19 @@
+#include "local_search.h"
 #include "constants.h"
 #include "c_util.h"
 #include "logger.h"
 #include <stdbool.h>
 #include "time_limiter.h"
+#include "tour_hash.h"
 
-double two_opt(int *tour,
-               const int number_of_nodes,
-               const double *edge_cost_array,
-               const TimeLimiter timer) {
+// Called once per outer iteration by every 2-opt of the thread (e.g. once per GA child): the stride stays calibrated
+static _Thread_local DeadlinePacer two_opt_pacer;
+
+static double two_opt_run(int *tour,
+                          const int number_of_nodes,
+                          const double *edge_cost_array,
+                          const TimeLimiter timer,
+                          uint64_t *hash) {
     double cost_improvement = 0;
     bool improved = true;
 
@@ -15,7 +21,7 @@ double two_opt(int *tour,
         improved = false;
 
         for (int i = 1; i < number_of_nodes - 1; i++) {
-            if (time_limiter_is_over(&timer)) {
+            if (time_limiter_poll(&timer, &two_opt_pacer)) {
                 if_verbose(VERBOSE_DEBUG, "  2-Opt: Time limit reached during optimization. Total improvement: %lf\n",
                            cost_improvement);
                 return cost_improvement;
@@ -36,6 +42,7 @@ double two_opt(int *tour,
 
                 if (delta < -EPSILON) {
                     cost_improvement += delta;
+                    if (hash) *hash = tour_hash_two_opt(*hash, a, b, c, d);
                     reverse_array_int(tour, i, j);
                     improved = true;
                     break; // Break inner loop
@@ -49,3 +56,18 @@ double two_opt(int *tour,
     if_verbose(VERBOSE_ALL, "  2-Opt: Finished local search. Total improvement: %lf\n", cost_improvement);
     return cost_improvement;
 }
+
+double two_opt(int *tour,
+               const int number_of_nodes,
+               const double *edge_cost_array,
+               const TimeLimiter timer) {
+    return two_opt_run(tour, number_of_nodes, edge_cost_array, timer, NULL);
+}
+
+double two_opt_hashed(int *tour,
+                      const int number_of_nodes,
+                      const double *edge_cost_array,
+                      const TimeLimiter timer,
+                      uint64_t *hash) {
+    return two_opt_run(tour, number_of_nodes, edge_cost_array, timer, hash);
+}
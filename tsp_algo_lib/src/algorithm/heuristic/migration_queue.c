@@ -0,0 +1,60 @@
+#include "migration_queue.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+#include "c_util.h"
+
+struct MigrationQueue {
+    int capacity;
+    int stride; // n + 1
+    int *tours;
+    double *costs;
+    atomic_size_t head; // next slot to pop, written by the consumer only
+    atomic_size_t tail; // next slot to push, written by the producer only
+};
+
+MigrationQueue *migration_queue_create(const int capacity, const int n) {
+    MigrationQueue *queue = tsp_malloc(sizeof(MigrationQueue));
+    queue->capacity = capacity > 0 ? capacity : 1;
+    queue->stride = n + 1;
+    queue->tours = tsp_malloc((size_t) queue->capacity * queue->stride * sizeof(int));
+    queue->costs = tsp_malloc(queue->capacity * sizeof(double));
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    return queue;
+}
+
+void migration_queue_destroy(MigrationQueue *queue) {
+    if (!queue) return;
+    tsp_free(queue->tours);
+    tsp_free(queue->costs);
+    tsp_free(queue);
+}
+
+bool migration_queue_push(MigrationQueue *queue, const int *tour, const double cost) {
+    const size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    const size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    if (tail - head == (size_t) queue->capacity) return false;
+
+    const size_t slot = tail % queue->capacity;
+    memcpy(queue->tours + slot * queue->stride, tour, queue->stride * sizeof(int));
+    queue->costs[slot] = cost;
+
+    // Publishes the slot contents to the consumer
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool migration_queue_pop(MigrationQueue *queue, int *out_tour, double *out_cost) {
+    const size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    const size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    if (head == tail) return false;
+
+    const size_t slot = head % queue->capacity;
+    memcpy(out_tour, queue->tours + slot * queue->stride, queue->stride * sizeof(int));
+    *out_cost = queue->costs[slot];
+
+    // Hands the slot back to the producer
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return true;
+}
@@ -0,0 +1,103 @@
+#include "path_relinking.h"
+#include <string.h>
+#include "c_util.h"
+#include "constants.h"
+
+struct PathRelinkWorkspace {
+    int n;
+    int *tour;
+    int *position;
+    int *moves; // (i, j) pairs of the reversals applied
+    double *step_costs;
+};
+
+PathRelinkWorkspace *path_relink_workspace_create(const int n) {
+    PathRelinkWorkspace *ws = tsp_malloc(sizeof(PathRelinkWorkspace));
+    ws->n = n;
+    ws->tour = tsp_malloc((n + 1) * sizeof(int));
+    ws->position = tsp_malloc(n * sizeof(int));
+    ws->moves = tsp_malloc(2 * n * sizeof(int));
+    ws->step_costs = tsp_malloc(n * sizeof(double));
+    return ws;
+}
+
+void path_relink_workspace_destroy(PathRelinkWorkspace *ws) {
+    if (!ws) return;
+    tsp_free(ws->tour);
+    tsp_free(ws->position);
+    tsp_free(ws->moves);
+    tsp_free(ws->step_costs);
+    tsp_free(ws);
+}
+
+bool path_relink(const int *from,
+                 const double from_cost,
+                 const int *target,
+                 const int n,
+                 const double *costs,
+                 int *out_tour,
+                 double *out_cost,
+                 PathRelinkWorkspace *ws) {
+    if (n < 5) return false;
+    int *cur = ws->tour;
+
+    // Align start node and orientation with the target so that matching prefixes are meaningful
+    int shift = 0;
+    while (from[shift] != target[0]) shift++;
+    for (int i = 0; i < n; i++)
+        cur[i] = from[(shift + i) % n];
+    if (cur[1] != target[1] && cur[n - 1] == target[1])
+        reverse_array_int(cur, 1, n - 1);
+    cur[n] = cur[0];
+
+    for (int i = 0; i < n; i++)
+        ws->position[cur[i]] = i;
+
+    // Each reversal fixes position i and introduces the target edge (target[i-1], target[i])
+    double cost = from_cost;
+    int steps = 0;
+    for (int i = 1; i < n - 1; i++) {
+        if (cur[i] == target[i]) continue;
+
+        const int j = ws->position[target[i]];
+        const int a = cur[i - 1], b = cur[i];
+        const int c = cur[j], d = cur[j + 1];
+        cost += costs[a * n + c] + costs[b * n + d] - costs[a * n + b] - costs[c * n + d];
+
+        reverse_array_int(cur, i, j);
+        for (int k = i; k <= j; k++)
+            ws->position[cur[k]] = k;
+
+        ws->moves[2 * steps] = i;
+        ws->moves[2 * steps + 1] = j;
+        ws->step_costs[steps] = cost;
+        steps++;
+    }
+
+    // The last step always lands on the target itself. Tours right next to either endpoint
+    // would fall back into the same local optimum, so a margin of the path is skipped.
+    const int margin = steps / PATH_RELINK_MARGIN_DIVISOR;
+    const int first = margin, last = steps - 2 - margin;
+    if (last < first) return false;
+
+    int best = first;
+    for (int s = first + 1; s <= last; s++)
+        if (ws->step_costs[s] < ws->step_costs[best]) best = s;
+
+    // Reversals are self-inverse: roll back to the best intermediate
+    for (int s = steps - 1; s > best; s--)
+        reverse_array_int(cur, ws->moves[2 * s], ws->moves[2 * s + 1]);
+
+    memcpy(out_tour, cur, (n + 1) * sizeof(int));
+    *out_cost = ws->step_costs[best];
+    return true;
+}
+
+const char *relinking_mode_to_string(const RelinkingMode mode) {
+    switch (mode) {
+        case RELINK_FORWARD: return "forward";
+        case RELINK_BOTH: return "both";
+        case RELINK_BACKWARD:
+        default: return "backward";
+    }
+}
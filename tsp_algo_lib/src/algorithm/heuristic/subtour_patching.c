@@ -0,0 +1,369 @@
+#include "subtour_patching.h"
+#include <float.h>
+#include <string.h>
+#include "c_util.h"
+
+// Moves must gain more than this to be applied (guards against cycling on rounding noise)
+#define PATCH_EPS 1e-9
+// Longest segment moved by Or-opt
+#define OR_OPT_MAX_SEGMENT 3
+
+struct SubtourPatcher {
+    int n;
+    int *comp;
+    int *comp_size;
+    int *comp_rep;
+    int *members;
+    int *pos; // position of every node in the tour being improved
+    int *scratch; // rebuilt tour of an Or-opt move
+    int *queue; // circular queue of the nodes to examine
+    unsigned char *queued;
+};
+
+SubtourPatcher *subtour_patcher_create(const int n) {
+    SubtourPatcher *p = tsp_malloc(sizeof(SubtourPatcher));
+    const int size = n > 0 ? n : 1;
+    p->n = n;
+    p->comp = tsp_malloc(size * sizeof(int));
+    p->comp_size = tsp_malloc(size * sizeof(int));
+    p->comp_rep = tsp_malloc(size * sizeof(int));
+    p->members = tsp_malloc(size * sizeof(int));
+    p->pos = tsp_malloc(size * sizeof(int));
+    p->scratch = tsp_malloc(size * sizeof(int));
+    p->queue = tsp_malloc(size * sizeof(int));
+    p->queued = tsp_malloc(size * sizeof(unsigned char));
+    return p;
+}
+
+void subtour_patcher_destroy(SubtourPatcher *patcher) {
+    if (!patcher) return;
+    tsp_free(patcher->comp);
+    tsp_free(patcher->comp_size);
+    tsp_free(patcher->comp_rep);
+    tsp_free(patcher->members);
+    tsp_free(patcher->pos);
+    tsp_free(patcher->scratch);
+    tsp_free(patcher->queue);
+    tsp_free(patcher->queued);
+    tsp_free(patcher);
+}
+
+bool subtour_adjacency_from_x(const double *x_star, const int n, int *adj) {
+    for (int v = 0; v < 2 * n; v++) adj[v] = -1;
+
+    int idx = 0; // xpos(i, j, n) for j > i, in increasing order
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++, idx++) {
+            if (x_star[idx] <= 0.5) continue;
+            if (adj[2 * i + 1] != -1 || adj[2 * j + 1] != -1) return false;
+            adj[adj[2 * i] == -1 ? 2 * i : 2 * i + 1] = j;
+            adj[adj[2 * j] == -1 ? 2 * j : 2 * j + 1] = i;
+        }
+    }
+    for (int v = 0; v < n; v++)
+        if (adj[2 * v + 1] == -1) return false;
+    return true;
+}
+
+static void replace_neighbor(int *adj, const int node, const int old_neighbor, const int new_neighbor) {
+    if (adj[2 * node] == old_neighbor) adj[2 * node] = new_neighbor;
+    else adj[2 * node + 1] = new_neighbor;
+}
+
+/*
+ * Labels the subtours of the adjacency. Returns their number.
+ */
+static int label_subtours(SubtourPatcher *p, const int *adj) {
+    const int n = p->n;
+    for (int v = 0; v < n; v++) p->comp[v] = -1;
+
+    int count = 0;
+    for (int v = 0; v < n; v++) {
+        if (p->comp[v] >= 0) continue;
+        int prev = -1, cur = v, size = 0;
+        do {
+            p->comp[cur] = count;
+            size++;
+            const int next = adj[2 * cur] != prev ? adj[2 * cur] : adj[2 * cur + 1];
+            prev = cur;
+            cur = next;
+        } while (cur != v);
+        p->comp_size[count] = size;
+        p->comp_rep[count] = v;
+        count++;
+    }
+    return count;
+}
+
+static int collect_members(SubtourPatcher *p, const int *adj, const int rep) {
+    int prev = -1, cur = rep, size = 0;
+    do {
+        p->members[size++] = cur;
+        const int next = adj[2 * cur] != prev ? adj[2 * cur] : adj[2 * cur + 1];
+        prev = cur;
+        cur = next;
+    } while (cur != rep);
+    return size;
+}
+
+typedef struct {
+    double delta;
+    int u, u2, v, v2;
+    bool crossed; // connect (u, v2) and (u2, v) instead of (u, v) and (u2, v2)
+} MergeMove;
+
+static void evaluate_merge(const int *adj, const double *costs, const int n,
+                           const int u, const int v, MergeMove *best) {
+    for (int s = 0; s < 2; s++) {
+        const int u2 = adj[2 * u + s];
+        const double removed_u = costs[u * n + u2];
+        for (int t = 0; t < 2; t++) {
+            const int v2 = adj[2 * v + t];
+            const double removed = removed_u + costs[v * n + v2];
+            const double straight = costs[u * n + v] + costs[u2 * n + v2] - removed;
+            const double crossed = costs[u * n + v2] + costs[u2 * n + v] - removed;
+            if (straight < best->delta) *best = (MergeMove){straight, u, u2, v, v2, false};
+            if (crossed < best->delta) *best = (MergeMove){crossed, u, u2, v, v2, true};
+        }
+    }
+}
+
+double subtour_patcher_merge(SubtourPatcher *patcher, int *adj, const double *costs,
+                             const CandidateLists *candidates) {
+    SubtourPatcher *p = patcher;
+    const int n = p->n;
+    const int k = candidate_lists_get_k(candidates);
+    const int labels = label_subtours(p, adj);
+    double total = 0.0;
+
+    for (int subtours = labels; subtours > 1; subtours--) {
+        int smallest = -1;
+        for (int c = 0; c < labels; c++) {
+            if (p->comp_size[c] == 0) continue;
+            if (smallest < 0 || p->comp_size[c] < p->comp_size[smallest]) smallest = c;
+        }
+
+        const int size = collect_members(p, adj, p->comp_rep[smallest]);
+        MergeMove best = {DBL_MAX, -1, -1, -1, -1, false};
+
+        for (int i = 0; i < size; i++) {
+            const int u = p->members[i];
+            const int *neighbors = k > 0 ? candidate_lists_get(candidates, u) : NULL;
+            for (int j = 0; j < k; j++)
+                if (p->comp[neighbors[j]] != smallest)
+                    evaluate_merge(adj, costs, n, u, neighbors[j], &best);
+        }
+        if (best.u < 0) {
+            // No candidate leaves the subtour: scan every outside node
+            for (int i = 0; i < size; i++)
+                for (int v = 0; v < n; v++)
+                    if (p->comp[v] != smallest)
+                        evaluate_merge(adj, costs, n, p->members[i], v, &best);
+        }
+
+        const int target = p->comp[best.v];
+        const int u_to = best.crossed ? best.v2 : best.v;
+        const int u2_to = best.crossed ? best.v : best.v2;
+        replace_neighbor(adj, best.u, best.u2, u_to);
+        replace_neighbor(adj, best.u2, best.u, u2_to);
+        replace_neighbor(adj, best.v, best.v2, best.crossed ? best.u2 : best.u);
+        replace_neighbor(adj, best.v2, best.v, best.crossed ? best.u : best.u2);
+
+        for (int i = 0; i < size; i++) p->comp[p->members[i]] = target;
+        p->comp_size[target] += size;
+        p->comp_size[smallest] = 0;
+        total += best.delta;
+    }
+    return total;
+}
+
+void subtour_adjacency_to_tour(const int *adj, const int n, int *tour) {
+    int prev = -1, cur = 0;
+    for (int i = 0; i < n; i++) {
+        tour[i] = cur;
+        const int next = adj[2 * cur] != prev ? adj[2 * cur] : adj[2 * cur + 1];
+        prev = cur;
+        cur = next;
+    }
+    tour[n] = tour[0];
+}
+
+static int succ(const SubtourPatcher *p, const int *tour, const int v) {
+    return tour[p->pos[v] + 1 == p->n ? 0 : p->pos[v] + 1];
+}
+
+static int pred(const SubtourPatcher *p, const int *tour, const int v) {
+    return tour[p->pos[v] == 0 ? p->n - 1 : p->pos[v] - 1];
+}
+
+/*
+ * Reverses the cyclic path from position i to position j (forward). The complement is reversed
+ * instead when shorter: same cycle, opposite orientation.
+ */
+static void reverse_path(SubtourPatcher *p, int *tour, int i, int j) {
+    const int n = p->n;
+    int len = (j - i + n) % n + 1;
+    if (2 * len > n) {
+        const int start = (j + 1) % n;
+        j = (i - 1 + n) % n;
+        i = start;
+        len = n - len;
+    }
+    for (int s = 0; s < len / 2; s++) {
+        const int a = (i + s) % n, b = (j - s + n) % n;
+        swap_int(&tour[a], &tour[b]);
+        p->pos[tour[a]] = a;
+        p->pos[tour[b]] = b;
+    }
+}
+
+static void enqueue(SubtourPatcher *p, const int head, int *count, const int v) {
+    if (p->queued[v]) return;
+    p->queued[v] = 1;
+    p->queue[(head + *count) % p->n] = v;
+    (*count)++;
+}
+
+/*
+ * First-improvement 2-opt from node a over its candidates, in both tour directions. Applies the first
+ * improving move and returns its delta (0 if none); touched receives the four endpoints.
+ */
+static double try_two_opt(SubtourPatcher *p, int *tour, const double *costs, const CandidateLists *candidates,
+                          const int a, int *touched) {
+    const int n = p->n;
+    const int k = candidate_lists_get_k(candidates);
+    const int *neighbors = candidate_lists_get(candidates, a);
+
+    for (int dir = 0; dir < 2; dir++) {
+        const int b = dir == 0 ? succ(p, tour, a) : pred(p, tour, a);
+        const double d_ab = costs[a * n + b];
+        for (int j = 0; j < k; j++) {
+            const int c = neighbors[j];
+            const double d_ac = costs[a * n + c];
+            if (d_ac >= d_ab) break;
+            const int d = dir == 0 ? succ(p, tour, c) : pred(p, tour, c);
+            if (c == b || d == a) continue;
+
+            const double delta = d_ac + costs[b * n + d] - d_ab - costs[c * n + d];
+            if (delta >= -PATCH_EPS) continue;
+
+            // a b ... c d becomes a c ... b d (mirrored when walking backwards)
+            if (dir == 0) reverse_path(p, tour, p->pos[b], p->pos[c]);
+            else reverse_path(p, tour, p->pos[a], p->pos[d]);
+            touched[0] = a;
+            touched[1] = b;
+            touched[2] = c;
+            touched[3] = d;
+            return delta;
+        }
+    }
+    return 0.0;
+}
+
+/*
+ * Moves the segment of len nodes starting at s1 between x and y = succ(x), reversed if asked.
+ * The tour is rebuilt from the node after the segment: O(n), but moves are rare next to the scans.
+ */
+static void move_segment(SubtourPatcher *p, int *tour, const int s1, const int len,
+                         const int x, const bool reversed) {
+    const int n = p->n;
+    const int start = p->pos[s1];
+    const int after = (start + len) % n;
+    int m = 0;
+    for (int t = 0; t < n - len; t++) {
+        const int v = tour[(after + t) % n];
+        p->scratch[m++] = v;
+        if (v != x) continue;
+        for (int s = 0; s < len; s++)
+            p->scratch[m++] = tour[(start + (reversed ? len - 1 - s : s)) % n];
+    }
+    memcpy(tour, p->scratch, n * sizeof(int));
+    for (int i = 0; i < n; i++) p->pos[tour[i]] = i;
+}
+
+/*
+ * Or-opt of the segments of 1 to OR_OPT_MAX_SEGMENT nodes starting at s1: the segment is reinserted next
+ * to a candidate of one of its endpoints, in the cheaper orientation. Applies the first improving move.
+ */
+static double try_or_opt(SubtourPatcher *p, int *tour, const double *costs, const CandidateLists *candidates,
+                         const int s1, int *touched) {
+    const int n = p->n;
+    const int k = candidate_lists_get_k(candidates);
+
+    for (int len = 1; len <= OR_OPT_MAX_SEGMENT; len++) {
+        const int start = p->pos[s1];
+        const int s2 = tour[(start + len - 1) % n];
+        const int prev = pred(p, tour, s1), next = succ(p, tour, s2);
+        const double gain = costs[prev * n + s1] + costs[s2 * n + next] - costs[prev * n + next];
+        if (gain <= PATCH_EPS) continue;
+
+        for (int end = 0; end < 2; end++) {
+            const int e = end == 0 ? s1 : s2;
+            const int *neighbors = candidate_lists_get(candidates, e);
+            for (int j = 0; j < k; j++) {
+                const int c = neighbors[j];
+                if (costs[e * n + c] >= gain) break;
+                if ((p->pos[c] - start + n) % n < len) continue;
+
+                for (int side = 0; side < 2; side++) {
+                    const int x = side == 0 ? c : pred(p, tour, c);
+                    const int y = succ(p, tour, x);
+                    if ((p->pos[x] - start + n) % n < len || (p->pos[y] - start + n) % n < len) continue;
+
+                    const double forward = costs[x * n + s1] + costs[s2 * n + y];
+                    const double backward = costs[x * n + s2] + costs[s1 * n + y];
+                    const bool reversed = backward < forward;
+                    const double delta = (reversed ? backward : forward) - costs[x * n + y] - gain;
+                    if (delta >= -PATCH_EPS) continue;
+
+                    move_segment(p, tour, s1, len, x, reversed);
+                    touched[0] = prev;
+                    touched[1] = next;
+                    touched[2] = x;
+                    touched[3] = y;
+                    touched[4] = s1;
+                    touched[5] = s2;
+                    return delta;
+                }
+            }
+        }
+    }
+    return 0.0;
+}
+
+double subtour_patcher_improve(SubtourPatcher *patcher, int *tour, const double *costs,
+                               const CandidateLists *candidates) {
+    SubtourPatcher *p = patcher;
+    const int n = p->n;
+    if (n < 8 || candidate_lists_get_k(candidates) == 0) return 0.0;
+
+    // Every node starts in the queue; a node leaves it when no move around it improves
+    for (int i = 0; i < n; i++) {
+        p->pos[tour[i]] = i;
+        p->queue[i] = tour[i];
+        p->queued[tour[i]] = 1;
+    }
+    int head = 0, count = n;
+    double total = 0.0;
+    int touched[6];
+
+    while (count > 0) {
+        const int a = p->queue[head];
+        head = (head + 1) % n;
+        count--;
+        p->queued[a] = 0;
+
+        int num_touched = 4;
+        double delta = try_two_opt(p, tour, costs, candidates, a, touched);
+        if (delta == 0.0) {
+            delta = try_or_opt(p, tour, costs, candidates, a, touched);
+            num_touched = 6;
+        }
+        if (delta == 0.0) continue;
+
+        total += delta;
+        for (int t = 0; t < num_touched; t++) enqueue(p, head, &count, touched[t]);
+    }
+    tour[n] = tour[0];
+    return total;
+}
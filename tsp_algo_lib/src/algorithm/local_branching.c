@@ -1,6 +1,6 @@
 #include "local_branching.h"
 #include "matheuristic_utils.h"
-#include "cplex_solver_wrapper.h"
+#include "mip_backend.h"
 #include "time_limiter.h"
 #include "logger.h"
 #include "c_util.h"
@@ -23,6 +23,7 @@ static void run_local_branching(const TspInstance *inst,
 
     TimeLimiter timer = time_limiter_create(cfg->time_limit);
     time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(sol));
 
     double heuristic_time = cfg->time_limit * cfg->heuristic_time_ratio;
     if (heuristic_time < 2.0) heuristic_time = 2.0;
@@ -36,51 +37,61 @@ static void run_local_branching(const TspInstance *inst,
     };
     matheuristic_run_warm_start(&ws_params, inst, sol, rec);
 
+    const MipBackend *mip = mip_backend_default();
+    if (!mip) {
+        if_verbose(VERBOSE_INFO, "[ERROR] Local branching sub-MIPs unavailable (no MIP solver)\n");
+        return;
+    }
     if (time_limiter_is_over(&timer)) return;
 
-#ifdef ENABLE_CPLEX
     int *current_tour = tsp_malloc((n + 1) * sizeof(int));
 
     tsp_solution_get_tour(sol, current_tour);
     double current_cost = tsp_solution_get_cost(sol);
 
+    // One model for the whole run: moving the neighborhood only rewrites the local branching row,
+    // and the SECs separated so far stay in the model as rows
+    void *model = mip->create(inst);
+    if (!model || mip->build_model(model, inst) != 0) {
+        if (model) mip->destroy(model);
+        tsp_free(current_tour);
+        return;
+    }
+    mip->install_sec_callback(model, inst);
+    mip->keep_sec_cuts(model, true);
+
     int iter = 0;
-    bool improved = true;
+    int k = cfg->k;
+    // The center is cut off by a reverse branching row once its neighborhood has been explored
+    bool center_feasible = true;
 
-    while (improved && !time_limiter_is_over(&timer)) {
-        improved = false;
+    while (k < n && !time_limiter_is_over(&timer)) {
         iter++;
 
-        CplexSolverContext *ctx = cplex_solver_create(inst);
-        if (!ctx) break;
-
-        if (cplex_solver_build_base_model(ctx, inst) != 0) {
-            cplex_solver_destroy(ctx);
-            break;
-        }
-
-        cplex_solver_add_mip_start(ctx, n, current_tour);
-        cplex_solver_add_local_branching_constraint(ctx, n, current_tour, cfg->k);
-        cplex_solver_install_sec_callback(ctx, inst);
+        if (mip->set_local_branching(model, n, current_tour, k) != 0) break;
+        mip->clear_mip_starts(model);
+        if (center_feasible) mip->add_mip_start(model, n, current_tour);
 
         double remaining = time_limiter_get_remaining(&timer);
-        cplex_solver_set_time_limit(ctx, remaining);
+        mip->set_time_limit(model, remaining);
 
-        // Track CPLEX time
+        // Track solver time
         double start_opt = time_limiter_get_remaining(&timer);
-        int status = cplex_solver_optimize(ctx);
+        int status = mip->optimize(model);
         double end_opt = time_limiter_get_remaining(&timer);
 
-        if_verbose(VERBOSE_DEBUG, "LB [Iter %d]: CPLEX finished in %.3fs (Limit: %.2fs)\n",
-                   iter, (start_opt - end_opt), remaining);
+        int pooled = 0;
+        mip->flush_sec_pool(model, &pooled);
+        if_verbose(VERBOSE_DEBUG, "LB [Iter %d]: %s finished in %.3fs (Limit: %.2fs, k=%d), %d SECs kept\n",
+                   iter, mip->name, (start_opt - end_opt), remaining, k, pooled);
 
-        if (status == 0 && cplex_solver_has_solution(ctx)) {
+        bool improved = false;
+        if (status == 0 && mip->has_solution(model)) {
             double cost = 0.0;
-            cplex_solver_extract_solution(ctx, &cost);
+            mip->extract_solution(model, &cost);
 
             if (cost < current_cost - 1e-6) {
-                const double *x = cplex_solver_get_x(ctx);
-                cplex_solver_reconstruct_tour(n, x, current_tour);
+                mip->extract_tour(model, n, current_tour);
                 tsp_solution_update_if_better(sol, current_tour, cost);
                 cost_recorder_add(rec, cost);
                 current_cost = cost;
@@ -91,13 +102,24 @@ static void run_local_branching(const TspInstance *inst,
                            iter, cost, current_cost);
             }
         } else {
-             if_verbose(VERBOSE_DEBUG, "LB [Iter %d]: No solution or CPLEX error.\n", iter);
+             if_verbose(VERBOSE_DEBUG, "LB [Iter %d]: No solution or %s error.\n", iter, mip->name);
         }
 
-        cplex_solver_destroy(ctx);
+        if (improved) {
+            // Recenter on the new tour with the original radius
+            k = cfg->k;
+            center_feasible = true;
+            continue;
+        }
+        // A neighborhood proven empty of improvements is cut off, and the search moves to the next ring
+        if (status != 0 || !mip->is_optimal(model)) break;
+        if (mip->add_reverse_branching(model, n, current_tour, k) != 0) break;
+        center_feasible = false;
+        k += cfg->k;
     }
+
+    mip->destroy(model);
     tsp_free(current_tour);
-#endif
 }
 
 TspAlgorithm local_branching_create(LocalBranchingConfig config) {
@@ -18,6 +18,7 @@ typedef struct {
 
     TspSolution *solution;
     CostRecorder *local_recorder;
+    CancelToken *expired; // shared by the workers: the first one out of time stops the others
 } NNWorkerArgs;
 
 static void *nn_worker(const void *arg) {
@@ -25,6 +26,9 @@ static void *nn_worker(const void *arg) {
 
     TimeLimiter timer = time_limiter_create(args->time_limit);
     time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(args->solution));
+    time_limiter_share_expiry(&timer, args->expired);
+    DeadlinePacer pacer = {0};
 
     int *tour = tsp_malloc((args->num_nodes + 1) * sizeof(int));
 
@@ -36,7 +40,7 @@ static void *nn_worker(const void *arg) {
                              : (args->thread_id + 1) * chunk_size;
 
     for (int s = start_node; s < end_node; s++) {
-        if (time_limiter_is_over(&timer)) break;
+        if (time_limiter_poll(&timer, &pacer)) break;
 
         double cost;
 
@@ -77,10 +81,11 @@ static void run_nn(const TspInstance *instance,
 
     pthread_t *threads = tsp_malloc(num_threads * sizeof(pthread_t));
     NNWorkerArgs *args = tsp_malloc(num_threads * sizeof(NNWorkerArgs));
+    CancelToken *expired = cancel_token_create();
 
     for (int i = 0; i < num_threads; i++) {
         // Create a local recorder for each thread to avoid contention
-        CostRecorder *local_rec = cost_recorder_create(n / num_threads + 16);
+        CostRecorder *local_rec = cost_recorder_create_child(recorder, i);
 
         args[i] = (NNWorkerArgs){
             .thread_id = i,
@@ -89,7 +94,8 @@ static void run_nn(const TspInstance *instance,
             .costs = costs,
             .time_limit = cfg->time_limit,
             .solution = solution,
-            .local_recorder = local_rec
+            .local_recorder = local_rec,
+            .expired = expired
         };
 
         if (pthread_create(&threads[i], NULL, (void *) nn_worker, &args[i]) != 0) {
@@ -111,6 +117,7 @@ static void run_nn(const TspInstance *instance,
         }
     }
 
+    cancel_token_destroy(expired);
     tsp_free(args);
     tsp_free(threads);
 }
@@ -33,6 +33,7 @@ static void run_tabu(const TspInstance *instance,
 
     TimeLimiter timer = time_limiter_create(cfg->time_limit);
     time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(solution));
 
     int *current_tour = tsp_malloc((n + 1) * sizeof(int));
 
@@ -113,12 +114,21 @@ static void run_tabu(const TspInstance *instance,
             best_cost = current_cost;
             memcpy(best_tour, current_tour, (n + 1) * sizeof(int));
             no_improv = 0;
+            tsp_solution_update_if_better(solution, best_tour, best_cost);
 
             if_verbose(VERBOSE_DEBUG,
                        "\tTabu: new global best %.2f at iter %d\n",
                        best_cost, iteration);
         } else {
             no_improv++;
+
+            /* A better shared incumbent (found by a concurrent algorithm) becomes the new trajectory */
+            if (tsp_solution_fetch_if_better(solution, best_tour, &best_cost)) {
+                if_verbose(VERBOSE_DEBUG, "\tTabu: restarting from shared incumbent %.2f\n", best_cost);
+                memcpy(current_tour, best_tour, (n + 1) * sizeof(int));
+                current_cost = best_cost;
+                no_improv = 0;
+            }
         }
 
         cost_recorder_add(recorder, current_cost);
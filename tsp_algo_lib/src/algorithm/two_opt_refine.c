@@ -0,0 +1,52 @@
+#include "two_opt_refine.h"
+#include "local_search.h"
+#include "time_limiter.h"
+#include "c_util.h"
+#include "logger.h"
+
+static void run_two_opt(const TspInstance *instance,
+                        TspSolution *solution,
+                        const void *config_void,
+                        CostRecorder *recorder) {
+    const TwoOptConfig *cfg = config_void;
+    const int n = tsp_instance_get_num_nodes(instance);
+    const double *costs = tsp_instance_get_cost_matrix(instance);
+
+    if_verbose(VERBOSE_INFO, "2-Opt: Time=%.2f\n", cfg->time_limit);
+
+    TimeLimiter timer = time_limiter_create(cfg->time_limit);
+    time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(solution));
+
+    int *tour = tsp_malloc((n + 1) * sizeof(int));
+    tsp_solution_get_tour(solution, tour);
+    double cost = tsp_solution_get_cost(solution);
+    cost_recorder_add(recorder, cost);
+
+    cost += two_opt(tour, n, costs, timer);
+    cost_recorder_add(recorder, cost);
+
+    if (tsp_solution_update_if_better(solution, tour, cost)) {
+        if_verbose(VERBOSE_DEBUG, "  2-Opt: Solution improved to cost=%.2f\n", cost);
+    }
+
+    tsp_free(tour);
+}
+
+static void free_two_opt_config(void *config) {
+    tsp_free(config);
+}
+
+TspAlgorithm two_opt_create(const TwoOptConfig config) {
+    TwoOptConfig *cfg_copy = tsp_malloc(sizeof(TwoOptConfig));
+
+    *cfg_copy = config;
+
+    return (TspAlgorithm){
+        .name = "2-Opt",
+        .config = cfg_copy,
+        .run = run_two_opt,
+        .free_config = free_two_opt_config,
+        .clone_config = NULL // Deterministic descent: clones would all find the same tour
+    };
+}
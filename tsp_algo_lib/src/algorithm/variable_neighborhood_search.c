@@ -8,52 +8,7 @@
 #include "constants.h"
 #include "local_search.h"
 #include "random.h"
-#include "tsp_tour.h"
-
-// Helper function for qsort to sort edge indices
-static int compare_ints(const void *a, const void *b) {
-    return (*(int *) a - *(int *) b);
-}
-
-static double vns_kick(int *tour, int n, const double *costs, int k_opt, RandomState *rng) {
-    // Safety check: cannot cut more edges than nodes available.
-    if (k_opt > n) k_opt = n;
-
-    // k < 2 implies no change or invalid move structure for n-opt logic
-    if (k_opt < 2) return 0.0;
-
-    int *edges = tsp_malloc(k_opt * sizeof(int));
-
-
-    // we use a partial Fisher-Yates shuffle to pick exactly k unique indices from [0, n-1].
-    int *candidates = tsp_malloc(n * sizeof(int));
-    for (int i = 0; i < n; i++) {
-        candidates[i] = i;
-    }
-
-    // Pick k_opt random unique indices
-    for (int i = 0; i < k_opt; i++) {
-        int j = random_int(rng, i, n - 1);
-
-        // Swap candidates[i] and candidates[j]
-        int temp = candidates[i];
-        candidates[i] = candidates[j];
-        candidates[j] = temp;
-
-        edges[i] = candidates[i];
-    }
-    tsp_free(candidates);
-
-    // The N-Opt move logic requires indices to be sorted to handle segments correctly
-    qsort(edges, k_opt, sizeof(int), compare_ints);
-
-    // Calculate delta and perform the move
-    const double delta = compute_n_opt_cost(k_opt, tour, edges, costs, n);
-    compute_n_opt_move(k_opt, tour, edges, n);
-
-    tsp_free(edges);
-    return delta;
-}
+#include "kick.h"
 
 static void run_vns(const TspInstance *instance,
                     TspSolution *solution,
@@ -66,12 +21,19 @@ static void run_vns(const TspInstance *instance,
     const double *costs = tsp_instance_get_cost_matrix(instance);
 
     if_verbose(VERBOSE_INFO,
-               "VNS: k=[%d..%d], kicks=%d, stagnation=%d, time=%.2f\n",
-               cfg->min_k, cfg->max_k, cfg->kick_repetition,
+               "VNS: k=[%d..%d], kicks=%d (%s), stagnation=%d, time=%.2f\n",
+               cfg->min_k, cfg->max_k, cfg->kick_repetition, kick_type_to_string(cfg->kick_type),
                cfg->max_stagnation, cfg->time_limit);
 
+    // Per-run (hence per-thread) scratch: the kick loop below never allocates
+    KickWorkspace *kick_ws = kick_workspace_create(n, cfg->max_k,
+                                                   cfg->kick_type == KICK_NEAR_DOUBLE_BRIDGE
+                                                       ? tsp_instance_get_candidate_lists(instance)
+                                                       : NULL);
+
     TimeLimiter timer = time_limiter_create(cfg->time_limit);
     time_limiter_start(&timer);
+    time_limiter_bind_cancel(&timer, tsp_solution_get_cancel_token(solution));
 
     int *current_tour = tsp_malloc((n + 1) * sizeof(int));
 
@@ -89,11 +51,12 @@ static void run_vns(const TspInstance *instance,
 
     while (!time_limiter_is_over(&timer) && stagnation < cfg->max_stagnation) {
         for (int i = 0; i < cfg->kick_repetition; i++) {
-            current_cost += vns_kick(current_tour, n, costs, current_k, &rng);
+            current_cost += kick_apply(cfg->kick_type, current_tour, n, costs, current_k, kick_ws, &rng);
         }
 
         // Local Search after kick
         current_cost += two_opt(current_tour, n, costs, timer);
+        kick_workspace_reset(kick_ws);
 
         if (current_cost < best_cost - EPSILON) {
             if_verbose(VERBOSE_DEBUG,
@@ -104,6 +67,8 @@ static void run_vns(const TspInstance *instance,
             memcpy(best_tour, current_tour, (n + 1) * sizeof(int));
             current_k = cfg->min_k;
             stagnation = 0;
+            // Published right away so that algorithms sharing the solution can pick it up
+            tsp_solution_update_if_better(solution, best_tour, best_cost);
         } else {
             // Restore best solution
             memcpy(current_tour, best_tour, (n + 1) * sizeof(int));
@@ -114,6 +79,14 @@ static void run_vns(const TspInstance *instance,
             if (current_k > cfg->max_k) {
                 current_k = cfg->min_k;
                 stagnation++;
+
+                // After a full round of kicks, restart from the shared incumbent if someone else improved it
+                if (tsp_solution_fetch_if_better(solution, best_tour, &best_cost)) {
+                    if_verbose(VERBOSE_DEBUG, "\tVNS: restarting from shared incumbent %.2f\n", best_cost);
+                    memcpy(current_tour, best_tour, (n + 1) * sizeof(int));
+                    current_cost = best_cost;
+                    stagnation = 0;
+                }
             }
         }
 
@@ -128,6 +101,7 @@ static void run_vns(const TspInstance *instance,
 
     tsp_solution_update_if_better(solution, best_tour, best_cost);
 
+    kick_workspace_destroy(kick_ws);
     tsp_free(best_tour);
     tsp_free(current_tour);
 }
@@ -1,5 +1,9 @@
 #include "tsp_algorithm.h"
 #include "logger.h"
+#include "c_util.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
 
 void tsp_algorithm_run(const TspAlgorithm *algo,
                        const TspInstance *instance,
@@ -15,3 +19,76 @@ void tsp_algorithm_destroy(TspAlgorithm *algo) {
     if (!algo || !algo->config || !algo->free_config) return;
     algo->free_config(algo->config);
 }
+
+struct TspSolveHandle {
+    const TspAlgorithm *algo;
+    const TspInstance *instance;
+    TspSolution *solution;
+    CostRecorder *recorder;
+    CancelToken *cancel;
+    pthread_t thread;
+    atomic_bool finished;
+    bool joined;
+};
+
+static void *solve_thread_main(void *arg) {
+    TspSolveHandle *handle = arg;
+    tsp_algorithm_run(handle->algo, handle->instance, handle->solution, handle->recorder);
+    atomic_store(&handle->finished, true);
+    return NULL;
+}
+
+TspSolveHandle *tsp_algorithm_start(const TspAlgorithm *algo,
+                                    const TspInstance *instance,
+                                    TspSolution *solution,
+                                    CostRecorder *recorder,
+                                    const TspSolutionListener on_improvement,
+                                    void *user_data) {
+    if (!algo || !instance || !solution) return NULL;
+
+    TspSolveHandle *handle = tsp_malloc(sizeof(TspSolveHandle));
+    handle->algo = algo;
+    handle->instance = instance;
+    handle->solution = solution;
+    handle->recorder = recorder;
+    handle->cancel = cancel_token_create();
+    atomic_init(&handle->finished, false);
+    handle->joined = false;
+
+    tsp_solution_set_cancel_token(solution, handle->cancel);
+    tsp_solution_set_listener(solution, on_improvement, user_data);
+
+    if (pthread_create(&handle->thread, NULL, solve_thread_main, handle) != 0) {
+        if_verbose(VERBOSE_INFO, "[ERROR] Cannot start a thread for %s\n", algo->name);
+        tsp_solution_set_cancel_token(solution, NULL);
+        tsp_solution_set_listener(solution, NULL, NULL);
+        cancel_token_destroy(handle->cancel);
+        tsp_free(handle);
+        return NULL;
+    }
+    return handle;
+}
+
+bool tsp_solve_poll(const TspSolveHandle *handle) {
+    return atomic_load(&handle->finished);
+}
+
+void tsp_solve_wait(TspSolveHandle *handle) {
+    if (handle->joined) return;
+    pthread_join(handle->thread, NULL);
+    handle->joined = true;
+}
+
+void tsp_solve_cancel(TspSolveHandle *handle) {
+    cancel_token_cancel(handle->cancel);
+}
+
+void tsp_solve_destroy(TspSolveHandle *handle) {
+    if (!handle) return;
+    tsp_solve_cancel(handle);
+    tsp_solve_wait(handle);
+    tsp_solution_set_cancel_token(handle->solution, NULL);
+    tsp_solution_set_listener(handle->solution, NULL, NULL);
+    cancel_token_destroy(handle->cancel);
+    tsp_free(handle);
+}
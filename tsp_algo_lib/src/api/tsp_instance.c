@@ -5,12 +5,17 @@
 #include "logger.h"
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include "random.h"
+#include "candidate_lists.h"
+#include "constants.h"
 
 struct TspInstance {
     int number_of_nodes;
     Node *nodes;
     double *edge_cost_array;
+    CandidateLists *candidates; // built lazily, guarded by cache_mutex
+    pthread_mutex_t cache_mutex;
 };
 
 static TspInstance *instance_create_from_nodes(Node *nodes, const size_t n) {
@@ -22,6 +27,8 @@ static TspInstance *instance_create_from_nodes(Node *nodes, const size_t n) {
     inst->number_of_nodes = n;
     inst->nodes = nodes;
     inst->edge_cost_array = costs;
+    inst->candidates = NULL;
+    pthread_mutex_init(&inst->cache_mutex, NULL);
 
     return inst;
 }
@@ -63,6 +70,8 @@ void tsp_instance_destroy(TspInstance *instance) {
         tsp_free(instance->nodes);
     if (instance->edge_cost_array)
         tsp_free(instance->edge_cost_array);
+    candidate_lists_destroy(instance->candidates);
+    pthread_mutex_destroy(&instance->cache_mutex);
     tsp_free(instance);
 }
 
@@ -77,3 +86,19 @@ const Node *tsp_instance_get_nodes(const TspInstance *instance) {
 const double *tsp_instance_get_cost_matrix(const TspInstance *instance) {
     return instance ? instance->edge_cost_array : NULL;
 }
+
+const CandidateLists *tsp_instance_get_candidate_lists(const TspInstance *instance) {
+    if (!instance) return NULL;
+
+    // The cache is logically part of the instance: building it does not change observable state
+    TspInstance *mutable_instance = (TspInstance *) instance;
+    pthread_mutex_lock(&mutable_instance->cache_mutex);
+    if (!mutable_instance->candidates) {
+        mutable_instance->candidates = candidate_lists_create(instance->edge_cost_array,
+                                                              instance->number_of_nodes,
+                                                              CANDIDATE_LIST_SIZE);
+    }
+    pthread_mutex_unlock(&mutable_instance->cache_mutex);
+
+    return mutable_instance->candidates;
+}
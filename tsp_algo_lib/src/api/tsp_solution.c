@@ -20,6 +20,9 @@ struct TspSolution {
     int *tour;
     const TspInstance *instance;
     pthread_mutex_t mutex;
+    TspSolutionListener listener;
+    void *listener_data;
+    const CancelToken *cancel;
 };
 
 static double compute_cost_internal(const TspInstance *instance, const int *tour) {
@@ -52,6 +55,9 @@ TspSolution *tsp_solution_create(const TspInstance *instance) {
 
     sol->instance = instance;
     sol->tour = allocate_tour(n);
+    sol->listener = NULL;
+    sol->listener_data = NULL;
+    sol->cancel = NULL;
 
     initialize_tour_identity(sol->tour, n);
     sol->cost = compute_cost_internal(instance, sol->tour);
@@ -160,12 +166,43 @@ bool tsp_solution_update_if_better(TspSolution *self, const int *new_tour, doubl
         self->cost = new_cost;
         memcpy(self->tour, new_tour, (n + 1) * sizeof(int));
         updated = true;
+        if (self->listener) self->listener(self->tour, n, self->cost, self->listener_data);
     }
     pthread_mutex_unlock(&self->mutex);
 
     return updated;
 }
 
+bool tsp_solution_fetch_if_better(TspSolution *self, int *tour_buffer, double *cost) {
+    bool fetched = false;
+    int n = tsp_instance_get_num_nodes(self->instance);
+
+    pthread_mutex_lock(&self->mutex);
+    if (self->cost < *cost - EPSILON) {
+        *cost = self->cost;
+        memcpy(tour_buffer, self->tour, (n + 1) * sizeof(int));
+        fetched = true;
+    }
+    pthread_mutex_unlock(&self->mutex);
+
+    return fetched;
+}
+
+void tsp_solution_set_listener(TspSolution *self, TspSolutionListener listener, void *user_data) {
+    pthread_mutex_lock(&self->mutex);
+    self->listener = listener;
+    self->listener_data = user_data;
+    pthread_mutex_unlock(&self->mutex);
+}
+
+void tsp_solution_set_cancel_token(TspSolution *self, const CancelToken *token) {
+    self->cancel = token;
+}
+
+const CancelToken *tsp_solution_get_cancel_token(const TspSolution *self) {
+    return self->cancel;
+}
+
 TspError tsp_solution_save(TspSolution *self, const char *path) {
     if (!self || !path) return TSP_ERR_MEMORY;
 
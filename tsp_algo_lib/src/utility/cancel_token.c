@@ -0,0 +1,29 @@
+#include "cancel_token.h"
+#include <stdatomic.h>
+#include "c_util.h"
+
+struct CancelToken {
+    atomic_bool cancelled;
+};
+
+CancelToken *cancel_token_create(void) {
+    CancelToken *token = tsp_malloc(sizeof(CancelToken));
+    atomic_init(&token->cancelled, false);
+    return token;
+}
+
+void cancel_token_destroy(CancelToken *token) {
+    tsp_free(token);
+}
+
+void cancel_token_cancel(CancelToken *token) {
+    atomic_store_explicit(&token->cancelled, true, memory_order_release);
+}
+
+bool cancel_token_is_cancelled(const CancelToken *token) {
+    return token && atomic_load_explicit(&token->cancelled, memory_order_acquire);
+}
+
+void cancel_token_reset(CancelToken *token) {
+    atomic_store_explicit(&token->cancelled, false, memory_order_release);
+}
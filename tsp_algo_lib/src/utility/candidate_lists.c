@@ -0,0 +1,61 @@
+#include "candidate_lists.h"
+#include "c_util.h"
+
+struct CandidateLists {
+    int *neighbors; // n * k, row-major
+    int n;
+    int k;
+};
+
+CandidateLists *candidate_lists_create(const double *costs, const int n, int k) {
+    if (k > n - 1) k = n - 1;
+    if (k < 0) k = 0;
+
+    CandidateLists *lists = tsp_malloc(sizeof(CandidateLists));
+    lists->n = n;
+    lists->k = k;
+    lists->neighbors = tsp_malloc((size_t) n * (k > 0 ? k : 1) * sizeof(int));
+
+    if (k == 0) return lists;
+
+    double *best = tsp_malloc(k * sizeof(double));
+
+    for (int i = 0; i < n; i++) {
+        int *row = lists->neighbors + (size_t) i * k;
+        const double *cost_row = costs + (size_t) i * n;
+        int size = 0;
+
+        // Bounded insertion sort: most candidates are rejected by the first comparison
+        for (int j = 0; j < n; j++) {
+            if (j == i) continue;
+            const double c = cost_row[j];
+            if (size == k && c >= best[k - 1]) continue;
+
+            int pos = size < k ? size++ : k - 1;
+            while (pos > 0 && best[pos - 1] > c) {
+                best[pos] = best[pos - 1];
+                row[pos] = row[pos - 1];
+                pos--;
+            }
+            best[pos] = c;
+            row[pos] = j;
+        }
+    }
+
+    tsp_free(best);
+    return lists;
+}
+
+void candidate_lists_destroy(CandidateLists *lists) {
+    if (!lists) return;
+    tsp_free(lists->neighbors);
+    tsp_free(lists);
+}
+
+int candidate_lists_get_k(const CandidateLists *lists) {
+    return lists ? lists->k : 0;
+}
+
+const int *candidate_lists_get(const CandidateLists *lists, const int node) {
+    return lists->neighbors + (size_t) node * lists->k;
+}
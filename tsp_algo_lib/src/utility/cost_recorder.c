@@ -1,29 +1,71 @@
 #include "cost_recorder.h"
+#include <float.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "c_util.h"
+#include "chrono.h"
+#include "constants.h"
 
 struct CostRecorder {
+    // Samples, structure of arrays so that the costs can be handed to the plotter as they are
     double *data;
+    double *times;
+    int *threads;
+    CostEvent *events;
     size_t count;
+    size_t iterations; // samples of COST_EVENT_ITERATION among count, the only ones downsampling drops
     size_t capacity;
     bool enabled;
-};
 
-CostRecorder *cost_recorder_create(size_t initial_capacity) {
-    if (initial_capacity == 0) initial_capacity = 1024;
+    double start_time;
+    int thread_id;
+    double best_cost;
 
-    CostRecorder *r = tsp_malloc(sizeof(CostRecorder));
+    CostRecordMode mode;
+    size_t max_samples; // 0 = unbounded
+    size_t stride; // only every stride-th iteration is recorded once the bound was hit
+    size_t skipped;
+};
 
+static void allocate_samples(CostRecorder *r, const size_t capacity) {
+    r->data = tsp_realloc(r->data, capacity * sizeof(double));
+    r->times = tsp_realloc(r->times, capacity * sizeof(double));
+    r->threads = tsp_realloc(r->threads, capacity * sizeof(int));
+    r->events = tsp_realloc(r->events, capacity * sizeof(CostEvent));
+    r->capacity = capacity;
+}
 
-    r->data = tsp_malloc(initial_capacity * sizeof(double));
+CostRecorder *cost_recorder_create(size_t initial_capacity) {
+    if (initial_capacity == 0) initial_capacity = 1024;
 
+    CostRecorder *r = tsp_calloc(1, sizeof(CostRecorder));
+    allocate_samples(r, initial_capacity);
 
     r->count = 0;
-    r->capacity = initial_capacity;
+    r->iterations = 0;
     r->enabled = true;
+    r->start_time = second();
+    r->thread_id = 0;
+    r->best_cost = DBL_MAX;
+    r->mode = COST_RECORD_ALL;
+    r->max_samples = 0;
+    r->stride = 1;
+    r->skipped = 0;
+
+    return r;
+}
+
+CostRecorder *cost_recorder_create_child(const CostRecorder *parent, const int thread_id) {
+    CostRecorder *r = cost_recorder_create(0);
+    if (!parent) return r;
 
+    r->enabled = parent->enabled;
+    r->start_time = parent->start_time;
+    r->thread_id = thread_id;
+    r->mode = parent->mode;
+    r->max_samples = parent->max_samples;
     return r;
 }
 
@@ -31,21 +73,70 @@ void cost_recorder_destroy(CostRecorder *r) {
     if (!r) return;
 
     tsp_free(r->data);
+    tsp_free(r->times);
+    tsp_free(r->threads);
+    tsp_free(r->events);
     tsp_free(r);
 }
 
-void cost_recorder_add(CostRecorder *r, const double cost) {
-    if (!r || !r->enabled) return;
+void cost_recorder_set_bounds(CostRecorder *r, const CostRecordMode mode, const size_t max_samples) {
+    if (!r) return;
+    r->mode = mode;
+    // Halving keeps the first and the last iteration: smaller bounds could not shrink
+    r->max_samples = max_samples > 0 && max_samples < 4 ? 4 : max_samples;
+}
 
-    if (r->count == r->capacity) {
-        const size_t new_cap = r->capacity * 2;
-        double *tmp = tsp_realloc(r->data, new_cap * sizeof(double));
+/*
+ * Keeps every other iteration, and always the last one, until the recorder is within its bound. Improvements and
+ * final costs are never dropped: once they alone fill the bound, the recorder grows past it.
+ */
+static void downsample(CostRecorder *r) {
+    while (r->max_samples && r->count >= r->max_samples && r->iterations > 2) {
+        size_t kept = 0, seen = 0;
+        for (size_t i = 0; i < r->count; i++) {
+            if (r->events[i] == COST_EVENT_ITERATION && seen++ % 2 != 0 && seen != r->iterations) continue;
+            r->data[kept] = r->data[i];
+            r->times[kept] = r->times[i];
+            r->threads[kept] = r->threads[i];
+            r->events[kept] = r->events[i];
+            kept++;
+        }
+        r->iterations -= r->count - kept;
+        r->count = kept;
+        r->stride *= 2;
+    }
+}
+
+static void append(CostRecorder *r, const double cost, const double time, const int thread_id,
+                   const CostEvent event) {
+    if (r->count == r->capacity) allocate_samples(r, r->capacity * 2);
+
+    r->data[r->count] = cost;
+    r->times[r->count] = time;
+    r->threads[r->count] = thread_id;
+    r->events[r->count] = event;
+    r->count++;
+    if (event == COST_EVENT_ITERATION) r->iterations++;
+}
+
+void cost_recorder_add_event(CostRecorder *r, const double cost, const CostEvent event) {
+    if (!r || !r->enabled) return;
 
-        r->data = tmp;
-        r->capacity = new_cap;
+    if (event == COST_EVENT_ITERATION) {
+        if (r->mode == COST_RECORD_IMPROVEMENTS) return;
+        // Improvements and final costs are never skipped
+        if (r->stride > 1 && ++r->skipped < r->stride) return;
+        r->skipped = 0;
     }
+    if (cost < r->best_cost) r->best_cost = cost;
 
-    r->data[r->count++] = cost;
+    if (r->max_samples && r->count >= r->max_samples) downsample(r);
+    append(r, cost, second() - r->start_time, r->thread_id, event);
+}
+
+void cost_recorder_add(CostRecorder *r, const double cost) {
+    if (!r) return;
+    cost_recorder_add_event(r, cost, cost < r->best_cost - EPSILON ? COST_EVENT_IMPROVEMENT : COST_EVENT_ITERATION);
 }
 
 size_t cost_recorder_get_count(const CostRecorder *r) {
@@ -58,6 +149,21 @@ const double *cost_recorder_get_costs(const CostRecorder *r) {
     return r->data;
 }
 
+const double *cost_recorder_get_times(const CostRecorder *r) {
+    if (!r) return NULL;
+    return r->times;
+}
+
+const int *cost_recorder_get_threads(const CostRecorder *r) {
+    if (!r) return NULL;
+    return r->threads;
+}
+
+const CostEvent *cost_recorder_get_events(const CostRecorder *r) {
+    if (!r) return NULL;
+    return r->events;
+}
+
 void cost_recorder_enable(CostRecorder *r) {
     if (!r) return;
     r->enabled = true;
@@ -71,14 +177,47 @@ void cost_recorder_disable(CostRecorder *r) {
 void cost_recorder_merge(CostRecorder *dest, const CostRecorder *src) {
     if (!dest || !src || src->count == 0) return;
 
-    const size_t required_capacity = dest->count + src->count;
     size_t new_capacity = dest->capacity ? dest->capacity : 1; // Avoid infinite loop if capacity is 0
+    while (dest->count + src->count > new_capacity) new_capacity *= 2;
+
+    // Merge of two time-ordered sequences, written back to front so that dest can be merged in place
+    allocate_samples(dest, new_capacity);
+    size_t i = dest->count, j = src->count, k = dest->count + src->count;
+    while (j > 0) {
+        const bool from_dest = i > 0 && dest->times[i - 1] > src->times[j - 1];
+        const size_t from = from_dest ? --i : --j;
+        const CostRecorder *owner = from_dest ? dest : src;
+        k--;
+        dest->data[k] = owner->data[from];
+        dest->times[k] = owner->times[from];
+        dest->threads[k] = owner->threads[from];
+        dest->events[k] = owner->events[from];
+    }
+    dest->count += src->count;
+    dest->iterations += src->iterations;
+    if (src->best_cost < dest->best_cost) dest->best_cost = src->best_cost;
 
-    while (required_capacity > new_capacity) new_capacity *= 2;
+    downsample(dest);
+}
 
-    double *new_data = tsp_realloc(dest->data, new_capacity * sizeof(double));
-    dest->data = new_data;
-    dest->capacity = new_capacity;
-    memcpy(dest->data + dest->count, src->data, src->count * sizeof(double));
-    dest->count += src->count;
+int cost_recorder_save_csv(const CostRecorder *r, const char *path) {
+    if (!r || !path) return -1;
+    FILE *file = fopen(path, "w");
+    if (!file) return -1;
+
+    fprintf(file, "seconds,cost,thread,event\n");
+    for (size_t i = 0; i < r->count; i++)
+        fprintf(file, "%.6f,%.6f,%d,%s\n", r->times[i], r->data[i], r->threads[i], cost_event_to_string(r->events[i]));
+
+    fclose(file);
+    return 0;
+}
+
+const char *cost_event_to_string(const CostEvent event) {
+    switch (event) {
+        case COST_EVENT_ITERATION: return "iteration";
+        case COST_EVENT_IMPROVEMENT: return "improvement";
+        case COST_EVENT_FINAL: return "final";
+        default: return "unknown";
+    }
 }
@@ -0,0 +1,165 @@
+#include "spatial_grid.h"
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include "c_util.h"
+
+struct SpatialGrid {
+    const Node *nodes;
+    int n;
+    int cols;
+    int rows;
+    double min_x;
+    double min_y;
+    double cell_size;
+    int *cell_start; // cols * rows + 1, CSR offsets into items
+    int *cell_count; // remaining nodes per cell, stored first in its segment
+    int *items;
+    int *slot; // position of every node in items
+    int *node_cell;
+    int remaining;
+};
+
+static int cell_coord(const double value, const double origin, const double cell_size, const int limit) {
+    const int c = (int) ((value - origin) / cell_size);
+    if (c < 0) return 0;
+    return c < limit ? c : limit - 1;
+}
+
+SpatialGrid *spatial_grid_create(const Node *nodes, const int n) {
+    SpatialGrid *grid = tsp_calloc(1, sizeof(SpatialGrid));
+    grid->nodes = nodes;
+    grid->n = n;
+
+    double min_x = DBL_MAX, min_y = DBL_MAX, max_x = -DBL_MAX, max_y = -DBL_MAX;
+    for (int i = 0; i < n; i++) {
+        if (nodes[i].x < min_x) min_x = nodes[i].x;
+        if (nodes[i].y < min_y) min_y = nodes[i].y;
+        if (nodes[i].x > max_x) max_x = nodes[i].x;
+        if (nodes[i].y > max_y) max_y = nodes[i].y;
+    }
+    if (n == 0) min_x = min_y = max_x = max_y = 0.0;
+
+    // About two nodes per cell; the second bound keeps the cell count linear on skinny bounding boxes
+    const double width = max_x - min_x, height = max_y - min_y;
+    const double target_cells = n > 2 ? n / 2.0 : 1.0;
+    double cell_size = sqrt(width * height / target_cells);
+    const double longest = width > height ? width : height;
+    if (longest / target_cells > cell_size) cell_size = longest / target_cells;
+    if (cell_size <= 0.0) cell_size = 1.0;
+
+    grid->min_x = min_x;
+    grid->min_y = min_y;
+    grid->cell_size = cell_size;
+    grid->cols = (int) (width / cell_size) + 1;
+    grid->rows = (int) (height / cell_size) + 1;
+
+    const int cells = grid->cols * grid->rows;
+    grid->cell_start = tsp_calloc(cells + 1, sizeof(int));
+    grid->cell_count = tsp_malloc(cells * sizeof(int));
+    grid->items = tsp_malloc((n > 0 ? n : 1) * sizeof(int));
+    grid->slot = tsp_malloc((n > 0 ? n : 1) * sizeof(int));
+    grid->node_cell = tsp_malloc((n > 0 ? n : 1) * sizeof(int));
+
+    // Counting sort of the nodes by cell
+    for (int i = 0; i < n; i++) {
+        const int cx = cell_coord(nodes[i].x, min_x, cell_size, grid->cols);
+        const int cy = cell_coord(nodes[i].y, min_y, cell_size, grid->rows);
+        grid->node_cell[i] = cy * grid->cols + cx;
+        grid->cell_start[grid->node_cell[i] + 1]++;
+    }
+    for (int c = 0; c < cells; c++)
+        grid->cell_start[c + 1] += grid->cell_start[c];
+    for (int c = 0; c < cells; c++)
+        grid->cell_count[c] = 0;
+    for (int i = 0; i < n; i++) {
+        const int c = grid->node_cell[i];
+        const int pos = grid->cell_start[c] + grid->cell_count[c]++;
+        grid->items[pos] = i;
+        grid->slot[i] = pos;
+    }
+    grid->remaining = n;
+
+    return grid;
+}
+
+void spatial_grid_destroy(SpatialGrid *grid) {
+    if (!grid) return;
+    tsp_free(grid->cell_start);
+    tsp_free(grid->cell_count);
+    tsp_free(grid->items);
+    tsp_free(grid->slot);
+    tsp_free(grid->node_cell);
+    tsp_free(grid);
+}
+
+void spatial_grid_fill(SpatialGrid *grid) {
+    // Removed nodes are parked at the tail of their own cell segment
+    const int cells = grid->cols * grid->rows;
+    for (int c = 0; c < cells; c++)
+        grid->cell_count[c] = grid->cell_start[c + 1] - grid->cell_start[c];
+    grid->remaining = grid->n;
+}
+
+void spatial_grid_remove(SpatialGrid *grid, const int node) {
+    const int c = grid->node_cell[node];
+    const int pos = grid->slot[node];
+    const int last = grid->cell_start[c] + grid->cell_count[c] - 1;
+    if (pos > last) return;
+
+    const int moved = grid->items[last];
+    grid->items[last] = node;
+    grid->items[pos] = moved;
+    grid->slot[moved] = pos;
+    grid->slot[node] = last;
+    grid->cell_count[c]--;
+    grid->remaining--;
+}
+
+static void scan_cell(const SpatialGrid *grid, const int cell, const int node, int *best, double *best_d2) {
+    const Node *p = &grid->nodes[node];
+    const int start = grid->cell_start[cell];
+    const int end = start + grid->cell_count[cell];
+    for (int k = start; k < end; k++) {
+        const int other = grid->items[k];
+        if (other == node) continue;
+        const double dx = grid->nodes[other].x - p->x;
+        const double dy = grid->nodes[other].y - p->y;
+        const double d2 = dx * dx + dy * dy;
+        if (d2 < *best_d2) {
+            *best_d2 = d2;
+            *best = other;
+        }
+    }
+}
+
+int spatial_grid_nearest(const SpatialGrid *grid, const int node) {
+    const int cell = grid->node_cell[node];
+    const bool self_present = grid->slot[node] < grid->cell_start[cell] + grid->cell_count[cell];
+    if (grid->remaining - (self_present ? 1 : 0) <= 0) return -1;
+
+    const int cx = cell % grid->cols, cy = cell / grid->cols;
+    const int max_ring = grid->cols > grid->rows ? grid->cols : grid->rows;
+    int best = -1;
+    double best_d2 = DBL_MAX;
+
+    for (int r = 0; r <= max_ring; r++) {
+        for (int y = cy - r; y <= cy + r; y++) {
+            if (y < 0 || y >= grid->rows) continue;
+            // Full rows on the top and bottom of the ring, only the two sides in between
+            const int step = (y == cy - r || y == cy + r) ? 1 : (r > 0 ? 2 * r : 1);
+            for (int x = cx - r; x <= cx + r; x += step) {
+                if (x < 0 || x >= grid->cols) continue;
+                scan_cell(grid, y * grid->cols + x, node, &best, &best_d2);
+            }
+        }
+        // Cells beyond ring r are at least r cells away from the query point
+        const double bound = r * grid->cell_size;
+        if (best >= 0 && best_d2 <= bound * bound) break;
+    }
+    return best;
+}
+
+int spatial_grid_count(const SpatialGrid *grid) {
+    return grid->remaining;
+}
@@ -5,7 +5,9 @@
 TimeLimiter time_limiter_create(const double limit_seconds) {
     return (TimeLimiter){
         .start_time = 0.0,
-        .limit_seconds = limit_seconds
+        .limit_seconds = limit_seconds,
+        .cancel = NULL,
+        .expired = NULL
     };
 }
 
@@ -17,12 +19,58 @@ void time_limiter_start(TimeLimiter *limiter) {
                limiter->limit_seconds);
 }
 
+void time_limiter_bind_cancel(TimeLimiter *limiter, const CancelToken *token) {
+    limiter->cancel = token;
+}
+
+void time_limiter_share_expiry(TimeLimiter *limiter, CancelToken *expired) {
+    limiter->expired = expired;
+}
+
+static bool is_stopped(const TimeLimiter *limiter) {
+    return cancel_token_is_cancelled(limiter->cancel) || cancel_token_is_cancelled(limiter->expired);
+}
+
+static bool check_clock(const TimeLimiter *limiter, const double now) {
+    if (now - limiter->start_time <= limiter->limit_seconds) return false;
+    if (limiter->expired) cancel_token_cancel(limiter->expired);
+    return true;
+}
+
 bool time_limiter_is_over(const TimeLimiter *limiter) {
-    const double elapsed = second() - limiter->start_time;
-    return elapsed > limiter->limit_seconds;
+    if (is_stopped(limiter)) return true;
+    return check_clock(limiter, second());
+}
+
+#define MAX_POLL_STRIDE (1u << 16)
+
+bool time_limiter_poll(const TimeLimiter *limiter, DeadlinePacer *pacer) {
+    if (is_stopped(limiter)) return true;
+    if (pacer->countdown > 1) {
+        pacer->countdown--;
+        return false;
+    }
+
+    const double now = second();
+    if (pacer->stride == 0 || pacer->last_read <= 0.0) {
+        pacer->stride = 1;
+    } else {
+        // Aim the next stride at one read per interval, changing it by at most a factor 2 per read
+        const double per_call = (now - pacer->last_read) / pacer->stride;
+        const double target = per_call > 0.0 ? DEADLINE_POLL_INTERVAL / per_call : 2.0 * pacer->stride;
+        if (target > 2.0 * pacer->stride) pacer->stride *= 2;
+        else if (target < 0.5 * pacer->stride) pacer->stride = pacer->stride > 1 ? pacer->stride / 2 : 1;
+        else pacer->stride = (unsigned int) target;
+        if (pacer->stride > MAX_POLL_STRIDE) pacer->stride = MAX_POLL_STRIDE;
+        if (pacer->stride == 0) pacer->stride = 1;
+    }
+    pacer->countdown = pacer->stride;
+    pacer->last_read = now;
+    return check_clock(limiter, now);
 }
 
 double time_limiter_get_remaining(const TimeLimiter *limiter) {
+    if (is_stopped(limiter)) return 0.0;
     const double now = second();
     const double elapsed = now - limiter->start_time;
     const double remaining = limiter->limit_seconds - elapsed;
@@ -0,0 +1,136 @@
+#include "tour_hash.h"
+#include <stdatomic.h>
+#include <string.h>
+#include "c_util.h"
+
+uint64_t tour_hash(const int *tour, const int n) {
+    uint64_t hash = 0;
+    for (int i = 0; i < n; i++)
+        hash ^= tour_edge_key(tour[i], tour[i + 1]);
+    return hash;
+}
+
+static size_t round_up_pow2(const int value) {
+    size_t size = 1;
+    while (size < (size_t) value) size <<= 1;
+    return size;
+}
+
+/* --- Hash set --- */
+
+// 0 marks an empty slot: the (rare) zero hash is stored as 1
+#define SET_EMPTY 0
+#define SET_KEY(hash) ((hash) == SET_EMPTY ? 1 : (hash))
+
+struct TourHashSet {
+    size_t mask;
+    _Atomic uint64_t *slots;
+};
+
+TourHashSet *tour_hash_set_create(const int capacity) {
+    TourHashSet *set = tsp_malloc(sizeof(TourHashSet));
+    // Load factor at most 1/2 keeps the probe sequences short
+    const size_t size = round_up_pow2(2 * (capacity > 0 ? capacity : 1));
+    set->mask = size - 1;
+    set->slots = tsp_malloc(size * sizeof(_Atomic uint64_t));
+    for (size_t i = 0; i < size; i++) atomic_init(&set->slots[i], SET_EMPTY);
+    return set;
+}
+
+void tour_hash_set_destroy(TourHashSet *set) {
+    if (!set) return;
+    tsp_free(set->slots);
+    tsp_free(set);
+}
+
+bool tour_hash_set_insert(TourHashSet *set, const uint64_t hash) {
+    const uint64_t key = SET_KEY(hash);
+    size_t i = key & set->mask;
+    for (size_t probes = 0; probes <= set->mask; probes++) {
+        uint64_t current = atomic_load_explicit(&set->slots[i], memory_order_relaxed);
+        if (current == key) return false;
+        if (current == SET_EMPTY) {
+            if (atomic_compare_exchange_strong_explicit(&set->slots[i], &current, key,
+                                                        memory_order_relaxed, memory_order_relaxed))
+                return true;
+            // Lost the race: the winner may have inserted the same key
+            if (current == key) return false;
+        }
+        i = (i + 1) & set->mask;
+    }
+    return true;
+}
+
+bool tour_hash_set_contains(const TourHashSet *set, const uint64_t hash) {
+    const uint64_t key = SET_KEY(hash);
+    size_t i = key & set->mask;
+    for (size_t probes = 0; probes <= set->mask; probes++) {
+        const uint64_t current = atomic_load_explicit(&set->slots[i], memory_order_relaxed);
+        if (current == key) return true;
+        if (current == SET_EMPTY) return false;
+        i = (i + 1) & set->mask;
+    }
+    return false;
+}
+
+void tour_hash_set_clear(TourHashSet *set) {
+    for (size_t i = 0; i <= set->mask; i++)
+        atomic_store_explicit(&set->slots[i], SET_EMPTY, memory_order_relaxed);
+}
+
+/* --- Fitness cache --- */
+
+/*
+ * Every slot stores (hash ^ cost_bits, cost_bits). A reader that sees the halves of two
+ * different stores fails the XOR check, so no lock is needed (lockless transposition tables).
+ */
+typedef struct {
+    _Atomic uint64_t check;
+    _Atomic uint64_t value;
+} CacheSlot;
+
+struct TourCache {
+    size_t mask;
+    CacheSlot *slots;
+};
+
+static uint64_t double_bits(const double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+TourCache *tour_cache_create(const int capacity) {
+    TourCache *cache = tsp_malloc(sizeof(TourCache));
+    const size_t size = round_up_pow2(capacity > 0 ? capacity : 1);
+    cache->mask = size - 1;
+    cache->slots = tsp_malloc(size * sizeof(CacheSlot));
+    // An empty slot (0, 0) only matches the hash 0 with cost 0.0, which no real tour has
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&cache->slots[i].check, 0);
+        atomic_init(&cache->slots[i].value, 0);
+    }
+    return cache;
+}
+
+void tour_cache_destroy(TourCache *cache) {
+    if (!cache) return;
+    tsp_free(cache->slots);
+    tsp_free(cache);
+}
+
+bool tour_cache_lookup(const TourCache *cache, const uint64_t hash, double *cost) {
+    CacheSlot *slot = &cache->slots[hash & cache->mask];
+    const uint64_t check = atomic_load_explicit(&slot->check, memory_order_relaxed);
+    const uint64_t value = atomic_load_explicit(&slot->value, memory_order_relaxed);
+    if ((check ^ value) != hash || (check == 0 && value == 0)) return false;
+    memcpy(cost, &value, sizeof(*cost));
+    return true;
+}
+
+void tour_cache_store(TourCache *cache, const uint64_t hash, const double cost) {
+    CacheSlot *slot = &cache->slots[hash & cache->mask];
+    const uint64_t value = double_bits(cost);
+    atomic_store_explicit(&slot->check, hash ^ value, memory_order_relaxed);
+    atomic_store_explicit(&slot->value, value, memory_order_relaxed);
+}
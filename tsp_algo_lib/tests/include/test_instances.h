@@ -78,7 +78,15 @@ void run_grasp_nn_helpers_tests(void);
 
 void run_local_search_tests(void);
 void run_n_opt_tests(void);
+void run_kick_tests(void);
+void run_path_relinking_tests(void);
+void run_eax_tests(void);
+void run_subtour_patching_tests(void);
+void run_migration_queue_tests(void);
 void run_subtour_separator_tests(void);
+void run_model_csr_tests(void);
+void run_min_cut_separator_tests(void);
+void run_sparse_edge_set_tests(void);
 
 void run_nn_tests(void);
 void run_em_tests(void);
@@ -0,0 +1,119 @@
+#include "test_instances.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "eax.h"
+#include "tsp_math.h"
+#include "c_util.h"
+
+static int *random_tour(int n, RandomState *rng) {
+    int *tour = malloc((n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) tour[i] = i;
+    shuffle_int_array(tour, n, rng);
+    tour[n] = tour[0];
+    return tour;
+}
+
+static void assert_valid_tour(const int *tour, int n) {
+    int *seen = calloc(n, sizeof(int));
+    for (int i = 0; i < n; i++) {
+        assert(tour[i] >= 0 && tour[i] < n);
+        assert(seen[tour[i]] == 0);
+        seen[tour[i]] = 1;
+    }
+    assert(tour[n] == tour[0]);
+    free(seen);
+}
+
+static void test_eax_identical_parents(void) {
+    printf("  [EAX] Testing Identical Parents...\n");
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = 100;
+
+    RandomState rng;
+    random_init(&rng, 3);
+    int *parent = random_tour(n, &rng);
+    int child[101];
+    double child_cost;
+    EaxWorkspace *ws = eax_workspace_create(n);
+
+    // Same tour, and the same tour reversed: no edge differs
+    assert(!eax_crossover(parent, 0.0, parent, n, costs, NULL, 5, child, &child_cost, ws, &rng));
+    int reversed[101];
+    for (int i = 0; i <= n; i++) reversed[i] = parent[n - i];
+    assert(!eax_crossover(parent, 0.0, reversed, n, costs, NULL, 5, child, &child_cost, ws, &rng));
+
+    eax_workspace_destroy(ws);
+    free(parent);
+    tsp_instance_destroy(inst);
+}
+
+static void test_eax_children_are_tours(void) {
+    printf("  [EAX] Testing Children Validity...\n");
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const CandidateLists *candidates = tsp_instance_get_candidate_lists(inst);
+    const int n = 100;
+
+    RandomState rng;
+    random_init(&rng, 5);
+    EaxWorkspace *ws = eax_workspace_create(n);
+    int child[101];
+
+    // Unrelated random parents decompose into many AB-cycles and leave many subtours to merge
+    for (int iter = 0; iter < 50; iter++) {
+        int *a = random_tour(n, &rng);
+        int *b = random_tour(n, &rng);
+        const double cost_a = calculate_tour_cost(a, n, costs);
+        double child_cost;
+
+        assert(eax_crossover(a, cost_a, b, n, costs, iter % 2 ? candidates : NULL, 1 + iter % 10,
+                             child, &child_cost, ws, &rng));
+        assert_valid_tour(child, n);
+        assert(fabs(child_cost - calculate_tour_cost(child, n, costs)) < EPSILON_EXACT);
+
+        free(a);
+        free(b);
+    }
+
+    eax_workspace_destroy(ws);
+    tsp_instance_destroy(inst);
+}
+
+static void test_eax_single_ab_cycle(void) {
+    printf("  [EAX] Testing Single AB-Cycle...\n");
+    TspInstance *inst = create_circle_instance(30, 100.0);
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = 30;
+
+    // B is the optimal circle, A is B with one segment reversed: a single 4-node AB-cycle
+    int b[31], a[31], child[31];
+    for (int i = 0; i < n; i++) b[i] = i;
+    b[n] = b[0];
+    memcpy(a, b, sizeof(a));
+    reverse_array_int(a, 5, 17);
+
+    RandomState rng;
+    random_init(&rng, 9);
+    EaxWorkspace *ws = eax_workspace_create(n);
+    double child_cost;
+
+    assert(eax_crossover(a, calculate_tour_cost(a, n, costs), b, n, costs,
+                         tsp_instance_get_candidate_lists(inst), 1, child, &child_cost, ws, &rng));
+    assert_valid_tour(child, n);
+    assert(fabs(child_cost - calculate_tour_cost(b, n, costs)) < EPSILON_EXACT);
+
+    eax_workspace_destroy(ws);
+    tsp_instance_destroy(inst);
+}
+
+void run_eax_tests(void) {
+    printf("[EAX] Running tests...\n");
+    test_eax_identical_parents();
+    test_eax_children_are_tours();
+    test_eax_single_ab_cycle();
+    printf("[EAX] All tests passed.\n");
+}
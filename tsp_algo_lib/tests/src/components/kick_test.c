@@ -0,0 +1,110 @@
+#include "test_instances.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "kick.h"
+#include "candidate_lists.h"
+#include "tsp_math.h"
+
+static void assert_permutation(const int *tour, int n) {
+    int *seen = calloc(n, sizeof(int));
+    for (int i = 0; i < n; i++) {
+        assert(tour[i] >= 0 && tour[i] < n);
+        assert(!seen[tour[i]]);
+        seen[tour[i]] = 1;
+    }
+    assert(tour[n] == tour[0]);
+    free(seen);
+}
+
+static void test_candidate_lists_sorted(void) {
+    printf("  [Kick] Testing Candidate Lists...\n");
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = 100;
+
+    const CandidateLists *lists = tsp_instance_get_candidate_lists(inst);
+    assert(lists == tsp_instance_get_candidate_lists(inst)); // cached
+    const int k = candidate_lists_get_k(lists);
+    assert(k > 0 && k < n);
+
+    for (int i = 0; i < n; i++) {
+        const int *near = candidate_lists_get(lists, i);
+        for (int q = 0; q < k; q++) {
+            assert(near[q] != i);
+            if (q > 0) assert(costs[i * n + near[q - 1]] <= costs[i * n + near[q]]);
+        }
+        // Nothing outside the list is closer than the farthest neighbor
+        int closer = 0;
+        for (int j = 0; j < n; j++)
+            if (j != i && costs[i * n + j] < costs[i * n + near[k - 1]]) closer++;
+        assert(closer <= k - 1);
+    }
+
+    tsp_instance_destroy(inst);
+}
+
+static void test_kicks_keep_permutation_and_delta(KickType type) {
+    printf("  [Kick] Testing %s...\n", kick_type_to_string(type));
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = 100;
+
+    int *tour = malloc((n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) tour[i] = i;
+    tour[n] = 0;
+
+    RandomState rng;
+    random_init(&rng, 7);
+    KickWorkspace *ws = kick_workspace_create(n, 8, tsp_instance_get_candidate_lists(inst));
+
+    double cost = calculate_tour_cost(tour, n, costs);
+    for (int it = 0; it < 200; it++) {
+        cost += kick_apply(type, tour, n, costs, 2 + it % 7, ws, &rng);
+        assert_permutation(tour, n);
+        assert(fabs(cost - calculate_tour_cost(tour, n, costs)) < EPSILON_EXACT);
+    }
+
+    kick_workspace_destroy(ws);
+    free(tour);
+    tsp_instance_destroy(inst);
+}
+
+static void test_double_bridge_changes_four_edges(void) {
+    printf("  [Kick] Testing Double-Bridge Topology...\n");
+    TspInstance *inst = create_circle_instance(100, 10.0);
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = 100;
+
+    int tour[101];
+    for (int i = 0; i < n; i++) tour[i] = i;
+    tour[n] = 0;
+
+    RandomState rng;
+    random_init(&rng, 3);
+    KickWorkspace *ws = kick_workspace_create(n, 4, NULL);
+    kick_double_bridge(tour, n, costs, ws, &rng);
+
+    // Count original edges (i, i+1) that survived: exactly n - 4
+    int kept = 0;
+    for (int i = 0; i < n; i++) {
+        const int a = tour[i], b = tour[i + 1];
+        if ((a + 1) % n == b || (b + 1) % n == a) kept++;
+    }
+    assert(kept == n - 4);
+
+    kick_workspace_destroy(ws);
+    tsp_instance_destroy(inst);
+}
+
+void run_kick_tests(void) {
+    printf("[Kick] Running tests...\n");
+    test_candidate_lists_sorted();
+    test_kicks_keep_permutation_and_delta(KICK_RANDOM_N_OPT);
+    test_kicks_keep_permutation_and_delta(KICK_DOUBLE_BRIDGE);
+    test_kicks_keep_permutation_and_delta(KICK_SEGMENT_REVERSAL);
+    test_kicks_keep_permutation_and_delta(KICK_NEAR_DOUBLE_BRIDGE);
+    test_double_bridge_changes_four_edges();
+    printf("[Kick] All tests passed.\n");
+}
@@ -5,6 +5,8 @@
 #include "time_limiter.h"
 #include "tsp_solution.h"
 #include "tsp_math.h"
+#include "two_opt_refine.h"
+#include "feasibility_result.h"
 
 static void test_two_opt_crossed_square(void) {
     printf("  [Local Search] Testing 2-Opt Crossed Square...\n");
@@ -64,9 +66,28 @@ static void test_two_opt_random_improvement(void) {
     tsp_instance_destroy(inst);
 }
 
+static void test_two_opt_algorithm_refines_solution(void) {
+    printf("  [Local Search] Testing 2-Opt algorithm on the stored tour...\n");
+
+    TspInstance *inst = create_random_instance_100();
+    TspSolution *sol = tsp_solution_create(inst);
+    const double initial_cost = tsp_solution_get_cost(sol);
+
+    TspAlgorithm algo = two_opt_create((TwoOptConfig){.time_limit = 1.0});
+    tsp_algorithm_run(&algo, inst, sol, NULL);
+
+    assert(tsp_solution_get_cost(sol) < initial_cost);
+    assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+
+    tsp_algorithm_destroy(&algo);
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+}
+
 void run_local_search_tests(void) {
     printf("[Local Search] Running tests...\n");
     test_two_opt_crossed_square();
     test_two_opt_random_improvement();
+    test_two_opt_algorithm_refines_solution();
     printf("[Local Search] All tests passed.\n");
 }
\ No newline at end of file
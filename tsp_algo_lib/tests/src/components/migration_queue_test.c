@@ -0,0 +1,75 @@
+#include "test_instances.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include "migration_queue.h"
+
+#define QUEUE_N 8
+#define QUEUE_ITEMS 20000
+
+static void test_migration_queue_fifo(void) {
+    printf("  [MigrationQueue] Testing FIFO Order and Capacity...\n");
+    MigrationQueue *queue = migration_queue_create(3, QUEUE_N);
+    int tour[QUEUE_N + 1];
+    int out[QUEUE_N + 1];
+    double cost;
+
+    assert(!migration_queue_pop(queue, out, &cost));
+
+    // Wraps around the ring a few times
+    for (int round = 0; round < 4; round++) {
+        for (int k = 0; k < 3; k++) {
+            for (int i = 0; i <= QUEUE_N; i++) tour[i] = (round * 3 + k + i) % QUEUE_N;
+            assert(migration_queue_push(queue, tour, 10.0 * k));
+        }
+        // Full: the migrant is dropped
+        assert(!migration_queue_push(queue, tour, 99.0));
+
+        for (int k = 0; k < 3; k++) {
+            assert(migration_queue_pop(queue, out, &cost));
+            assert(cost == 10.0 * k);
+            for (int i = 0; i <= QUEUE_N; i++) assert(out[i] == (round * 3 + k + i) % QUEUE_N);
+        }
+        assert(!migration_queue_pop(queue, out, &cost));
+    }
+
+    migration_queue_destroy(queue);
+}
+
+static void *producer_main(void *arg) {
+    MigrationQueue *queue = arg;
+    int tour[QUEUE_N + 1];
+    for (int k = 0; k < QUEUE_ITEMS;) {
+        for (int i = 0; i <= QUEUE_N; i++) tour[i] = k;
+        if (migration_queue_push(queue, tour, (double) k)) k++;
+    }
+    return NULL;
+}
+
+static void test_migration_queue_threads(void) {
+    printf("  [MigrationQueue] Testing Producer/Consumer Threads...\n");
+    MigrationQueue *queue = migration_queue_create(4, QUEUE_N);
+    pthread_t producer;
+    assert(pthread_create(&producer, NULL, producer_main, queue) == 0);
+
+    int out[QUEUE_N + 1];
+    double cost;
+    for (int expected = 0; expected < QUEUE_ITEMS;) {
+        if (!migration_queue_pop(queue, out, &cost)) continue;
+        // Every tour arrives whole and in order
+        assert(cost == (double) expected);
+        for (int i = 0; i <= QUEUE_N; i++) assert(out[i] == expected);
+        expected++;
+    }
+
+    pthread_join(producer, NULL);
+    assert(!migration_queue_pop(queue, out, &cost));
+    migration_queue_destroy(queue);
+}
+
+void run_migration_queue_tests(void) {
+    printf("[MigrationQueue] Running tests...\n");
+    test_migration_queue_fifo();
+    test_migration_queue_threads();
+    printf("[MigrationQueue] All tests passed.\n");
+}
@@ -0,0 +1,157 @@
+#include "test_instances.h"
+#include "min_cut_separator.h"
+#include "cplex_solver_wrapper.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include "c_util.h"
+
+static void set_edge(double *x, const int i, const int j, const int n, const double value) {
+    x[xpos(i, j, n)] = value;
+}
+
+static void test_disconnected_support(void) {
+    printf("  [MinCut] Testing 2 disjoint triangles (components)...\n");
+    const int n = 6;
+    double *x = tsp_calloc(n * (n - 1) / 2, sizeof(double));
+    set_edge(x, 0, 1, n, 1.0);
+    set_edge(x, 1, 2, n, 1.0);
+    set_edge(x, 0, 2, n, 1.0);
+    set_edge(x, 3, 4, n, 1.0);
+    set_edge(x, 4, 5, n, 1.0);
+    set_edge(x, 3, 5, n, 1.0);
+
+    MinCutSeparator *sep = min_cut_separator_create(n);
+    // The two triangles give the same SEC: only one is reported
+    assert(min_cut_separator_run(sep, x, 0.01, 10) == 1);
+    int size;
+    double value;
+    const int *nodes = min_cut_separator_get_cut(sep, 0, &size, &value);
+    assert(size == 3);
+    assert(value == 0.0);
+    assert((nodes[0] == 0 && nodes[2] == 2) || (nodes[0] == 3 && nodes[2] == 5));
+
+    min_cut_separator_destroy(sep);
+    tsp_free(x);
+}
+
+static void test_fractional_triangles(void) {
+    printf("  [MinCut] Testing fractional point with a weak cut (6 nodes)...\n");
+    const int n = 6;
+    double *x = tsp_calloc(n * (n - 1) / 2, sizeof(double));
+    // Two triangles at 0.9 joined by three edges at 0.2: every degree is 2, x(delta({0,1,2})) = 0.6
+    for (int side = 0; side < 2; side++) {
+        const int b = 3 * side;
+        set_edge(x, b, b + 1, n, 0.9);
+        set_edge(x, b + 1, b + 2, n, 0.9);
+        set_edge(x, b, b + 2, n, 0.9);
+    }
+    for (int i = 0; i < 3; i++) set_edge(x, i, i + 3, n, 0.2);
+
+    MinCutSeparator *sep = min_cut_separator_create(n);
+    const int found = min_cut_separator_run(sep, x, 0.01, 10);
+    assert(found >= 1);
+
+    bool triangle_found = false;
+    for (int k = 0; k < found; k++) {
+        int size;
+        double value;
+        const int *nodes = min_cut_separator_get_cut(sep, k, &size, &value);
+        assert(value < 2.0 - 0.01);
+        if (size == 3 && fabs(value - 0.6) < 1e-9 && (nodes[0] / 3) == (nodes[1] / 3) && (nodes[1] / 3) == (nodes[2] / 3))
+            triangle_found = true;
+    }
+    assert(triangle_found);
+
+    min_cut_separator_destroy(sep);
+    tsp_free(x);
+}
+
+static void test_shrunk_halves(void) {
+    printf("  [MinCut] Testing shrinking of 1-edges (two joined 20-cycles)...\n");
+    const int n = 40;
+    double *x = tsp_calloc(n * (n - 1) / 2, sizeof(double));
+    // Cycles 0..19 and 20..39; edges (0,1) and (20,21) halved and bridged: x(delta(half)) = 1
+    for (int i = 0; i < 20; i++) {
+        set_edge(x, i, (i + 1) % 20, n, 1.0);
+        set_edge(x, 20 + i, 20 + (i + 1) % 20, n, 1.0);
+    }
+    set_edge(x, 0, 1, n, 0.5);
+    set_edge(x, 20, 21, n, 0.5);
+    set_edge(x, 0, 20, n, 0.5);
+    set_edge(x, 1, 21, n, 0.5);
+
+    MinCutSeparator *sep = min_cut_separator_create(n);
+    assert(min_cut_separator_run(sep, x, 0.01, 10) == 1);
+    int size;
+    double value;
+    const int *nodes = min_cut_separator_get_cut(sep, 0, &size, &value);
+    assert(size == 20);
+    assert(fabs(value - 1.0) < 1e-9);
+    for (int k = 1; k < size; k++) assert(nodes[k] / 20 == nodes[0] / 20);
+
+    min_cut_separator_destroy(sep);
+    tsp_free(x);
+}
+
+static void test_tour_combination(void) {
+    printf("  [MinCut] Testing convex combination of two tours (no violated SEC)...\n");
+    const int n = 6;
+    double *x = tsp_calloc(n * (n - 1) / 2, sizeof(double));
+    const int tour_a[] = {0, 1, 2, 3, 4, 5, 0};
+    const int tour_b[] = {0, 2, 4, 1, 3, 5, 0};
+    for (int k = 0; k < n; k++) {
+        x[xpos(tour_a[k], tour_a[k + 1], n)] += 0.5;
+        x[xpos(tour_b[k], tour_b[k + 1], n)] += 0.5;
+    }
+
+    MinCutSeparator *sep = min_cut_separator_create(n);
+    assert(min_cut_separator_run(sep, x, 0.01, 10) == 0);
+
+    min_cut_separator_destroy(sep);
+    tsp_free(x);
+}
+
+static void test_sparse_point(void) {
+    printf("  [MinCut] Testing a point given edge by edge (two joined 20-cycles)...\n");
+    const int n = 40;
+    int edge_u[48], edge_v[48];
+    double x[48];
+    int m = 0;
+    // Same point as test_shrunk_halves, plus zero edges that a sparse model may list
+    for (int i = 0; i < 20; i++) {
+        for (int side = 0; side < 2; side++) {
+            const int a = 20 * side + i, b = 20 * side + (i + 1) % 20;
+            edge_u[m] = a < b ? a : b;
+            edge_v[m] = a < b ? b : a;
+            x[m++] = i == 0 ? 0.5 : 1.0;
+        }
+    }
+    const int extra[][3] = {{0, 20, 5}, {1, 21, 5}, {5, 25, 0}, {7, 30, 0}};
+    for (int k = 0; k < 4; k++) {
+        edge_u[m] = extra[k][0];
+        edge_v[m] = extra[k][1];
+        x[m++] = extra[k][2] / 10.0;
+    }
+
+    MinCutSeparator *sep = min_cut_separator_create(n);
+    assert(min_cut_separator_run_sparse(sep, edge_u, edge_v, x, m, 0.01, 10) == 1);
+    int size;
+    double value;
+    const int *nodes = min_cut_separator_get_cut(sep, 0, &size, &value);
+    assert(size == 20);
+    assert(fabs(value - 1.0) < 1e-9);
+    for (int k = 1; k < size; k++) assert(nodes[k] / 20 == nodes[0] / 20);
+
+    min_cut_separator_destroy(sep);
+}
+
+void run_min_cut_separator_tests(void) {
+    printf("[MinCut Separator] Running tests...\n");
+    test_disconnected_support();
+    test_fractional_triangles();
+    test_shrunk_halves();
+    test_tour_combination();
+    test_sparse_point();
+    printf("[MinCut Separator] All tests passed.\n");
+}
@@ -0,0 +1,85 @@
+#include "test_instances.h"
+#include "tsp_model_csr.h"
+#include "cplex_solver_wrapper.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "c_util.h"
+
+static void test_csr_layout(void) {
+    printf("  [Model CSR] Testing degree rows and edge columns (burma14)...\n");
+    TspInstance *inst = create_burma14_instance();
+    const int n = tsp_instance_get_num_nodes(inst);
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    TspModelCsr *m = tsp_model_csr_build(inst, false, 1);
+
+    assert(m->num_cols == n * (n - 1) / 2);
+    assert(m->num_rows == n);
+    assert(m->nnz == n * (n - 1));
+    assert(m->colname == NULL && m->rowname == NULL);
+
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            const int col = xpos(i, j, n);
+            assert(m->obj[col] == costs[i * n + j]);
+            assert(m->ub[col] == 1.0);
+            assert(m->ctype[col] == 'B');
+        }
+    }
+
+    // Every column appears in exactly the two rows of its endpoints
+    int *hits = tsp_calloc(m->num_cols, sizeof(int));
+    for (int h = 0; h < n; h++) {
+        assert(m->rmatbeg[h] == h * (n - 1));
+        assert(m->rhs[h] == 2.0 && m->sense[h] == 'E');
+        const int end = h + 1 < n ? m->rmatbeg[h + 1] : m->nnz;
+        for (int k = m->rmatbeg[h]; k < end; k++) {
+            assert(m->rmatval[k] == 1.0);
+            hits[m->rmatind[k]]++;
+        }
+    }
+    for (int c = 0; c < m->num_cols; c++) assert(hits[c] == 2);
+
+    tsp_free(hits);
+    tsp_model_csr_destroy(m);
+    tsp_instance_destroy(inst);
+}
+
+static void test_csr_names(void) {
+    printf("  [Model CSR] Testing optional names...\n");
+    TspInstance *inst = create_square_instance();
+    const int n = tsp_instance_get_num_nodes(inst);
+    TspModelCsr *m = tsp_model_csr_build(inst, true, 1);
+
+    assert(strcmp(m->colname[xpos(0, 1, n)], "x_1_2") == 0);
+    assert(strcmp(m->colname[xpos(n - 2, n - 1, n)], "x_3_4") == 0);
+    assert(strcmp(m->rowname[0], "deg_1") == 0);
+    assert(strcmp(m->rowname[n - 1], "deg_4") == 0);
+
+    tsp_model_csr_destroy(m);
+    tsp_instance_destroy(inst);
+}
+
+static void test_csr_parallel_matches_serial(void) {
+    printf("  [Model CSR] Testing parallel fill against the serial one (600 nodes)...\n");
+    TspInstance *inst = create_circle_instance(600, 100.0);
+    TspModelCsr *serial = tsp_model_csr_build(inst, false, 1);
+    TspModelCsr *parallel = tsp_model_csr_build(inst, false, 4);
+
+    assert(memcmp(serial->obj, parallel->obj, serial->num_cols * sizeof(double)) == 0);
+    assert(memcmp(serial->ctype, parallel->ctype, serial->num_cols * sizeof(char)) == 0);
+    assert(memcmp(serial->rmatbeg, parallel->rmatbeg, serial->num_rows * sizeof(int)) == 0);
+    assert(memcmp(serial->rmatind, parallel->rmatind, serial->nnz * sizeof(int)) == 0);
+
+    tsp_model_csr_destroy(serial);
+    tsp_model_csr_destroy(parallel);
+    tsp_instance_destroy(inst);
+}
+
+void run_model_csr_tests(void) {
+    printf("[Model CSR] Running tests...\n");
+    test_csr_layout();
+    test_csr_names();
+    test_csr_parallel_matches_serial();
+    printf("[Model CSR] All tests passed.\n");
+}
@@ -0,0 +1,102 @@
+#include "test_instances.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "elite_pool.h"
+#include "path_relinking.h"
+#include "tsp_math.h"
+#include "c_util.h"
+
+static int *identity_tour(int n) {
+    int *tour = malloc((n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) tour[i] = i;
+    tour[n] = 0;
+    return tour;
+}
+
+static void test_relink_intermediate_is_valid(void) {
+    printf("  [Path Relinking] Testing Intermediate Tours...\n");
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = 100;
+
+    RandomState rng;
+    random_init(&rng, 11);
+    int *from = identity_tour(n);
+    int *target = identity_tour(n);
+    shuffle_int_array(target, n, &rng);
+    target[n] = target[0];
+
+    int *out = malloc((n + 1) * sizeof(int));
+    int *adjacency = malloc(2 * n * sizeof(int));
+    double out_cost;
+    PathRelinkWorkspace *ws = path_relink_workspace_create(n);
+
+    assert(path_relink(from, calculate_tour_cost(from, n, costs), target, n, costs, out, &out_cost, ws));
+    assert(fabs(out_cost - calculate_tour_cost(out, n, costs)) < EPSILON_EXACT);
+    assert(out[n] == out[0]);
+
+    // Strictly between the endpoints
+    assert(tour_edge_distance(out, from, n, adjacency) > 0);
+    assert(tour_edge_distance(out, target, n, adjacency) > 0);
+
+    // Identical tours (up to rotation and direction) have no intermediate
+    int *rotated = malloc((n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) rotated[i] = target[(n - i + 5) % n];
+    rotated[n] = rotated[0];
+    assert(tour_edge_distance(rotated, target, n, adjacency) == 0);
+    assert(!path_relink(rotated, 0.0, target, n, costs, out, &out_cost, ws));
+
+    path_relink_workspace_destroy(ws);
+    free(rotated);
+    free(adjacency);
+    free(out);
+    free(from);
+    free(target);
+    tsp_instance_destroy(inst);
+}
+
+static void test_elite_pool_diversity(void) {
+    printf("  [Path Relinking] Testing Elite Pool Diversity...\n");
+    const int n = 20;
+    ElitePool *pool = elite_pool_create(2, 0.2);
+
+    int *tour = identity_tour(n);
+    assert(elite_pool_try_add(pool, tour, n, 100.0));
+    assert(!elite_pool_try_add(pool, tour, n, 90.0)); // duplicate, even if better
+
+    // 2-opt neighbor: only 2 edges differ (< 20% of 20), accepted only as a new best
+    reverse_array_int(tour, 3, 8);
+    assert(!elite_pool_try_add(pool, tour, n, 150.0));
+    assert(elite_pool_try_add(pool, tour, n, 95.0));
+    assert(elite_pool_size(pool) == 2);
+
+    // Full: a worse-than-worst tour is rejected
+    RandomState rng;
+    random_init(&rng, 1);
+    shuffle_int_array(tour, n, &rng);
+    tour[n] = tour[0];
+    assert(!elite_pool_try_add(pool, tour, n, 200.0));
+
+    int *sample = malloc((n + 1) * sizeof(int));
+    double sample_cost;
+    assert(elite_pool_sample(pool, &rng, sample, &sample_cost));
+    assert(sample_cost == 100.0 || sample_cost == 95.0);
+
+    // Shared references: the pool survives until the last release
+    elite_pool_retain(pool);
+    elite_pool_release(pool);
+    assert(elite_pool_size(pool) == 2);
+    elite_pool_release(pool);
+
+    free(sample);
+    free(tour);
+}
+
+void run_path_relinking_tests(void) {
+    printf("[Path Relinking] Running tests...\n");
+    test_relink_intermediate_is_valid();
+    test_elite_pool_diversity();
+    printf("[Path Relinking] All tests passed.\n");
+}
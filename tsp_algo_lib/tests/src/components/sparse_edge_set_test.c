@@ -0,0 +1,100 @@
+#include "test_instances.h"
+#include "sparse_edge_set.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "c_util.h"
+
+static void test_add_and_find(void) {
+    printf("  [Sparse Edges] Testing columns, lookup and growth (complete graph on 12 nodes)...\n");
+    const int n = 12;
+    SparseEdgeSet *set = sparse_edge_set_create(n);
+
+    // More edges than the initial capacity (4n): the set grows and keeps every column
+    int expected = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            assert(sparse_edge_set_add(set, j, i) == expected);
+            expected++;
+        }
+    }
+    assert(set->num_edges == n * (n - 1) / 2);
+    assert(sparse_edge_set_add(set, 3, 7) == sparse_edge_set_find(set, 7, 3));
+    assert(set->num_edges == n * (n - 1) / 2);
+
+    for (int col = 0; col < set->num_edges; col++) {
+        assert(set->edge_u[col] < set->edge_v[col]);
+        assert(sparse_edge_set_find(set, set->edge_u[col], set->edge_v[col]) == col);
+    }
+
+    // Every node is listed in the incidence of its n - 1 columns
+    for (int u = 0; u < n; u++) {
+        int degree = 0;
+        for (int e = set->head[u]; e != -1; e = set->next[e]) {
+            const int col = e >> 1;
+            assert((e & 1 ? set->edge_v[col] : set->edge_u[col]) == u);
+            degree++;
+        }
+        assert(degree == n - 1);
+    }
+
+    sparse_edge_set_destroy(set);
+}
+
+static void test_candidates(void) {
+    printf("  [Sparse Edges] Testing candidate edges (random 100, k = 5)...\n");
+    TspInstance *inst = create_random_instance_100();
+    const int n = tsp_instance_get_num_nodes(inst);
+    CandidateLists *candidates = candidate_lists_create(tsp_instance_get_cost_matrix(inst), n, 5);
+    SparseEdgeSet *set = sparse_edge_set_create(n);
+    sparse_edge_set_add_candidates(set, candidates);
+
+    // Symmetric pairs are merged: between n*k/2 and n*k columns
+    assert(set->num_edges >= n * 5 / 2 && set->num_edges <= n * 5);
+    for (int u = 0; u < n; u++) {
+        const int *neighbors = candidate_lists_get(candidates, u);
+        for (int r = 0; r < 5; r++) assert(sparse_edge_set_find(set, u, neighbors[r]) >= 0);
+    }
+
+    sparse_edge_set_destroy(set);
+    candidate_lists_destroy(candidates);
+    tsp_instance_destroy(inst);
+}
+
+static void test_pricing(void) {
+    printf("  [Sparse Edges] Testing reduced cost pricing (6 nodes on a line)...\n");
+    const int n = 6;
+    double costs[36];
+    double duals[6];
+    for (int i = 0; i < n; i++) {
+        duals[i] = 1.5;
+        for (int j = 0; j < n; j++) costs[i * n + j] = abs(i - j);
+    }
+
+    // Cycle 0-1-2-3-4-5-0: missing edges at distance 2 have reduced cost 2 - 3 = -1, the others >= 0
+    SparseEdgeSet *set = sparse_edge_set_create(n);
+    for (int i = 0; i < n; i++) sparse_edge_set_add(set, i, (i + 1) % n);
+    assert(sparse_edge_set_price(set, costs, duals, -1e-6, 0) == 4);
+    assert(set->num_edges == 10);
+    for (int i = 0; i + 2 < n; i++) assert(sparse_edge_set_find(set, i, i + 2) >= n);
+    assert(sparse_edge_set_find(set, 0, 3) == -1);
+    // Priced out: nothing enters any more
+    assert(sparse_edge_set_price(set, costs, duals, -1e-6, 0) == 0);
+    sparse_edge_set_destroy(set);
+
+    // One edge per node, the most negative: (0, 2) beats (0, 3) below a threshold of 0.5
+    set = sparse_edge_set_create(n);
+    for (int i = 0; i < n; i++) sparse_edge_set_add(set, i, (i + 1) % n);
+    assert(sparse_edge_set_price(set, costs, duals, 0.5, 1) == 4);
+    assert(sparse_edge_set_find(set, 0, 2) >= 0);
+    assert(sparse_edge_set_find(set, 0, 3) == -1);
+    sparse_edge_set_destroy(set);
+}
+
+void run_sparse_edge_set_tests(void) {
+    printf("[Sparse Edge Set] Running tests...\n");
+    test_add_and_find();
+    test_candidates();
+    test_pricing();
+    printf("[Sparse Edge Set] All tests passed.\n");
+}
@@ -0,0 +1,109 @@
+#include "test_instances.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "subtour_patching.h"
+#include "cplex_solver_wrapper.h"
+#include "tsp_math.h"
+#include "c_util.h"
+
+static void assert_valid_tour(const int *tour, int n) {
+    int *seen = calloc(n, sizeof(int));
+    for (int i = 0; i < n; i++) {
+        assert(tour[i] >= 0 && tour[i] < n);
+        assert(seen[tour[i]] == 0);
+        seen[tour[i]] = 1;
+    }
+    assert(tour[n] == tour[0]);
+    free(seen);
+}
+
+static void test_patch_two_arcs(void) {
+    printf("  [Patching] Testing merge of two subtours on a circle...\n");
+    const int n = 12;
+    TspInstance *inst = create_circle_instance(n, 10.0);
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+
+    // Subtours 0..5 and 6..11, each closed on itself: the cheapest merge gives the circle
+    double *x = tsp_calloc(n * (n - 1) / 2, sizeof(double));
+    double subtour_cost = 0.0;
+    for (int half = 0; half < 2; half++) {
+        for (int i = 0; i < 6; i++) {
+            const int u = 6 * half + i, v = 6 * half + (i + 1) % 6;
+            x[xpos(u, v, n)] = 1.0;
+            subtour_cost += costs[u * n + v];
+        }
+    }
+
+    int adj[24];
+    int tour[13];
+    assert(subtour_adjacency_from_x(x, n, adj));
+
+    SubtourPatcher *patcher = subtour_patcher_create(n);
+    CandidateLists *candidates = candidate_lists_create(costs, n, 4);
+    const double delta = subtour_patcher_merge(patcher, adj, costs, candidates);
+    subtour_adjacency_to_tour(adj, n, tour);
+    assert_valid_tour(tour, n);
+
+    const double cost = calculate_tour_cost(tour, n, costs);
+    assert(fabs(subtour_cost + delta - cost) < 1e-6);
+    assert(fabs(cost - n * costs[1]) < 1e-6);
+
+    candidate_lists_destroy(candidates);
+    subtour_patcher_destroy(patcher);
+    tsp_free(x);
+    tsp_instance_destroy(inst);
+}
+
+static void test_adjacency_rejects_degree_three(void) {
+    printf("  [Patching] Testing rejection of a node of degree 3...\n");
+    const int n = 5;
+    double x[10] = {0};
+    x[xpos(0, 1, n)] = 1.0;
+    x[xpos(0, 2, n)] = 1.0;
+    x[xpos(0, 3, n)] = 1.0;
+    int adj[10];
+    assert(!subtour_adjacency_from_x(x, n, adj));
+}
+
+static void test_improve_random_tour(void) {
+    printf("  [Patching] Testing 2-opt/Or-opt polish of a random tour (100 nodes)...\n");
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = 100;
+
+    RandomState rng;
+    random_init(&rng, 11);
+    int tour[101];
+    for (int i = 0; i < n; i++) tour[i] = i;
+    shuffle_int_array(tour, n, &rng);
+    tour[n] = tour[0];
+    const double before = calculate_tour_cost(tour, n, costs);
+
+    SubtourPatcher *patcher = subtour_patcher_create(n);
+    CandidateLists *candidates = candidate_lists_create(costs, n, 10);
+    const double delta = subtour_patcher_improve(patcher, tour, costs, candidates);
+    assert_valid_tour(tour, n);
+
+    const double after = calculate_tour_cost(tour, n, costs);
+    assert(delta < 0.0);
+    assert(fabs(before + delta - after) < 1e-6 * before);
+    // A random tour is several times longer than a local optimum
+    assert(after < 0.5 * before);
+
+    // A local optimum stays put
+    assert(subtour_patcher_improve(patcher, tour, costs, candidates) == 0.0);
+
+    candidate_lists_destroy(candidates);
+    subtour_patcher_destroy(patcher);
+    tsp_instance_destroy(inst);
+}
+
+void run_subtour_patching_tests(void) {
+    printf("[Subtour Patching] Running tests...\n");
+    test_patch_two_arcs();
+    test_adjacency_rejects_degree_three();
+    test_improve_random_tour();
+    printf("[Subtour Patching] All tests passed.\n");
+}
@@ -37,6 +37,15 @@ static void test_two_disjoint_triangles(void) {
 
     assert(comp_id_0 != comp_id_3);
 
+    // Bucketed output: both components listed once, nodes in increasing order
+    for (int c = 0; c < cc->num_components; c++) {
+        assert(cc->nodes_in_component[c] == 3);
+        assert(cc->component_start[c + 1] - cc->component_start[c] == 3);
+        const int *nodes = cc->component_nodes + cc->component_start[c];
+        assert(nodes[0] < nodes[1] && nodes[1] < nodes[2]);
+        assert(cc->component_of_node[nodes[0]] == c + 1);
+    }
+
     connected_components_destroy(cc);
     tsp_free(x_star);
 }
@@ -65,9 +74,56 @@ static void test_single_tour(void) {
     tsp_free(x_star);
 }
 
+static void test_sparse_triangles(void) {
+    printf("  [Subtour] Testing 2 triangles given edge by edge (6 nodes)...\n");
+    const int n = 6;
+    // Triangles 0-1-2 and 3-4-5, and a zero edge between them
+    const int edge_u[] = {0, 1, 0, 3, 4, 3, 2};
+    const int edge_v[] = {1, 2, 2, 4, 5, 5, 3};
+    const double x[] = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0};
+
+    ConnectedComponents *cc = connected_components_create(n);
+    find_connected_components_sparse(cc, n, edge_u, edge_v, x, 7);
+
+    assert(cc->num_components == 2);
+    assert(cc->component_of_node[0] == cc->component_of_node[2]);
+    assert(cc->component_of_node[3] == cc->component_of_node[5]);
+    assert(cc->component_of_node[2] != cc->component_of_node[3]);
+    assert(cc->nodes_in_component[0] == 3 && cc->nodes_in_component[1] == 3);
+
+    connected_components_destroy(cc);
+}
+
+static void test_sparse_all_selected(void) {
+    printf("  [Subtour] Testing interleaved cycles with every edge selected (7 nodes)...\n");
+    const int n = 7;
+    // Cycles 0-4-2-6 and 5-1-3, listed as tour edges: no x, every edge is taken
+    const int edge_u[] = {0, 4, 2, 6, 5, 1, 3};
+    const int edge_v[] = {4, 2, 6, 0, 1, 3, 5};
+
+    ConnectedComponents *cc = connected_components_create(n);
+    find_connected_components_sparse(cc, n, edge_u, edge_v, NULL, 7);
+
+    // Components are numbered by smallest node and their nodes come out in increasing order
+    const int expected[] = {0, 2, 4, 6, 1, 3, 5};
+    assert(cc->num_components == 2);
+    assert(cc->component_of_node[0] == 1 && cc->component_of_node[1] == 2);
+    assert(cc->component_start[0] == 0 && cc->component_start[1] == 4 && cc->component_start[2] == 7);
+    for (int i = 0; i < n; i++) assert(cc->component_nodes[i] == expected[i]);
+
+    // The same structure serves a second call
+    find_connected_components_sparse(cc, n, edge_u, edge_v, NULL, 3);
+    assert(cc->num_components == 4); // path 0-4-2-6 and the singletons 1, 3, 5
+    assert(cc->nodes_in_component[0] == 4);
+
+    connected_components_destroy(cc);
+}
+
 void run_subtour_separator_tests(void) {
     printf("[Subtour Separator] Running tests...\n");
     test_two_disjoint_triangles();
     test_single_tour();
+    test_sparse_triangles();
+    test_sparse_all_selected();
     printf("[Subtour Separator] All tests passed.\n");
 }
\ No newline at end of file
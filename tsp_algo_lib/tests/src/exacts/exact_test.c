@@ -3,13 +3,14 @@
 #include "branch_and_cut.h"
 #include "tsp_solution.h"
 #include "cost_recorder.h"
+#include "mip_backend.h"
 #include "feasibility_result.h"
 #include <assert.h>
 #include <stdio.h>
 #include <math.h>
 
 static void test_benders_burma14(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [Exact] Testing Benders on Burma14...\n");
     TspInstance *inst = create_burma14_instance();
     TspSolution *sol = tsp_solution_create(inst);
@@ -34,7 +35,7 @@ static void test_benders_burma14(void) {
 }
 
 static void test_benders_geometric(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [Exact] Testing Benders on Geometric (Square)...\n");
     TspInstance *inst = create_square_instance();
     TspSolution *sol = tsp_solution_create(inst);
@@ -56,7 +57,7 @@ static void test_benders_geometric(void) {
 }
 
 static void test_benders_fallback_timeout(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [Exact] Testing Benders Fallback (Random 100 + Timeout)...\n");
     TspInstance *inst = create_random_instance_100();
     TspSolution *sol = tsp_solution_create(inst);
@@ -83,7 +84,7 @@ static void test_benders_fallback_timeout(void) {
 }
 
 static void test_bc_burma14(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [Exact] Testing Branch & Cut on Burma14...\n");
     TspInstance *inst = create_burma14_instance();
     TspSolution *sol = tsp_solution_create(inst);
@@ -108,7 +109,7 @@ static void test_bc_burma14(void) {
 }
 
 static void test_bc_geometric(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [Exact] Testing Branch & Cut on Geometric (Hexagon)...\n");
     TspInstance *inst = create_hexagon_instance();
     TspSolution *sol = tsp_solution_create(inst);
@@ -130,7 +131,7 @@ static void test_bc_geometric(void) {
 }
 
 static void test_bc_fallback_timeout(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [Exact] Testing B&C Fallback (Random 100 + Timeout)...\n");
     TspInstance *inst = create_random_instance_100();
     TspSolution *sol = tsp_solution_create(inst);
@@ -156,9 +157,35 @@ static void test_bc_fallback_timeout(void) {
 #endif
 }
 
+static void test_mip_backend_default(void) {
+    printf("  [Exact] Testing MIP backend selection...\n");
+    const MipBackend *mip = mip_backend_default();
+#if defined(ENABLE_CPLEX)
+    assert(mip == &CPLEX_MIP_BACKEND);
+#elif defined(ENABLE_GLPK)
+    assert(mip == &GLPK_MIP_BACKEND);
+#else
+    assert(mip == NULL);
+
+    // Without a solver Benders leaves the solution untouched
+    TspInstance *inst = create_burma14_instance();
+    TspSolution *sol = tsp_solution_create(inst);
+    const double before = tsp_solution_get_cost(sol);
+    BendersConfig cfg = {.max_iterations = 10, .time_limit = 1.0};
+    TspAlgorithm algo = benders_create(cfg);
+    tsp_algorithm_run(&algo, inst, sol, NULL);
+    assert(tsp_solution_get_cost(sol) == before);
+
+    tsp_algorithm_destroy(&algo);
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+#endif
+}
+
 void run_exact_tests(void) {
     printf("[Exact Algorithms] Running tests...\n");
-#ifdef ENABLE_CPLEX
+    test_mip_backend_default();
+#ifdef MIP_BACKEND_AVAILABLE
     test_benders_burma14();
     test_benders_geometric();
     test_benders_fallback_timeout();
@@ -166,7 +193,7 @@ void run_exact_tests(void) {
     test_bc_geometric();
     test_bc_fallback_timeout();
 #else
-    printf("  [SKIP] CPLEX not enabled.\n");
+    printf("  [SKIP] No MIP solver enabled.\n");
 #endif
     printf("[Exact Algorithms] All tests passed.\n");
 }
\ No newline at end of file
@@ -2,13 +2,16 @@
 #include "hard_fixing.h"
 #include "tsp_solution.h"
 #include "cost_recorder.h"
+#include "mip_backend.h"
 #include "feasibility_result.h"
 #include <assert.h>
 #include <stdio.h>
 #include <math.h>
+#include "variable_neighborhood_search.h"
+#include "c_util.h"
 
 static void test_hard_fixing_burma14(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [HardFixing] Testing Burma14...\n");
     TspInstance *inst = create_burma14_instance();
     TspSolution *sol = tsp_solution_create(inst);
@@ -41,7 +44,7 @@ static void test_hard_fixing_burma14(void) {
 }
 
 static void test_hard_fixing_hexagon(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [HardFixing] Testing Hexagon...\n");
     TspInstance *inst = create_hexagon_instance();
     TspSolution *sol = tsp_solution_create(inst);
@@ -74,7 +77,7 @@ static void test_hard_fixing_hexagon(void) {
 }
 
 static void test_hard_fixing_random_100(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [HardFixing] Testing Random 100...\n");
     TspInstance *inst = create_random_instance_100();
     TspSolution *sol = tsp_solution_create(inst);
@@ -103,14 +106,46 @@ static void test_hard_fixing_random_100(void) {
 #endif
 }
 
+static void test_hard_fixing_clone_config(void) {
+    printf("  [HardFixing] Testing worker configs (seeds, fixing rates, own heuristic args and seeds)...\n");
+    VNSConfig *args = tsp_malloc(sizeof(VNSConfig));
+    *args = (VNSConfig){.min_k = 3, .max_k = 10, .kick_repetition = 1, .max_stagnation = 50, .seed = 7};
+    HardFixingConfig cfg = {
+        .time_limit = 1.0,
+        .fixing_rate = 0.9,
+        .heuristic_type = VNS,
+        .seed = 42,
+        .heuristic_args = args,
+        .num_workers = 4
+    };
+
+    TspAlgorithm hf = hard_fixing_create(cfg);
+    assert(hf.clone_config != NULL);
+    for (uint64_t i = 0; i < 4; i++) {
+        HardFixingConfig *clone = hf.clone_config(hf.config, i);
+        assert(clone->seed == 42 + i);
+        assert(fabs(clone->fixing_rate - (0.9 - 0.1 * (double) (i % 3))) < 1e-12);
+        assert(clone->num_workers == 4);
+        // Each clone frees its own copy of the warm-start arguments, whose seed moves with the worker
+        assert(clone->heuristic_args != args);
+        const VNSConfig *clone_args = clone->heuristic_args;
+        assert(clone_args->seed == 7 + i);
+        assert(clone_args->max_stagnation == args->max_stagnation && clone_args->max_k == args->max_k);
+        hf.free_config(clone);
+    }
+
+    tsp_algorithm_destroy(&hf);
+}
+
 void run_hard_fixing_tests(void) {
     printf("[Hard Fixing] Running tests...\n");
-#ifdef ENABLE_CPLEX
+    test_hard_fixing_clone_config();
+#ifdef MIP_BACKEND_AVAILABLE
     test_hard_fixing_burma14();
     test_hard_fixing_hexagon();
     test_hard_fixing_random_100();
 #else
-    printf("  [SKIP] CPLEX not enabled.\n");
+    printf("  [SKIP] No MIP solver enabled.\n");
 #endif
     printf("[Hard Fixing] All tests passed.\n");
 }
\ No newline at end of file
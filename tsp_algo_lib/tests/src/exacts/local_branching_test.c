@@ -2,13 +2,14 @@
 #include "local_branching.h"
 #include "tsp_solution.h"
 #include "cost_recorder.h"
+#include "mip_backend.h"
 #include "feasibility_result.h"
 #include <assert.h>
 #include <stdio.h>
 #include <math.h>
 
 static void test_lb_burma14(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [LocalBranching] Testing Burma14...\n");
     TspInstance *inst = create_burma14_instance();
     TspSolution *sol = tsp_solution_create(inst);
@@ -40,7 +41,7 @@ static void test_lb_burma14(void) {
 }
 
 static void test_lb_hexagon(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [LocalBranching] Testing Hexagon...\n");
     TspInstance *inst = create_hexagon_instance();
     TspSolution *sol = tsp_solution_create(inst);
@@ -71,7 +72,7 @@ static void test_lb_hexagon(void) {
 }
 
 static void test_lb_random_100(void) {
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     printf("  [LocalBranching] Testing Random 100...\n");
     TspInstance *inst = create_random_instance_100();
     TspSolution *sol = tsp_solution_create(inst);
@@ -100,12 +101,12 @@ static void test_lb_random_100(void) {
 
 void run_local_branching_tests(void) {
     printf("[Local Branching] Running tests...\n");
-#ifdef ENABLE_CPLEX
+#ifdef MIP_BACKEND_AVAILABLE
     test_lb_burma14();
     test_lb_hexagon();
     test_lb_random_100();
 #else
-    printf("  [SKIP] CPLEX not enabled.\n");
+    printf("  [SKIP] No MIP solver enabled.\n");
 #endif
     printf("[Local Branching] All tests passed.\n");
 }
\ No newline at end of file
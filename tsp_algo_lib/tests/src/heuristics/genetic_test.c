@@ -43,6 +43,151 @@ static void test_genetic_burma14(void) {
     tsp_instance_destroy(inst);
 }
 
+static void test_genetic_eax_burma14(void) {
+    printf("  [Genetic] Testing Burma14 with EAX...\n");
+    TspInstance *inst = create_burma14_instance();
+    TspSolution *sol = tsp_solution_create(inst);
+
+    GeneticConfig config = {
+        .time_limit = TIME_LIMIT_HEURISTIC,
+        .population_size = 50,
+        .elite_count = 2,
+        .mutation_rate = 0.0,
+        .init_grasp_rcl_size = 5,
+        .init_grasp_prob = 0.2,
+        .init_grasp_percent = 50,
+        .tournament_size = 3,
+        .crossover = GA_CROSSOVER_EAX,
+        .seed = 42
+    };
+
+    TspAlgorithm ga = genetic_create(config);
+    tsp_algorithm_run(&ga, inst, sol, NULL);
+
+    assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+    assert(fabs(tsp_solution_get_cost(sol) - BURMA14_OPT_COST) < EPSILON_HEURISTIC);
+
+    tsp_algorithm_destroy(&ga);
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+}
+
+static void test_genetic_parallel_offspring(void) {
+    printf("  [Genetic] Testing Parallel Offspring Generation...\n");
+    TspInstance *inst = create_burma14_instance();
+
+    const GeneticCrossover crossovers[] = {GA_CROSSOVER_CUT, GA_CROSSOVER_EAX};
+    for (int c = 0; c < 2; c++) {
+        TspSolution *sol = tsp_solution_create(inst);
+        GeneticConfig config = {
+            .time_limit = 1.0,
+            .population_size = 60,
+            .elite_count = 2,
+            .mutation_rate = 0.05,
+            .crossover_cut_min_ratio = 25,
+            .crossover_cut_max_ratio = 75,
+            .init_grasp_rcl_size = 5,
+            .init_grasp_prob = 0.2,
+            .init_grasp_percent = 50,
+            .tournament_size = 3,
+            .crossover = crossovers[c],
+            .num_threads = 4,
+            .seed = 7
+        };
+
+        TspAlgorithm ga = genetic_create(config);
+        tsp_algorithm_run(&ga, inst, sol, NULL);
+
+        assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+        assert(fabs(tsp_solution_get_cost(sol) - BURMA14_OPT_COST) < EPSILON_HEURISTIC);
+
+        tsp_algorithm_destroy(&ga);
+        tsp_solution_destroy(sol);
+    }
+
+    tsp_instance_destroy(inst);
+}
+
+static void test_genetic_dedup(void) {
+    printf("  [Genetic] Testing Deduplication...\n");
+    TspInstance *inst = create_burma14_instance();
+
+    const GeneticCrossover crossovers[] = {GA_CROSSOVER_CUT, GA_CROSSOVER_EAX};
+    for (int c = 0; c < 2; c++) {
+        TspSolution *sol = tsp_solution_create(inst);
+        GeneticConfig config = {
+            .time_limit = 1.0,
+            .population_size = 30,
+            .elite_count = 2,
+            .mutation_rate = 0.05,
+            .crossover_cut_min_ratio = 25,
+            .crossover_cut_max_ratio = 75,
+            .init_grasp_rcl_size = 5,
+            .init_grasp_prob = 0.2,
+            .init_grasp_percent = 50,
+            .tournament_size = 3,
+            .crossover = crossovers[c],
+            .num_threads = 2,
+            .deduplicate = true,
+            .seed = 5
+        };
+
+        TspAlgorithm ga = genetic_create(config);
+        tsp_algorithm_run(&ga, inst, sol, NULL);
+
+        assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+        assert(fabs(tsp_solution_get_cost(sol) - BURMA14_OPT_COST) < EPSILON_HEURISTIC);
+
+        tsp_algorithm_destroy(&ga);
+        tsp_solution_destroy(sol);
+    }
+
+    tsp_instance_destroy(inst);
+}
+
+static void test_genetic_islands(void) {
+    printf("  [Genetic] Testing Island Model...\n");
+    TspInstance *inst = create_burma14_instance();
+
+    const MigrationTopology topologies[] = {MIGRATION_RING, MIGRATION_RANDOM};
+    for (int t = 0; t < 2; t++) {
+        TspSolution *sol = tsp_solution_create(inst);
+        CostRecorder *rec = cost_recorder_create(10);
+        GeneticConfig config = {
+            .time_limit = 1.0,
+            .population_size = 20,
+            .elite_count = 1,
+            .mutation_rate = 0.05,
+            .crossover_cut_min_ratio = 25,
+            .crossover_cut_max_ratio = 75,
+            .init_grasp_rcl_size = 5,
+            .init_grasp_prob = 0.2,
+            .init_grasp_percent = 50,
+            .tournament_size = 3,
+            .crossover = GA_CROSSOVER_EAX,
+            .num_islands = 4,
+            .migration_interval = 2,
+            .migration_count = 2,
+            .migration_topology = topologies[t],
+            .deduplicate = t == 1,
+            .seed = 11
+        };
+
+        TspAlgorithm ga = genetic_create(config);
+        tsp_algorithm_run(&ga, inst, sol, rec);
+
+        assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+        assert(fabs(tsp_solution_get_cost(sol) - BURMA14_OPT_COST) < EPSILON_HEURISTIC);
+        assert(cost_recorder_get_count(rec) > 0);
+
+        tsp_algorithm_destroy(&ga);
+        cost_recorder_destroy(rec);
+        tsp_solution_destroy(sol);
+    }
+
+    tsp_instance_destroy(inst);
+}
+
 static void test_genetic_circle(void) {
     printf("  [Genetic] Testing Circle (Geometric)...\n");
     TspInstance *inst = create_circle_instance(20, 100.0);
@@ -114,6 +259,10 @@ static void test_genetic_random_100(void) {
 void run_genetic_tests(void) {
     printf("[Genetic] Running tests...\n");
     test_genetic_burma14();
+    test_genetic_eax_burma14();
+    test_genetic_parallel_offspring();
+    test_genetic_dedup();
+    test_genetic_islands();
     test_genetic_circle();
     test_genetic_random_100();
     printf("[Genetic] All tests passed.\n");
@@ -37,6 +37,63 @@ static void test_grasp_burma14(void) {
     tsp_instance_destroy(inst);
 }
 
+static void test_grasp_candidate_lists_burma14(void) {
+    printf("  [GRASP] Testing Burma14 with candidate-list construction...\n");
+    TspInstance *inst = create_burma14_instance();
+    TspSolution *sol = tsp_solution_create(inst);
+
+    GraspConfig config = {
+        .time_limit = TIME_LIMIT_HEURISTIC,
+        .rcl_size = 3,
+        .probability = 0.5,
+        .max_stagnation = 50,
+        .seed = 42,
+        .use_candidate_lists = true
+    };
+
+    TspAlgorithm grasp = grasp_create(config);
+    tsp_algorithm_run(&grasp, inst, sol, NULL);
+
+    assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+    assert(fabs(tsp_solution_get_cost(sol) - BURMA14_OPT_COST) < EPSILON_HEURISTIC);
+
+    tsp_algorithm_destroy(&grasp);
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+}
+
+static void test_grasp_dedup_burma14(void) {
+    printf("  [GRASP] Testing Burma14 with deduplication...\n");
+    TspInstance *inst = create_burma14_instance();
+    TspSolution *sol = tsp_solution_create(inst);
+    CostRecorder *rec = cost_recorder_create(10);
+
+    // A greedy construction repeats the same cycles from different starts
+    GraspConfig config = {
+        .time_limit = TIME_LIMIT_HEURISTIC,
+        .rcl_size = 1,
+        .probability = 0.0,
+        .max_stagnation = 100,
+        .seed = 42,
+        .elite_size = 4,
+        .elite_min_diversity = 0.05,
+        .relinking = RELINK_BOTH,
+        .deduplicate = true
+    };
+
+    TspAlgorithm grasp = grasp_create(config);
+    tsp_algorithm_run(&grasp, inst, sol, rec);
+
+    assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+    // Skipped iterations still record the cost of their known local optimum
+    assert(cost_recorder_get_count(rec) == (size_t) BURMA14_SIZE);
+
+    tsp_algorithm_destroy(&grasp);
+    cost_recorder_destroy(rec);
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+}
+
 static void test_grasp_square(void) {
     printf("  [GRASP] Testing Square...\n");
     TspInstance *inst = create_square_instance();
@@ -122,11 +179,52 @@ static void test_grasp_reproducibility(void) {
     tsp_instance_destroy(inst);
 }
 
+static void test_grasp_path_relinking_shared_pool(void) {
+    printf("  [GRASP] Testing Path Relinking with a Shared Elite Pool...\n");
+    TspInstance *inst = create_random_instance_100();
+    TspSolution *sol = tsp_solution_create(inst);
+
+    GraspConfig config = {
+        .time_limit = TIME_LIMIT_HEURISTIC,
+        .rcl_size = 5,
+        .probability = 0.3,
+        .max_stagnation = 30,
+        .seed = 12345,
+        .elite_size = 8,
+        .elite_min_diversity = 0.05,
+        .relinking = RELINK_BOTH
+    };
+
+    TspAlgorithm grasp = grasp_create(config);
+    const GraspConfig *created = grasp.config;
+    assert(created->elite_pool != NULL);
+
+    // Two clones, as execute_parallel would make, feed the same pool
+    for (uint64_t i = 0; i < 2; i++) {
+        GraspConfig *clone = grasp.clone_config(grasp.config, i);
+        assert(clone->elite_pool == created->elite_pool);
+        grasp.run(inst, sol, clone, NULL);
+        grasp.free_config(clone);
+    }
+
+    const int pool_size = elite_pool_size(created->elite_pool);
+    printf("    Cost: %.4f, elite pool size: %d\n", tsp_solution_get_cost(sol), pool_size);
+    assert(pool_size > 1 && pool_size <= 8);
+    assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+
+    tsp_algorithm_destroy(&grasp);
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+}
+
 void run_grasp_tests(void) {
     printf("[GRASP] Running tests...\n");
     test_grasp_burma14();
+    test_grasp_candidate_lists_burma14();
+    test_grasp_dedup_burma14();
     test_grasp_square();
     test_grasp_random_100();
     test_grasp_reproducibility();
+    test_grasp_path_relinking_shared_pool();
     printf("[GRASP] All tests passed.\n");
 }
\ No newline at end of file
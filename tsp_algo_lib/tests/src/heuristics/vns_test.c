@@ -6,6 +6,11 @@
 #include "tsp_solution.h"
 #include "cost_recorder.h"
 #include "feasibility_result.h"
+#include "cancel_token.h"
+#include "chrono.h"
+#include "tsp_algorithm.h"
+#include <stdatomic.h>
+#include <time.h>
 
 static void test_vns_burma14(void) {
     printf("  [VNS] Testing Burma14...\n");
@@ -94,10 +99,147 @@ static void test_vns_random_100(void) {
     tsp_instance_destroy(inst);
 }
 
+static void test_vns_double_bridge_kicks(void) {
+    printf("  [VNS] Testing Burma14 with Double-Bridge Kicks...\n");
+    TspInstance *inst = create_burma14_instance();
+
+    const KickType kicks[] = {KICK_DOUBLE_BRIDGE, KICK_NEAR_DOUBLE_BRIDGE, KICK_SEGMENT_REVERSAL};
+    for (size_t i = 0; i < sizeof(kicks) / sizeof(kicks[0]); i++) {
+        TspSolution *sol = tsp_solution_create(inst);
+
+        VNSConfig config = {
+            .time_limit = TIME_LIMIT_HEURISTIC,
+            .min_k = 4,
+            .max_k = 8,
+            .kick_repetition = 1,
+            .max_stagnation = 50,
+            .kick_type = kicks[i],
+            .seed = 42
+        };
+
+        TspAlgorithm vns = vns_create(config);
+        tsp_algorithm_run(&vns, inst, sol, NULL);
+
+        assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+        double cost = tsp_solution_get_cost(sol);
+        printf("    %s cost: %.4f (Opt: %.4f)\n", kick_type_to_string(kicks[i]), cost, BURMA14_OPT_COST);
+        assert(fabs(cost - BURMA14_OPT_COST) < EPSILON_HEURISTIC);
+
+        tsp_algorithm_destroy(&vns);
+        tsp_solution_destroy(sol);
+    }
+
+    tsp_instance_destroy(inst);
+}
+
+static int improvements;
+
+static void count_improvement(const int *tour, int n, double cost, void *user_data) {
+    (void) tour;
+    (void) n;
+    (void) cost;
+    (void) user_data;
+    improvements++;
+}
+
+static void test_vns_cancelled(void) {
+    printf("  [VNS] Testing cancellation and improvement listener...\n");
+    TspInstance *inst = create_random_instance_100();
+    TspSolution *sol = tsp_solution_create(inst);
+    CancelToken *token = cancel_token_create();
+
+    improvements = 0;
+    tsp_solution_set_listener(sol, count_improvement, NULL);
+    tsp_solution_set_cancel_token(sol, token);
+    cancel_token_cancel(token);
+
+    VNSConfig config = {
+        .time_limit = 60.0,
+        .min_k = 3,
+        .max_k = 5,
+        .kick_repetition = 1,
+        .max_stagnation = 1000000,
+        .seed = 42
+    };
+    TspAlgorithm vns = vns_create(config);
+
+    const double start = second();
+    tsp_algorithm_run(&vns, inst, sol, NULL);
+    // A cancelled token ends the run at the first time check, long before the 60 s limit
+    assert(second() - start < 1.0);
+    assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+    // The identity tour still gets published once by the final update
+    assert(improvements <= 1);
+
+    cancel_token_reset(token);
+    config.time_limit = 0.2;
+    TspAlgorithm short_vns = vns_create(config);
+    tsp_algorithm_run(&short_vns, inst, sol, NULL);
+    assert(improvements >= 1);
+
+    tsp_algorithm_destroy(&short_vns);
+    tsp_algorithm_destroy(&vns);
+    cancel_token_destroy(token);
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+}
+
+static void count_async_improvement(const int *tour, int n, double cost, void *user_data) {
+    (void) tour;
+    (void) n;
+    (void) cost;
+    atomic_fetch_add((atomic_int *) user_data, 1);
+}
+
+static void test_vns_async(void) {
+    printf("  [VNS] Testing asynchronous start, poll and cancel...\n");
+    TspInstance *inst = create_random_instance_100();
+    TspSolution *sol = tsp_solution_create(inst);
+    atomic_int count;
+    atomic_init(&count, 0);
+
+    VNSConfig config = {
+        .time_limit = 60.0,
+        .min_k = 3,
+        .max_k = 5,
+        .kick_repetition = 1,
+        .max_stagnation = 1000000,
+        .seed = 42
+    };
+    TspAlgorithm vns = vns_create(config);
+
+    const double start = second();
+    TspSolveHandle *handle = tsp_algorithm_start(&vns, inst, sol, NULL, count_async_improvement, &count);
+    assert(handle != NULL);
+
+    // The caller keeps running while the solver publishes incumbents
+    const struct timespec pause = {.tv_sec = 0, .tv_nsec = 10 * 1000 * 1000};
+    while (atomic_load(&count) == 0 && second() - start < 5.0)
+        nanosleep(&pause, NULL);
+    assert(atomic_load(&count) > 0);
+    assert(!tsp_solve_poll(handle));
+
+    tsp_solve_cancel(handle);
+    tsp_solve_wait(handle);
+    assert(tsp_solve_poll(handle));
+    assert(second() - start < 10.0);
+    assert(tsp_solution_check_feasibility(sol) == FEASIBLE);
+
+    tsp_solve_destroy(handle);
+    assert(tsp_solution_get_cancel_token(sol) == NULL);
+
+    tsp_algorithm_destroy(&vns);
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+}
+
 void run_vns_tests(void) {
     printf("[VNS] Running tests...\n");
     test_vns_burma14();
     test_vns_hexagon();
     test_vns_random_100();
+    test_vns_double_bridge_kicks();
+    test_vns_cancelled();
+    test_vns_async();
     printf("[VNS] All tests passed.\n");
 }
\ No newline at end of file
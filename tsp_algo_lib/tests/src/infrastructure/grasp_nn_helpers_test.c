@@ -21,7 +21,7 @@ static void test_grasp_helper_basic_square(void) {
     double cost = 0.0;
 
     // RCL=1 makes it deterministic NN
-    int res = grasp_nearest_neighbor_tour(0, tour, n, costs, &cost, 1, 0.0, &rng);
+    int res = grasp_nearest_neighbor_tour(0, tour, n, costs, &cost, 1, 0.0, &rng, NULL);
 
     assert(res == 0);
     assert(tour[0] == 0);
@@ -43,19 +43,79 @@ static void test_grasp_helper_invalid_input(void) {
     double cost;
 
     // Invalid start node
-    assert(grasp_nearest_neighbor_tour(-1, tour, n, costs, &cost, 3, 0.5, &rng) == -1);
-    assert(grasp_nearest_neighbor_tour(4, tour, n, costs, &cost, 3, 0.5, &rng) == -1); // Index 4 is out of 0-3
+    assert(grasp_nearest_neighbor_tour(-1, tour, n, costs, &cost, 3, 0.5, &rng, NULL) == -1);
+    assert(grasp_nearest_neighbor_tour(4, tour, n, costs, &cost, 3, 0.5, &rng, NULL) == -1); // Index 4 is out of 0-3
 
     // Invalid RCL size
-    assert(grasp_nearest_neighbor_tour(0, tour, n, costs, &cost, 0, 0.5, &rng) == -1);
+    assert(grasp_nearest_neighbor_tour(0, tour, n, costs, &cost, 0, 0.5, &rng, NULL) == -1);
 
     tsp_instance_destroy(inst);
 }
 
+static void test_grasp_candidate_tour_matches_nn(void) {
+    printf("  [GRASP Helper] Testing candidate-list construction against NN...\n");
+
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = tsp_instance_get_num_nodes(inst);
+    const CandidateLists *candidates = tsp_instance_get_candidate_lists(inst);
+    GraspWorkspace *ws = grasp_workspace_create(tsp_instance_get_nodes(inst), n, 5);
+
+    int nn_tour[101], cl_tour[101];
+    double nn_cost, cl_cost;
+
+    // Without randomization both builders follow the nearest unvisited node, including the grid fallback
+    for (int start = 0; start < n; start += 11) {
+        assert(nearest_neighbor_tour(start, nn_tour, n, costs, &nn_cost) == 0);
+        assert(grasp_candidate_tour(start, cl_tour, n, costs, candidates, &cl_cost, 5, 0.0, &rng, ws) == 0);
+        assert(fabs(nn_cost - cl_cost) < EPSILON_EXACT);
+        for (int i = 0; i <= n; i++)
+            assert(nn_tour[i] == cl_tour[i]);
+    }
+
+    grasp_workspace_destroy(ws);
+    tsp_instance_destroy(inst);
+}
+
+static void test_grasp_candidate_tour_randomized(void) {
+    printf("  [GRASP Helper] Testing randomized candidate-list construction...\n");
+
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = tsp_instance_get_num_nodes(inst);
+    const CandidateLists *candidates = tsp_instance_get_candidate_lists(inst);
+    GraspWorkspace *ws = grasp_workspace_create(tsp_instance_get_nodes(inst), n, 10);
+
+    int tour[101];
+    double cost;
+
+    // The workspace is reused across constructions
+    for (int iter = 0; iter < 5; iter++) {
+        assert(grasp_candidate_tour(iter, tour, n, costs, candidates, &cost, 10, 0.7, &rng, ws) == 0);
+        assert(tour[0] == iter);
+        assert(tour[n] == tour[0]);
+
+        int seen[100] = {0};
+        for (int i = 0; i < n; i++) {
+            assert(seen[tour[i]] == 0);
+            seen[tour[i]] = 1;
+        }
+        assert(fabs(cost - calculate_tour_cost(tour, n, costs)) < EPSILON_EXACT);
+    }
+
+    assert(grasp_candidate_tour(-1, tour, n, costs, candidates, &cost, 3, 0.5, &rng, ws) == -1);
+    assert(grasp_candidate_tour(0, tour, n, costs, candidates, &cost, 0, 0.5, &rng, ws) == -1);
+
+    grasp_workspace_destroy(ws);
+    tsp_instance_destroy(inst);
+}
+
 void run_grasp_nn_helpers_tests(void) {
     printf("[GRASP Helper] Running tests...\n");
     random_init(&rng, 12345);
     test_grasp_helper_basic_square();
     test_grasp_helper_invalid_input();
+    test_grasp_candidate_tour_matches_nn();
+    test_grasp_candidate_tour_randomized();
     printf("[GRASP Helper] All tests passed.\n");
 }
\ No newline at end of file
@@ -6,7 +6,15 @@
 #include "tsp_math.h"
 #include "tsp_solution.h"
 #include "cost_recorder.h"
+#include "spatial_grid.h"
+#include "arena.h"
+#include "tour_hash.h"
+#include "local_search.h"
+#include <pthread.h>
 #include "c_util.h"
+#include "time_limiter.h"
+#include "cancel_token.h"
+#include "chrono.h"
 
 static void test_euclidean_distance(void) {
     printf("\t[Utility] Testing Euclidean calculation...\n");
@@ -57,6 +65,29 @@ static void test_solution_update_logic(void) {
     tsp_instance_destroy(inst);
 }
 
+static void test_solution_fetch_if_better(void) {
+    printf("\t[Utility] Testing Solution Fetch If Better...\n");
+    TspInstance *inst = create_square_instance();
+    TspSolution *sol = tsp_solution_create(inst);
+    const double stored_cost = tsp_solution_get_cost(sol);
+
+    int buffer[] = {-1, -1, -1, -1, -1};
+    double cost = stored_cost - 1.0;
+    bool fetched = tsp_solution_fetch_if_better(sol, buffer, &cost);
+    assert(fetched == false);
+    assert(buffer[0] == -1);
+    assert(fabs(cost - (stored_cost - 1.0)) < EPSILON_EXACT);
+
+    cost = stored_cost + 10.0;
+    fetched = tsp_solution_fetch_if_better(sol, buffer, &cost);
+    assert(fetched == true);
+    assert(fabs(cost - stored_cost) < EPSILON_EXACT);
+    assert(buffer[0] == buffer[4]);
+
+    tsp_solution_destroy(sol);
+    tsp_instance_destroy(inst);
+}
+
 static void test_recorder_resize(void) {
     printf("\t[Utility] Testing CostRecorder resize...\n");
     CostRecorder *rec = cost_recorder_create(2);
@@ -69,11 +100,357 @@ static void test_recorder_resize(void) {
     cost_recorder_destroy(rec);
 }
 
+static void test_recorder_bounds(void) {
+    printf("\t[Utility] Testing CostRecorder bounds and events...\n");
+    CostRecorder *rec = cost_recorder_create(4);
+    cost_recorder_set_bounds(rec, COST_RECORD_ALL, 100);
+    for (int i = 0; i < 10000; i++) {
+        cost_recorder_add(rec, 1000.0 + (double) (i % 7));
+    }
+    cost_recorder_add(rec, 1.0);
+    const size_t count = cost_recorder_get_count(rec);
+    assert(count <= 100 && count >= 25);
+    // The last improvement always survives downsampling
+    assert(fabs(cost_recorder_get_costs(rec)[count - 1] - 1.0) < EPSILON_EXACT);
+    assert(cost_recorder_get_events(rec)[count - 1] == COST_EVENT_IMPROVEMENT);
+    assert(cost_recorder_get_events(rec)[0] == COST_EVENT_IMPROVEMENT);
+    assert(cost_recorder_get_events(rec)[1] == COST_EVENT_ITERATION);
+    cost_recorder_destroy(rec);
+
+    rec = cost_recorder_create(4);
+    cost_recorder_set_bounds(rec, COST_RECORD_IMPROVEMENTS, 0);
+    const double costs[] = {10.0, 12.0, 9.0, 9.0, 11.0, 8.0};
+    for (int i = 0; i < 6; i++) cost_recorder_add(rec, costs[i]);
+    cost_recorder_add_event(rec, 8.0, COST_EVENT_FINAL);
+    assert(cost_recorder_get_count(rec) == 4);
+    assert(fabs(cost_recorder_get_costs(rec)[2] - 8.0) < EPSILON_EXACT);
+    assert(cost_recorder_get_events(rec)[3] == COST_EVENT_FINAL);
+    cost_recorder_destroy(rec);
+}
+
+/* Adds `iterations` non improving costs after each of `improvements` improvements below `best`. */
+static void add_bounded_run(CostRecorder *rec, const int improvements, const int iterations, const double best) {
+    for (int k = 0; k < improvements; k++) {
+        cost_recorder_add(rec, best - (double) k);
+        for (int i = 0; i < iterations; i++) cost_recorder_add(rec, 2.0 * best);
+    }
+}
+
+static size_t count_events(const CostRecorder *rec, const CostEvent event) {
+    size_t n = 0;
+    for (size_t i = 0; i < cost_recorder_get_count(rec); i++)
+        if (cost_recorder_get_events(rec)[i] == event) n++;
+    return n;
+}
+
+static void test_recorder_bounds_keep_improvements(void) {
+    printf("\t[Utility] Testing CostRecorder bounds keep every improvement...\n");
+    CostRecorder *rec = cost_recorder_create(4);
+    cost_recorder_set_bounds(rec, COST_RECORD_ALL, 50);
+    add_bounded_run(rec, 30, 200, 1e6);
+    cost_recorder_add_event(rec, 1e6 - 29.0, COST_EVENT_FINAL);
+    assert(cost_recorder_get_count(rec) <= 50);
+    assert(count_events(rec, COST_EVENT_IMPROVEMENT) == 30);
+    assert(count_events(rec, COST_EVENT_FINAL) == 1);
+    assert(count_events(rec, COST_EVENT_ITERATION) >= 2);
+
+    // Improvements alone beyond the bound: the recorder grows past it instead of losing any
+    CostRecorder *over = cost_recorder_create(4);
+    cost_recorder_set_bounds(over, COST_RECORD_ALL, 16);
+    add_bounded_run(over, 40, 50, 1e6);
+    assert(count_events(over, COST_EVENT_IMPROVEMENT) == 40);
+    assert(count_events(over, COST_EVENT_ITERATION) <= 2);
+    cost_recorder_destroy(over);
+
+    // Merged children keep theirs too, in time order
+    CostRecorder *first = cost_recorder_create_child(rec, 1);
+    CostRecorder *second = cost_recorder_create_child(rec, 2);
+    add_bounded_run(first, 10, 300, 5e5);
+    add_bounded_run(second, 10, 300, 4e5);
+    cost_recorder_merge(rec, first);
+    cost_recorder_merge(rec, second);
+    assert(count_events(rec, COST_EVENT_IMPROVEMENT) == 50);
+    assert(count_events(rec, COST_EVENT_FINAL) == 1);
+    assert(count_events(rec, COST_EVENT_ITERATION) <= 2);
+    const double *times = cost_recorder_get_times(rec);
+    for (size_t i = 1; i < cost_recorder_get_count(rec); i++) assert(times[i - 1] <= times[i]);
+
+    cost_recorder_destroy(first);
+    cost_recorder_destroy(second);
+    cost_recorder_destroy(rec);
+}
+
+typedef struct {
+    CostRecorder *recorder;
+    int samples;
+} RecorderWorker;
+
+static void *record_samples(void *arg) {
+    const RecorderWorker *w = arg;
+    for (int i = 0; i < w->samples; i++) cost_recorder_add(w->recorder, 1000.0 - i);
+    return NULL;
+}
+
+static void test_recorder_merge_threads(void) {
+    printf("\t[Utility] Testing CostRecorder per-thread merge...\n");
+    CostRecorder *rec = cost_recorder_create(16);
+    RecorderWorker workers[3];
+    pthread_t threads[3];
+    for (int t = 0; t < 3; t++) {
+        workers[t] = (RecorderWorker){.recorder = cost_recorder_create_child(rec, t + 1), .samples = 500};
+        pthread_create(&threads[t], NULL, record_samples, &workers[t]);
+    }
+    int per_thread[4] = {0};
+    for (int t = 0; t < 3; t++) {
+        pthread_join(threads[t], NULL);
+        cost_recorder_merge(rec, workers[t].recorder);
+        cost_recorder_destroy(workers[t].recorder);
+    }
+
+    assert(cost_recorder_get_count(rec) == 1500);
+    const double *times = cost_recorder_get_times(rec);
+    const int *ids = cost_recorder_get_threads(rec);
+    for (size_t i = 0; i < 1500; i++) {
+        if (i > 0) assert(times[i] >= times[i - 1]);
+        assert(ids[i] >= 1 && ids[i] <= 3);
+        per_thread[ids[i]]++;
+    }
+    assert(per_thread[1] == 500 && per_thread[2] == 500 && per_thread[3] == 500);
+    cost_recorder_destroy(rec);
+}
+
+static int brute_force_nearest(const Node *nodes, const int n, const int node, const int *removed) {
+    int best = -1;
+    double best_d2 = INFINITY;
+    for (int i = 0; i < n; i++) {
+        if (i == node || removed[i]) continue;
+        const double dx = nodes[i].x - nodes[node].x;
+        const double dy = nodes[i].y - nodes[node].y;
+        if (dx * dx + dy * dy < best_d2) {
+            best_d2 = dx * dx + dy * dy;
+            best = i;
+        }
+    }
+    return best;
+}
+
+static void test_spatial_grid_nearest(void) {
+    printf("\t[Utility] Testing SpatialGrid nearest queries...\n");
+    TspInstance *inst = create_random_instance_100();
+    const Node *nodes = tsp_instance_get_nodes(inst);
+    const int n = tsp_instance_get_num_nodes(inst);
+    SpatialGrid *grid = spatial_grid_create(nodes, n);
+    int removed[100] = {0};
+
+    // Remove nodes in a scattered order, checking every query against a full scan
+    for (int step = 0; step < n; step++) {
+        const int node = (step * 37) % n;
+        for (int q = 0; q < n; q += 7)
+            assert(spatial_grid_nearest(grid, q) == brute_force_nearest(nodes, n, q, removed));
+        spatial_grid_remove(grid, node);
+        spatial_grid_remove(grid, node); // Double removal is a no-op
+        removed[node] = 1;
+        assert(spatial_grid_count(grid) == n - step - 1);
+    }
+    assert(spatial_grid_nearest(grid, 0) == -1);
+
+    spatial_grid_fill(grid);
+    assert(spatial_grid_count(grid) == n);
+    for (int i = 0; i < n; i++) removed[i] = 0;
+    for (int q = 0; q < n; q++)
+        assert(spatial_grid_nearest(grid, q) == brute_force_nearest(nodes, n, q, removed));
+
+    spatial_grid_destroy(grid);
+    tsp_instance_destroy(inst);
+}
+
+static void test_spatial_grid_collinear(void) {
+    printf("\t[Utility] Testing SpatialGrid on collinear nodes...\n");
+    Node nodes[] = {{0.0, 5.0}, {10.0, 5.0}, {3.0, 5.0}, {7.0, 5.0}, {100.0, 5.0}};
+    SpatialGrid *grid = spatial_grid_create(nodes, 5);
+
+    assert(spatial_grid_nearest(grid, 0) == 2);
+    spatial_grid_remove(grid, 2);
+    assert(spatial_grid_nearest(grid, 0) == 3);
+    assert(spatial_grid_nearest(grid, 4) == 1);
+
+    spatial_grid_destroy(grid);
+}
+
+static void test_arena_rewind(void) {
+    printf("\t[Utility] Testing Arena alignment, growth and rewind...\n");
+    Arena *arena = arena_create(64);
+
+    char *c = arena_alloc(arena, 1);
+    double *d = arena_alloc(arena, sizeof(double));
+    assert(((size_t) d % sizeof(double)) == 0);
+    assert((char *) d != c);
+
+    // Larger than the first block: the arena grows
+    const ArenaMark mark = arena_mark(arena);
+    int *big = arena_calloc(arena, 1000, sizeof(int));
+    for (int i = 0; i < 1000; i++) assert(big[i] == 0);
+    big[999] = 7;
+
+    // Rewinding hands back the same memory without new blocks
+    arena_rewind(arena, mark);
+    int *again = arena_alloc(arena, 1000 * sizeof(int));
+    assert(again == big);
+    assert(again[999] == 7);
+
+    arena_reset(arena);
+    assert(arena_alloc(arena, 1) == c);
+
+    arena_destroy(arena);
+}
+
+static void test_tour_hash_invariance(void) {
+    printf("\t[Utility] Testing tour hash rotation/orientation invariance...\n");
+    const int n = 6;
+    const int tour[] = {0, 1, 2, 3, 4, 5, 0};
+    const int rotated[] = {3, 4, 5, 0, 1, 2, 3};
+    const int reversed[] = {0, 5, 4, 3, 2, 1, 0};
+    const int other[] = {0, 2, 1, 3, 4, 5, 0};
+
+    const uint64_t h = tour_hash(tour, n);
+    assert(tour_hash(rotated, n) == h);
+    assert(tour_hash(reversed, n) == h);
+    assert(tour_hash(other, n) != h);
+
+    // Reversing 1..2 swaps edges (0,1),(2,3) for (0,2),(1,3)
+    assert(tour_hash_two_opt(h, 0, 1, 2, 3) == tour_hash(other, n));
+}
+
+static void test_tour_hash_two_opt_incremental(void) {
+    printf("\t[Utility] Testing incremental tour hash during 2-opt...\n");
+    TspInstance *inst = create_random_instance_100();
+    const double *costs = tsp_instance_get_cost_matrix(inst);
+    const int n = 100;
+    RandomState rng;
+    random_init(&rng, 9);
+
+    int tour[101];
+    for (int i = 0; i < n; i++) tour[i] = i;
+    shuffle_int_array(tour, n, &rng);
+    tour[n] = tour[0];
+
+    TimeLimiter timer = time_limiter_create(10.0);
+    time_limiter_start(&timer);
+    uint64_t hash = tour_hash(tour, n);
+    const uint64_t before = hash;
+    two_opt_hashed(tour, n, costs, timer, &hash);
+    assert(hash != before);
+    assert(hash == tour_hash(tour, n));
+
+    tsp_instance_destroy(inst);
+}
+
+#define HASH_SET_THREADS 4
+#define HASH_SET_KEYS 2000
+
+typedef struct {
+    TourHashSet *set;
+    int offset;
+    int inserted;
+} HashSetWorker;
+
+static void *hash_set_worker(void *arg) {
+    HashSetWorker *w = arg;
+    // Neighboring workers overlap on half of their keys
+    for (int k = 0; k < HASH_SET_KEYS; k++)
+        if (tour_hash_set_insert(w->set, tour_edge_key(w->offset + k, 0))) w->inserted++;
+    return NULL;
+}
+
+static void test_tour_hash_set_concurrent(void) {
+    printf("\t[Utility] Testing concurrent tour hash set...\n");
+    TourHashSet *set = tour_hash_set_create(HASH_SET_THREADS * HASH_SET_KEYS);
+    pthread_t threads[HASH_SET_THREADS];
+    HashSetWorker workers[HASH_SET_THREADS];
+
+    for (int t = 0; t < HASH_SET_THREADS; t++) {
+        workers[t] = (HashSetWorker){.set = set, .offset = t * HASH_SET_KEYS / 2 + 1, .inserted = 0};
+        assert(pthread_create(&threads[t], NULL, hash_set_worker, &workers[t]) == 0);
+    }
+    int inserted = 0;
+    for (int t = 0; t < HASH_SET_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        inserted += workers[t].inserted;
+    }
+
+    // Every distinct key is inserted exactly once
+    assert(inserted == (HASH_SET_THREADS + 1) * HASH_SET_KEYS / 2);
+    assert(tour_hash_set_contains(set, tour_edge_key(1, 0)));
+    assert(!tour_hash_set_contains(set, tour_edge_key(0, 0)));
+
+    tour_hash_set_clear(set);
+    assert(!tour_hash_set_contains(set, tour_edge_key(1, 0)));
+    assert(tour_hash_set_insert(set, tour_edge_key(1, 0)));
+    assert(!tour_hash_set_insert(set, tour_edge_key(1, 0)));
+
+    tour_hash_set_destroy(set);
+}
+
+static void test_tour_cache(void) {
+    printf("\t[Utility] Testing tour fitness cache...\n");
+    TourCache *cache = tour_cache_create(8);
+    double cost;
+
+    assert(!tour_cache_lookup(cache, 12345, &cost));
+    tour_cache_store(cache, 12345, 42.5);
+    assert(tour_cache_lookup(cache, 12345, &cost) && cost == 42.5);
+
+    // Same slot, different hash: the entry is replaced
+    tour_cache_store(cache, 12345 + 8, 7.0);
+    assert(!tour_cache_lookup(cache, 12345, &cost));
+    assert(tour_cache_lookup(cache, 12345 + 8, &cost) && cost == 7.0);
+
+    tour_cache_destroy(cache);
+}
+
+static void test_time_limiter_poll(void) {
+    printf("\t[Utility] Testing Amortized Deadline Checks...\n");
+    CancelToken *expired = cancel_token_create();
+    TimeLimiter timer = time_limiter_create(0.05);
+    time_limiter_start(&timer);
+    time_limiter_share_expiry(&timer, expired);
+    const TimeLimiter copy = timer;
+
+    DeadlinePacer pacer = {0};
+    while (!time_limiter_poll(&timer, &pacer)) {
+    }
+    const double late = second() - timer.start_time - timer.limit_seconds;
+    printf("\t  expiry seen %.3f ms late, stride %u\n", late * 1000.0, pacer.stride);
+    // Reads are ~0.2 ms apart; the bound leaves room for a preempted thread
+    assert(late < 0.005);
+    assert(pacer.stride > 1);
+
+    // Another copy stops on the shared flag, without waiting for its next clock read
+    assert(cancel_token_is_cancelled(expired));
+    DeadlinePacer other = {.stride = 1000, .countdown = 1000, .last_read = 0.0};
+    assert(time_limiter_poll(&copy, &other));
+    assert(other.countdown == 1000);
+
+    cancel_token_destroy(expired);
+}
+
 void run_utility_tests(void) {
     printf("[Utility] Running tests...\n");
     test_euclidean_distance();
     test_tour_cost_calculation();
     test_solution_update_logic();
+    test_solution_fetch_if_better();
     test_recorder_resize();
+    test_recorder_bounds();
+    test_recorder_bounds_keep_improvements();
+    test_recorder_merge_threads();
+    test_spatial_grid_nearest();
+    test_spatial_grid_collinear();
+    test_arena_rewind();
+    test_tour_hash_invariance();
+    test_tour_hash_two_opt_incremental();
+    test_tour_hash_set_concurrent();
+    test_tour_cache();
+    test_time_limiter_poll();
     printf("[Utility] Passed.\n");
 }
\ No newline at end of file
@@ -22,7 +22,15 @@ int main(void) {
     printf("\n--- Core Logic Tests ---\n");
     run_local_search_tests();
     run_n_opt_tests();
+    run_kick_tests();
+    run_path_relinking_tests();
+    run_eax_tests();
+    run_subtour_patching_tests();
+    run_migration_queue_tests();
     run_subtour_separator_tests();
+    run_model_csr_tests();
+    run_min_cut_separator_tests();
+    run_sparse_edge_set_tests();
 
     // Heuristics
     printf("\n--- Heuristic Tests ---\n");
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Small client for `tsp_solver --serve <socket>`.
+
+Examples:
+    ./tsp_client.py /tmp/tsp.sock -- -m 1 -f ../../TSPLIB95/att48.tsp --vns --vns-seconds 5
+    ./tsp_client.py /tmp/tsp.sock --random-nodes 500 --cancel-after 2 -- --ts --ts-seconds 30
+"""
+import argparse
+import os
+import random
+import socket
+import sys
+import threading
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Send one solve request to a tsp_solver server")
+    parser.add_argument("socket", help="Unix socket path of the server")
+    parser.add_argument("--random-nodes", type=int, default=0,
+                        help="send N random coordinates instead of an instance in the flags")
+    parser.add_argument("--seed", type=int, default=1, help="seed of the random coordinates")
+    parser.add_argument("--cancel-after", type=float, default=0.0, help="send CANCEL after this many seconds")
+    parser.add_argument("--quiet", action="store_true", help="do not print INCUMBENT lines")
+    # Everything after "--" is forwarded to the solver as is
+    argv = sys.argv[1:]
+    split = argv.index("--") if "--" in argv else len(argv)
+    args = parser.parse_args(argv[:split])
+    flags = argv[split + 1:]
+    # The server resolves paths from its own working directory
+    for i in range(len(flags) - 1):
+        if flags[i] in ("-f", "--file"):
+            flags[i + 1] = os.path.abspath(flags[i + 1])
+    request = " ".join(f'"{f}"' if " " in f else f for f in flags)
+
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    sock.connect(args.socket)
+    if args.random_nodes > 0:
+        rng = random.Random(args.seed)
+        lines = [f"SOLVE_NODES {args.random_nodes} {request}"]
+        lines += [f"{rng.uniform(0, 10000):.3f} {rng.uniform(0, 10000):.3f}" for _ in range(args.random_nodes)]
+        sock.sendall(("\n".join(lines) + "\n").encode())
+    else:
+        sock.sendall(f"SOLVE {request}\n".encode())
+
+    if args.cancel_after > 0:
+        timer = threading.Timer(args.cancel_after, lambda: sock.sendall(b"CANCEL\n"))
+        timer.daemon = True
+        timer.start()
+
+    exit_code = 0
+    for line in sock.makefile("r"):
+        line = line.rstrip("\n")
+        if line.startswith("INCUMBENT") and args.quiet:
+            continue
+        print(line, flush=True)
+        if line.startswith("ERROR") and not line.startswith("ERROR no algorithm"):
+            exit_code = 1
+            break
+        if line.startswith("DONE"):
+            break
+
+    sock.sendall(b"QUIT\n")
+    sock.close()
+    return exit_code
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -3,6 +3,26 @@
 
 #include "cmd_option/cmd_options.h"
 #include "tsp_instance.h"
+#include "tsp_solution.h"
+#include "cancel_token.h"
+
+/* Upper bound on the results of one run_selected_algorithms call. */
+#define MAX_ALGORITHM_RESULTS 16
+
+typedef struct {
+    const char *algorithm; // static name, valid after the algorithm is destroyed
+    double cost;
+    double seconds; // wall-clock time, plots included
+} AlgorithmResult;
+
+/**
+ * @brief Optional observers of a run, attached to every solution the run creates.
+ */
+typedef struct {
+    const CancelToken *cancel; // stops the running algorithm (and skips the rest quickly), may be NULL
+    TspSolutionListener on_improvement; // may be NULL
+    void *user_data;
+} RunHooks;
 
 /**
  * @brief Runs all algorithms selected in the options on the given instance.
@@ -10,7 +30,12 @@
  * @param instance The TSP instance to run the algorithms on.
  * @param cmd_options The command-line options specifying which
  * algorithms to run and their parameters.
+ * @param results Optional (may be NULL) array of MAX_ALGORITHM_RESULTS entries, one per run algorithm
+ * (a portfolio and a pipeline count as one each).
+ * @param hooks Optional (may be NULL) cancellation token and improvement listener.
+ * @return The number of results.
  */
-void run_selected_algorithms(const TspInstance *instance, const CmdOptions *cmd_options);
+int run_selected_algorithms(const TspInstance *instance, const CmdOptions *cmd_options, AlgorithmResult *results,
+                            const RunHooks *hooks);
 
 #endif // ALGORITHM_RUNNER_H
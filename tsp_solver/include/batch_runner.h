@@ -0,0 +1,24 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "cmd_option/cmd_options.h"
+
+/**
+ * @brief Runs every job of a batch manifest inside this process.
+ *
+ * Each non-empty line of the manifest (lines starting with '#' are comments) is one job, written with the
+ * same flags as the command line, optionally preceded by a "[label]":
+ *
+ *     [vns-small] -m 1 -f TSPLIB95/a280.tsp -s 42 --vns --vns-seconds 5
+ *
+ * Every distinct instance (file, or random nodes/seed/area) is built by the first job running on it, together
+ * with its cost matrix and candidate lists, and shared with the other jobs while it stays in an LRU cache of
+ * options->batch.cache_size instances. Jobs run on a pool of options->num_threads workers (0 = all cores);
+ * plots are disabled and the per-job verbosity is ignored. One JSON object per algorithm result (or per
+ * rejected line) is written to options->batch.output, or to stdout.
+ *
+ * @return 0 on success, 1 if the manifest or the output file cannot be opened.
+ */
+int run_batch(const CmdOptions *options);
+
+#endif // BATCH_RUNNER_H
@@ -45,6 +45,7 @@ typedef struct {
     unsigned int kick_repetitions;
     double time_limit;
     unsigned int max_stagnation;
+    char *kick_name;
 } VnsOptions;
 
 typedef struct {
@@ -65,6 +66,11 @@ typedef struct {
     double probability;
     unsigned int max_stagnation;
     double time_limit;
+    unsigned int elite_size;
+    double elite_min_diversity;
+    char *relinking_name;
+    char *construction_name;
+    bool deduplicate;
 } GraspOptions;
 
 typedef struct {
@@ -88,6 +94,13 @@ typedef struct {
     int init_grasp_rcl_size;
     double init_grasp_prob;
     int init_grasp_percent;
+    char *crossover_name;
+    unsigned int num_threads;
+    unsigned int num_islands;
+    unsigned int migration_interval;
+    unsigned int migration_count;
+    char *topology_name;
+    bool deduplicate;
 } GeneticOptions;
 
 typedef struct {
@@ -104,6 +117,8 @@ typedef struct {
     char *cost_file;
     double time_limit;
     unsigned int num_threads;
+    int cut_depth;
+    int sparse_k;
 } BranchCutOptions;
 
 typedef struct {
@@ -116,6 +131,7 @@ typedef struct {
     double time_slice_factor;
     double min_time_slice;
     char *heuristic_name;
+    unsigned int num_threads;
 } HardFixingOptions;
 
 typedef struct {
@@ -128,6 +144,35 @@ typedef struct {
     char *heuristic_name;
 } LocalBranchingOptions;
 
+typedef struct {
+    bool enable;
+    char *plot_file;
+} PortfolioOptions;
+
+typedef struct {
+    char *stages;
+    double time_limit;
+    char *plot_file;
+    char *cost_file;
+} PipelineOptions;
+
+typedef struct {
+    char *manifest;
+    char *output;
+    unsigned int cache_size;
+} BatchOptions;
+
+typedef struct {
+    char *socket_path;
+    unsigned int cache_size;
+} ServeOptions;
+
+typedef struct {
+    unsigned int max_samples;
+    bool improvements_only;
+    bool csv;
+} RecorderOptions;
+
 typedef struct {
     char *config_file;
     char *plots_path;
@@ -137,6 +182,11 @@ typedef struct {
     unsigned int num_threads;
     TspInstanceOptions inst;
     TspSolutionOptions sol;
+    RecorderOptions recorder;
+    PortfolioOptions portfolio;
+    PipelineOptions pipeline;
+    BatchOptions batch;
+    ServeOptions serve;
     NNOptions nn_params;
     VnsOptions vns_params;
     TabuOptions tabu_params;
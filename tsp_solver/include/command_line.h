@@ -0,0 +1,12 @@
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+/**
+ * @brief Splits a command line into argv, in place. Double quotes group words (e.g. a pipeline spec)
+ * and are removed.
+ *
+ * @return The number of arguments (at most max_args).
+ */
+int split_command_line(char *line, const char **argv, int max_args);
+
+#endif // COMMAND_LINE_H
@@ -0,0 +1,43 @@
+#ifndef INSTANCE_CACHE_H
+#define INSTANCE_CACHE_H
+
+#include "cmd_option/cmd_options.h"
+#include "tsp_instance.h"
+
+/**
+ * @brief Thread-safe cache of built instances (nodes, cost matrix and candidate lists).
+ *
+ * Instances are reference counted: an acquired instance stays valid until it is released. With a capacity,
+ * only unreferenced instances are evicted, least recently used first; while more instances than the capacity
+ * are in use, the cache holds them all and shrinks back as they are released.
+ * Instances are built outside the cache lock: concurrent misses on different instances are built in parallel,
+ * while acquirers of an instance being built wait for that build.
+ */
+typedef struct InstanceCache InstanceCache;
+
+/**
+ * @param capacity Maximum number of cached instances, 0 for unbounded.
+ */
+InstanceCache *instance_cache_create(int capacity);
+
+void instance_cache_destroy(InstanceCache *cache);
+
+/**
+ * @brief Returns the instance described by the options (file, or random nodes/seed/area), building it on a miss.
+ * @return NULL if the file cannot be loaded.
+ */
+const TspInstance *instance_cache_acquire(InstanceCache *cache, const TspInstanceOptions *options);
+
+/**
+ * @brief Returns an instance with the given coordinates, building it on a miss.
+ */
+const TspInstance *instance_cache_acquire_nodes(InstanceCache *cache, const Node *nodes, int n);
+
+void instance_cache_release(InstanceCache *cache, const TspInstance *instance);
+
+/**
+ * @brief Number of instances built so far (hits excluded).
+ */
+int instance_cache_get_builds(InstanceCache *cache);
+
+#endif // INSTANCE_CACHE_H
@@ -0,0 +1,49 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdbool.h>
+
+#define PIPELINE_MAX_STAGES 16
+
+typedef enum {
+    STAGE_NN = 0,
+    STAGE_EM,
+    STAGE_TWO_OPT,
+    STAGE_VNS,
+    STAGE_TABU,
+    STAGE_GRASP,
+    STAGE_GENETIC,
+    STAGE_BENDERS,
+    STAGE_BC,
+    STAGE_HF,
+    STAGE_LB
+} PipelineStageKind;
+
+typedef struct {
+    PipelineStageKind kind;
+    double weight;
+} PipelineStage;
+
+typedef struct {
+    PipelineStage stages[PIPELINE_MAX_STAGES];
+    int count;
+} Pipeline;
+
+/**
+ * @brief Parses a pipeline such as "greedy -> 2opt -> vns:2 -> tabu".
+ *
+ * Stages are separated by "->" and may carry a ":weight" (default 1), their share of the total time.
+ * Accepted names: nn/greedy, em, 2opt, vns, tabu/ts, grasp, ga/genetic, benders, bc, hf, lb.
+ *
+ * @return false (with a [Config Error] message) on an unknown stage, a bad weight or too many stages.
+ */
+bool pipeline_parse(const char *spec, Pipeline *pipeline);
+
+/**
+ * @brief Time slice of stage i out of total_seconds, proportional to its weight.
+ */
+double pipeline_stage_seconds(const Pipeline *pipeline, int i, double total_seconds);
+
+const char *pipeline_stage_name(PipelineStageKind kind);
+
+#endif // PIPELINE_H
@@ -0,0 +1,32 @@
+#ifndef SOLVER_SERVER_H
+#define SOLVER_SERVER_H
+
+#include "cmd_option/cmd_options.h"
+
+/**
+ * @brief Serves solve requests on a Unix domain socket until SIGINT/SIGTERM.
+ *
+ * The protocol is line based. Client requests:
+ *
+ *     SOLVE <flags>                 flags as on the command line (-f/-m/-n/-s..., algorithms, pipeline)
+ *     SOLVE_NODES <n> <flags>       followed by n lines "x y" with the coordinates of the instance
+ *     CANCEL                        stops the solve running on this connection
+ *     QUIT                          closes the connection (cancelling its solve)
+ *
+ * Server replies, for every accepted solve:
+ *
+ *     ACCEPTED <nodes>
+ *     INCUMBENT <cost> <seconds>    each time the best tour of the solve improves
+ *     RESULT <cost> <seconds> <algorithm>
+ *     TOUR <node> ... <node>        best tour of the solve, closing node included
+ *     DONE [cancelled]
+ *
+ * or "ERROR <message>". One solve at a time runs per connection; solves of different connections run on
+ * options->num_threads warm workers. Built instances are kept in an LRU cache of options->serve.cache_size
+ * entries. Plots are disabled and per-request verbosity is ignored.
+ *
+ * @return 0 on a clean shutdown, 1 if the socket cannot be set up.
+ */
+int run_server(const CmdOptions *options);
+
+#endif // SOLVER_SERVER_H
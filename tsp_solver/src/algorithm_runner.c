@@ -7,12 +7,16 @@
 #include "c_util.h"
 #include "logger.h"
 #include "constants.h"
+#include "chrono.h"
+#include "cancel_token.h"
 
 #include <stdio.h>
 #include <linux/limits.h>
 #include <string.h>
 #include <strings.h>
 #include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
 
 #include "benders_loop.h"
 #include "branch_and_cut.h"
@@ -21,6 +25,8 @@
 #include "hard_fixing.h"
 #include "local_branching.h"
 #include "heuristic_types.h"
+#include "two_opt_refine.h"
+#include "pipeline.h"
 
 typedef struct {
     TspSolverFn run_fn;
@@ -31,11 +37,12 @@ typedef struct {
     void (*free_config)(void *);
 
     unsigned int thread_id;
+    CostRecorder *recorder; // per-thread, merged into the run recorder after the join
 } WorkerArgs;
 
 static void *worker_thread_func(void *arg) {
     WorkerArgs *w = arg;
-    w->run_fn(w->instance, w->solution, w->local_config, NULL); // TODO nessuna regitrazione costi multithread
+    w->run_fn(w->instance, w->solution, w->local_config, w->recorder);
     if (w->free_config && w->local_config) {
         w->free_config(w->local_config);
     }
@@ -45,7 +52,8 @@ static void *worker_thread_func(void *arg) {
 static void execute_parallel(const TspAlgorithm *algo,
                              const TspInstance *instance,
                              TspSolution *solution,
-                             unsigned int num_threads) {
+                             unsigned int num_threads,
+                             CostRecorder *recorder) {
     pthread_t *threads = tsp_malloc(num_threads * sizeof(pthread_t));
     WorkerArgs *args = tsp_malloc(num_threads * sizeof(WorkerArgs));
 
@@ -58,6 +66,7 @@ static void execute_parallel(const TspAlgorithm *algo,
         args[i].free_config = algo->free_config;
         args[i].thread_id = i;
         args[i].local_config = algo->clone_config(algo->config, i);
+        args[i].recorder = cost_recorder_create_child(recorder, (int) i);
 
         if (pthread_create(&threads[i], NULL, worker_thread_func, &args[i]) != 0) {
             fprintf(stderr, "Error creating thread %ld\n", i);
@@ -66,24 +75,61 @@ static void execute_parallel(const TspAlgorithm *algo,
 
     for (size_t i = 0; i < num_threads; i++) {
         pthread_join(threads[i], NULL);
+        cost_recorder_merge(recorder, args[i].recorder);
+        cost_recorder_destroy(args[i].recorder);
     }
 
     tsp_free(threads);
     tsp_free(args);
 }
 
-static void execute_and_report(const TspAlgorithm *algo,
-                               const TspInstance *instance,
-                               const char *plot_file,
-                               const char *costs_file,
-                               unsigned int num_threads,
-                               bool plots_enable) {
+static CostRecorder *create_recorder(const RecorderOptions *recording) {
     CostRecorder *recorder = cost_recorder_create(RECORDER_INITIAL_CAPACITY);
+    cost_recorder_set_bounds(recorder, recording->improvements_only ? COST_RECORD_IMPROVEMENTS : COST_RECORD_ALL,
+                             recording->max_samples);
+    return recorder;
+}
+
+/* Plots the cost curve and, if requested, saves the samples next to it as <costs_file stem>.csv. */
+static void report_costs(const CostRecorder *recorder, const char *costs_file, const bool plots_enable,
+                         const RecorderOptions *recording) {
+    if (plots_enable)
+        plot_costs_evolution(cost_recorder_get_costs(recorder), cost_recorder_get_count(recorder), costs_file);
+    if (!recording->csv || !costs_file || strlen(costs_file) == 0) return;
+
+    char csv_file[PATH_MAX];
+    snprintf(csv_file, PATH_MAX, "%s", costs_file);
+    char *ext = strrchr(csv_file, '.');
+    if (ext && !strchr(ext, '/')) *ext = '\0';
+    if (strlen(csv_file) + 4 >= PATH_MAX) return;
+    strcat(csv_file, ".csv");
+    if (cost_recorder_save_csv(recorder, csv_file) != 0)
+        if_verbose(VERBOSE_INFO, "[ERROR] Cannot write cost samples to %s\n", csv_file);
+}
+
+/* Every solution of a run carries the caller's cancellation token and improvement listener. */
+static TspSolution *create_solution(const TspInstance *instance, const RunHooks *hooks) {
     TspSolution *solution = tsp_solution_create(instance);
+    if (hooks) {
+        tsp_solution_set_cancel_token(solution, hooks->cancel);
+        if (hooks->on_improvement) tsp_solution_set_listener(solution, hooks->on_improvement, hooks->user_data);
+    }
+    return solution;
+}
+
+static double execute_and_report(const TspAlgorithm *algo,
+                                 const TspInstance *instance,
+                                 const char *plot_file,
+                                 const char *costs_file,
+                                 unsigned int num_threads,
+                                 bool plots_enable,
+                                 const RecorderOptions *recording,
+                                 const RunHooks *hooks) {
+    CostRecorder *recorder = create_recorder(recording);
+    TspSolution *solution = create_solution(instance, hooks);
 
     if (num_threads > 1 && algo->clone_config != NULL) {
-        execute_parallel(algo, instance, solution, num_threads);
-        cost_recorder_add(recorder, tsp_solution_get_cost(solution));
+        execute_parallel(algo, instance, solution, num_threads, recorder);
     } else {
         if (num_threads > 1) {
             if_verbose(VERBOSE_INFO, "[WARN] Algorithm %s does not support multi-threading. Running sequentially.\n",
@@ -97,10 +143,9 @@ static void execute_and_report(const TspAlgorithm *algo,
 
     tsp_solution_get_tour(solution, tour_buffer);
     const double cost = tsp_solution_get_cost(solution);
-    if (plots_enable) {
-        plot_tour(tour_buffer, n, tsp_instance_get_nodes(instance), plot_file);
-        plot_costs_evolution(cost_recorder_get_costs(recorder), cost_recorder_get_count(recorder), costs_file);
-    }
+    cost_recorder_add_event(recorder, cost, COST_EVENT_FINAL);
+    if (plots_enable) plot_tour(tour_buffer, n, tsp_instance_get_nodes(instance), plot_file);
+    report_costs(recorder, costs_file, plots_enable, recording);
 
     if_verbose(VERBOSE_INFO, "%s solution: %lf\n", algo->name, cost);
 
@@ -108,6 +153,188 @@ static void execute_and_report(const TspAlgorithm *algo,
     cost_recorder_destroy(recorder);
     tsp_solution_destroy(solution);
     tsp_algorithm_destroy((TspAlgorithm *) algo);
+    return cost;
+}
+
+/* Upper bound on the algorithms a single run can enable; the last result slot is kept for the pipeline. */
+#define MAX_PLANNED_RUNS (MAX_ALGORITHM_RESULTS - 1)
+
+typedef struct {
+    TspAlgorithm algo;
+    double time_limit;
+    char plot_file[PATH_MAX];
+    char costs_file[PATH_MAX];
+    CostRecorder *recorder;
+} PlannedRun;
+
+typedef struct {
+    PlannedRun runs[MAX_PLANNED_RUNS];
+    int count;
+} RunPlan;
+
+static void plan_add(RunPlan *plan, const TspAlgorithm algo, const double time_limit, const char *plot_file,
+                     const char *costs_file) {
+    PlannedRun *run = &plan->runs[plan->count++];
+    run->algo = algo;
+    run->time_limit = time_limit;
+    snprintf(run->plot_file, PATH_MAX, "%s", plot_file);
+    snprintf(run->costs_file, PATH_MAX, "%s", costs_file);
+    run->recorder = NULL;
+}
+
+/* How often the portfolio forwards a cancellation of the caller to its runs. */
+#define PORTFOLIO_POLL_SECONDS 0.05
+
+typedef struct {
+    RunPlan *plan;
+    const TspInstance *instance;
+    TspSolution *solution;
+    CancelToken *stop; // the token of the shared solution: cancelled at the deadline or by the caller
+    double deadline;
+    atomic_int next;
+    int running; // workers not finished yet, under lock
+    pthread_mutex_t lock;
+    pthread_cond_t finished;
+} PortfolioContext;
+
+static void *portfolio_worker(void *arg) {
+    PortfolioContext *ctx = arg;
+    int i;
+    // Each worker is one core of the budget: it keeps taking algorithms until none is left
+    while ((i = atomic_fetch_add(&ctx->next, 1)) < ctx->plan->count) {
+        PlannedRun *run = &ctx->plan->runs[i];
+        if (cancel_token_is_cancelled(ctx->stop) || second() >= ctx->deadline) {
+            if_verbose(VERBOSE_INFO, "[WARN] Portfolio: %s skipped, the portfolio time is over\n", run->algo.name);
+            continue;
+        }
+        tsp_algorithm_run(&run->algo, ctx->instance, ctx->solution, run->recorder);
+        if_verbose(VERBOSE_INFO, "Portfolio: %s finished, shared incumbent %lf\n", run->algo.name,
+                   tsp_solution_get_cost(ctx->solution));
+    }
+
+    pthread_mutex_lock(&ctx->lock);
+    ctx->running--;
+    pthread_cond_signal(&ctx->finished);
+    pthread_mutex_unlock(&ctx->lock);
+    return NULL;
+}
+
+/*
+ * Waits for the workers until the portfolio deadline, then stops the runs still going: the queued ones would
+ * otherwise start late with their whole time limit. A cancellation of the caller stops them too.
+ */
+static void portfolio_wait(PortfolioContext *ctx, const CancelToken *caller) {
+    pthread_mutex_lock(&ctx->lock);
+    while (ctx->running > 0) {
+        const double left = ctx->deadline - second();
+        if (left <= 0.0 || cancel_token_is_cancelled(caller)) {
+            cancel_token_cancel(ctx->stop);
+            break;
+        }
+
+        const double wait = left < PORTFOLIO_POLL_SECONDS ? left : PORTFOLIO_POLL_SECONDS;
+        struct timespec until;
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_nsec += (long) (wait * 1e9);
+        if (until.tv_nsec >= 1000000000L) {
+            until.tv_sec++;
+            until.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&ctx->finished, &ctx->lock, &until);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+/*
+ * Runs every planned algorithm concurrently on one shared solution, at most num_threads (0 = all cores) at a time.
+ * The algorithms publish their improvements to the solution and restart from it when it beats their own best.
+ * The portfolio ends within the longest planned time limit: the runs queued behind it only get what is left.
+ */
+static double execute_portfolio(RunPlan *plan,
+                                const TspInstance *instance,
+                                const char *plot_file,
+                                unsigned int num_threads,
+                                bool plots_enable,
+                                const RecorderOptions *recording,
+                                const RunHooks *hooks) {
+
+    if (num_threads == 0) num_threads = (unsigned int) get_max_threads();
+    const unsigned int workers = num_threads < (unsigned int) plan->count ? num_threads : (unsigned int) plan->count;
+    if (workers < (unsigned int) plan->count) {
+        if_verbose(VERBOSE_INFO, "[WARN] Portfolio: %d algorithms on %u threads, the last ones will start late "
+                   "and only run until the portfolio deadline.\n", plan->count, workers);
+    }
+    if_verbose(VERBOSE_INFO, ">>> Starting Portfolio: %d algorithms on %u threads\n", plan->count, workers);
+
+    TspSolution *solution = create_solution(instance, hooks);
+    double time_limit = 0.0;
+    for (int i = 0; i < plan->count; i++) {
+        plan->runs[i].recorder = create_recorder(recording);
+        if (plan->runs[i].time_limit > time_limit) time_limit = plan->runs[i].time_limit;
+    }
+
+    PortfolioContext ctx = {
+        .plan = plan,
+        .instance = instance,
+        .solution = solution,
+        .stop = cancel_token_create(),
+        .deadline = second() + time_limit
+    };
+    atomic_init(&ctx.next, 0);
+    pthread_mutex_init(&ctx.lock, NULL);
+    pthread_cond_init(&ctx.finished, NULL);
+    tsp_solution_set_cancel_token(solution, ctx.stop);
+
+    pthread_t *threads = tsp_malloc(workers * sizeof(pthread_t));
+    unsigned int started = 0;
+    for (; started < workers; started++) {
+        pthread_mutex_lock(&ctx.lock);
+        ctx.running++;
+        pthread_mutex_unlock(&ctx.lock);
+        if (pthread_create(&threads[started], NULL, portfolio_worker, &ctx) != 0) {
+            fprintf(stderr, "Error creating thread %u\n", started);
+            pthread_mutex_lock(&ctx.lock);
+            ctx.running--;
+            pthread_mutex_unlock(&ctx.lock);
+            break;
+        }
+    }
+    if (started == 0) {
+        // Without any worker the calling thread runs the whole portfolio itself, with the caller's cancellation
+        tsp_solution_set_cancel_token(solution, hooks ? hooks->cancel : NULL);
+        ctx.running = 1;
+        portfolio_worker(&ctx);
+    }
+    portfolio_wait(&ctx, hooks ? hooks->cancel : NULL);
+    for (unsigned int t = 0; t < started; t++)
+        pthread_join(threads[t], NULL);
+    tsp_solution_set_cancel_token(solution, hooks ? hooks->cancel : NULL);
+
+    const int n = tsp_instance_get_num_nodes(instance);
+    int *tour_buffer = tsp_malloc((n + 1) * sizeof(int));
+    tsp_solution_get_tour(solution, tour_buffer);
+    const double cost = tsp_solution_get_cost(solution);
+
+    for (int i = 0; i < plan->count; i++) {
+        PlannedRun *run = &plan->runs[i];
+        cost_recorder_add_event(run->recorder, cost, COST_EVENT_FINAL);
+        report_costs(run->recorder, run->costs_file, plots_enable, recording);
+        cost_recorder_destroy(run->recorder);
+        tsp_algorithm_destroy(&run->algo);
+    }
+    if (plots_enable) {
+        plot_tour(tour_buffer, n, tsp_instance_get_nodes(instance), plot_file);
+    }
+
+    if_verbose(VERBOSE_INFO, "Portfolio solution: %lf\n", cost);
+
+    tsp_free(threads);
+    tsp_free(tour_buffer);
+    tsp_solution_destroy(solution);
+    pthread_cond_destroy(&ctx.finished);
+    pthread_mutex_destroy(&ctx.lock);
+    cancel_token_destroy(ctx.stop);
+    return cost;
 }
 
 static HeuristicType parse_warm_start_heuristic(const char *name) {
@@ -123,6 +350,55 @@ static HeuristicType parse_warm_start_heuristic(const char *name) {
     return VNS;
 }
 
+static KickType parse_kick_type(const char *name) {
+    if (!name) return KICK_RANDOM_N_OPT;
+    if (strcasecmp(name, "nopt") == 0) return KICK_RANDOM_N_OPT;
+    if (strcasecmp(name, "double-bridge") == 0 || strcasecmp(name, "db") == 0) return KICK_DOUBLE_BRIDGE;
+    if (strcasecmp(name, "segment") == 0) return KICK_SEGMENT_REVERSAL;
+    if (strcasecmp(name, "near-double-bridge") == 0 || strcasecmp(name, "near-db") == 0)
+        return KICK_NEAR_DOUBLE_BRIDGE;
+
+    if_verbose(VERBOSE_INFO, "[Warning] Unknown kick '%s', defaulting to nopt.\n", name);
+    return KICK_RANDOM_N_OPT;
+}
+
+static RelinkingMode parse_relinking_mode(const char *name) {
+    if (!name) return RELINK_BACKWARD;
+    if (strcasecmp(name, "backward") == 0) return RELINK_BACKWARD;
+    if (strcasecmp(name, "forward") == 0) return RELINK_FORWARD;
+    if (strcasecmp(name, "both") == 0 || strcasecmp(name, "mixed") == 0) return RELINK_BOTH;
+
+    if_verbose(VERBOSE_INFO, "[Warning] Unknown relinking '%s', defaulting to backward.\n", name);
+    return RELINK_BACKWARD;
+}
+
+static bool parse_grasp_construction(const char *name) {
+    if (!name) return true;
+    if (strcasecmp(name, "candidates") == 0 || strcasecmp(name, "cl") == 0) return true;
+    if (strcasecmp(name, "full") == 0 || strcasecmp(name, "scan") == 0) return false;
+
+    if_verbose(VERBOSE_INFO, "[Warning] Unknown GRASP construction '%s', defaulting to candidates.\n", name);
+    return true;
+}
+
+static GeneticCrossover parse_crossover(const char *name) {
+    if (!name) return GA_CROSSOVER_CUT;
+    if (strcasecmp(name, "cut") == 0) return GA_CROSSOVER_CUT;
+    if (strcasecmp(name, "eax") == 0) return GA_CROSSOVER_EAX;
+
+    if_verbose(VERBOSE_INFO, "[Warning] Unknown crossover '%s', defaulting to cut.\n", name);
+    return GA_CROSSOVER_CUT;
+}
+
+static MigrationTopology parse_topology(const char *name) {
+    if (!name) return MIGRATION_RING;
+    if (strcasecmp(name, "ring") == 0) return MIGRATION_RING;
+    if (strcasecmp(name, "random") == 0) return MIGRATION_RANDOM;
+
+    if_verbose(VERBOSE_INFO, "[Warning] Unknown migration topology '%s', defaulting to ring.\n", name);
+    return MIGRATION_RING;
+}
+
 static void *create_heuristic_config(HeuristicType type, const CmdOptions *options) {
     switch (type) {
         case VNS: {
@@ -132,6 +408,7 @@ static void *create_heuristic_config(HeuristicType type, const CmdOptions *optio
                 .max_k = (int) options->vns_params.max_k,
                 .kick_repetition = (int) options->vns_params.kick_repetitions,
                 .max_stagnation = (int) options->vns_params.max_stagnation,
+                .kick_type = parse_kick_type(options->vns_params.kick_name),
                 .seed = options->inst.seed
             };
             return vns;
@@ -152,7 +429,12 @@ static void *create_heuristic_config(HeuristicType type, const CmdOptions *optio
                 .rcl_size = (int) options->grasp_params.rcl_size,
                 .probability = options->grasp_params.probability,
                 .max_stagnation = (int) options->grasp_params.max_stagnation,
-                .seed = options->inst.seed
+                .seed = options->inst.seed,
+                .elite_size = (int) options->grasp_params.elite_size,
+                .elite_min_diversity = options->grasp_params.elite_min_diversity,
+                .relinking = parse_relinking_mode(options->grasp_params.relinking_name),
+                .use_candidate_lists = parse_grasp_construction(options->grasp_params.construction_name),
+                .deduplicate = options->grasp_params.deduplicate
             };
             return grasp;
         }
@@ -168,6 +450,13 @@ static void *create_heuristic_config(HeuristicType type, const CmdOptions *optio
                 .init_grasp_rcl_size = options->genetic_params.init_grasp_rcl_size,
                 .init_grasp_prob = options->genetic_params.init_grasp_prob,
                 .init_grasp_percent = options->genetic_params.init_grasp_percent,
+                .crossover = parse_crossover(options->genetic_params.crossover_name),
+                .num_threads = (int) options->genetic_params.num_threads,
+                .num_islands = (int) options->genetic_params.num_islands,
+                .migration_interval = (int) options->genetic_params.migration_interval,
+                .migration_count = (int) options->genetic_params.migration_count,
+                .migration_topology = parse_topology(options->genetic_params.topology_name),
+                .deduplicate = options->genetic_params.deduplicate,
                 .seed = options->inst.seed
             };
             return ga;
@@ -180,10 +469,191 @@ static void *create_heuristic_config(HeuristicType type, const CmdOptions *optio
     }
 }
 
-void run_selected_algorithms(const TspInstance *instance, const CmdOptions *options) {
+static TspAlgorithm create_nn_algorithm(const CmdOptions *options, const double time_limit) {
+    NNConfig cfg = {
+        .time_limit = time_limit,
+        .seed = options->inst.seed,
+        .num_threads = (int) options->nn_params.num_threads
+    };
+    return nn_create(cfg);
+}
+
+static TspAlgorithm create_em_algorithm(const CmdOptions *options, const double time_limit) {
+    EMConfig cfg = {
+        .time_limit = time_limit,
+        .seed = options->inst.seed
+    };
+    return em_create(cfg);
+}
+
+static TspAlgorithm create_two_opt_algorithm(const CmdOptions *options, const double time_limit) {
+    (void) options;
+    TwoOptConfig cfg = {
+        .time_limit = time_limit
+    };
+    return two_opt_create(cfg);
+}
+
+static TspAlgorithm create_vns_algorithm(const CmdOptions *options, const double time_limit) {
+    VNSConfig *cfg = create_heuristic_config(VNS, options);
+    cfg->time_limit = time_limit;
+    const TspAlgorithm algo = vns_create(*cfg);
+    tsp_free(cfg);
+    return algo;
+}
+
+static TspAlgorithm create_tabu_algorithm(const CmdOptions *options, const double time_limit) {
+    TabuConfig *cfg = create_heuristic_config(TABU, options);
+    cfg->time_limit = time_limit;
+    const TspAlgorithm algo = tabu_create(*cfg);
+    tsp_free(cfg);
+    return algo;
+}
+
+static TspAlgorithm create_grasp_algorithm(const CmdOptions *options, const double time_limit) {
+    GraspConfig *cfg = create_heuristic_config(GRASP, options);
+    cfg->time_limit = time_limit;
+    const TspAlgorithm algo = grasp_create(*cfg);
+    tsp_free(cfg);
+    return algo;
+}
+
+static TspAlgorithm create_genetic_algorithm(const CmdOptions *options, const double time_limit) {
+    GeneticConfig *cfg = create_heuristic_config(GENETIC, options);
+    cfg->time_limit = time_limit;
+    const TspAlgorithm algo = genetic_create(*cfg);
+    tsp_free(cfg);
+    return algo;
+}
+
+static TspAlgorithm create_benders_algorithm(const CmdOptions *options, const double time_limit) {
+    BendersConfig cfg = {
+        .time_limit = time_limit,
+        .max_iterations = (int) options->benders_params.max_iterations
+    };
+    return benders_create(cfg);
+}
+
+static TspAlgorithm create_bc_algorithm(const CmdOptions *options, const double time_limit) {
+    BranchCutConfig cfg = {
+        .time_limit = time_limit,
+        .num_threads = (int) options->bc_params.num_threads,
+        .cut_depth = options->bc_params.cut_depth,
+        .sparse_k = options->bc_params.sparse_k
+    };
+    return branch_and_cut_create(cfg);
+}
+
+static TspAlgorithm create_hf_algorithm(const CmdOptions *options, const double time_limit) {
+    HardFixingConfig cfg = {
+        .time_limit = time_limit,
+        .fixing_rate = options->hf_params.fixing_rate,
+        .heuristic_time_ratio = options->hf_params.heuristic_ratio,
+        .time_slice_factor = options->hf_params.time_slice_factor,
+        .min_time_slice = options->hf_params.min_time_slice,
+        .heuristic_type = parse_warm_start_heuristic(options->hf_params.heuristic_name),
+        .seed = options->inst.seed,
+        .heuristic_args = NULL,
+        .num_threads = (int) options->hf_params.num_threads,
+        .num_workers = 1 // a pipeline stage runs alone: run_selected_algorithms sets the count of its runs
+    };
+
+    cfg.heuristic_args = create_heuristic_config(cfg.heuristic_type, options);
+
+    return hard_fixing_create(cfg);
+}
+
+static TspAlgorithm create_lb_algorithm(const CmdOptions *options, const double time_limit) {
+    LocalBranchingConfig cfg = {
+        .time_limit = time_limit,
+        .k = options->lb_params.k,
+        .heuristic_time_ratio = options->lb_params.heuristic_ratio,
+        .heuristic_type = parse_warm_start_heuristic(options->lb_params.heuristic_name),
+        .seed = options->inst.seed,
+        .heuristic_args = NULL
+    };
+
+    cfg.heuristic_args = create_heuristic_config(cfg.heuristic_type, options);
+
+    return local_branching_create(cfg);
+}
+
+typedef TspAlgorithm (*AlgorithmFactory)(const CmdOptions *options, double time_limit);
+
+/* Indexed by PipelineStageKind. */
+static const AlgorithmFactory stage_factories[] = {
+    [STAGE_NN] = create_nn_algorithm,
+    [STAGE_EM] = create_em_algorithm,
+    [STAGE_TWO_OPT] = create_two_opt_algorithm,
+    [STAGE_VNS] = create_vns_algorithm,
+    [STAGE_TABU] = create_tabu_algorithm,
+    [STAGE_GRASP] = create_grasp_algorithm,
+    [STAGE_GENETIC] = create_genetic_algorithm,
+    [STAGE_BENDERS] = create_benders_algorithm,
+    [STAGE_BC] = create_bc_algorithm,
+    [STAGE_HF] = create_hf_algorithm,
+    [STAGE_LB] = create_lb_algorithm,
+};
+
+/*
+ * Runs the stages one after the other on the same solution: each stage starts from the incumbent
+ * left by the previous one, with no copy in between, and gets its weighted slice of the time budget.
+ */
+static double execute_pipeline(const Pipeline *pipeline,
+                               const CmdOptions *options,
+                               const TspInstance *instance,
+                               const char *plot_file,
+                               const char *costs_file,
+                               const RunHooks *hooks) {
+    CostRecorder *recorder = create_recorder(&options->recorder);
+    TspSolution *solution = create_solution(instance, hooks);
+
+    if_verbose(VERBOSE_INFO, ">>> Starting Pipeline: %d stages, %.2f seconds\n", pipeline->count,
+               options->pipeline.time_limit);
+
+    for (int i = 0; i < pipeline->count; i++) {
+        const PipelineStageKind kind = pipeline->stages[i].kind;
+        const double seconds = pipeline_stage_seconds(pipeline, i, options->pipeline.time_limit);
+        TspAlgorithm algo = stage_factories[kind](options, seconds);
+
+        tsp_algorithm_run(&algo, instance, solution, recorder);
+        if_verbose(VERBOSE_INFO, "Pipeline: stage %d (%s, %.2fs) -> %lf\n", i + 1, pipeline_stage_name(kind),
+                   seconds, tsp_solution_get_cost(solution));
+
+        tsp_algorithm_destroy(&algo);
+    }
+
+    const int n = tsp_instance_get_num_nodes(instance);
+    int *tour_buffer = tsp_malloc((n + 1) * sizeof(int));
+
+    tsp_solution_get_tour(solution, tour_buffer);
+    const double cost = tsp_solution_get_cost(solution);
+    cost_recorder_add_event(recorder, cost, COST_EVENT_FINAL);
+    if (options->plots_enable) plot_tour(tour_buffer, n, tsp_instance_get_nodes(instance), plot_file);
+    report_costs(recorder, costs_file, options->plots_enable, &options->recorder);
+
+    if_verbose(VERBOSE_INFO, "Pipeline solution: %lf\n", cost);
+
+    tsp_free(tour_buffer);
+    cost_recorder_destroy(recorder);
+    tsp_solution_destroy(solution);
+    return cost;
+}
+
+static void add_result(AlgorithmResult *results, int *count, const char *name, const double cost,
+                       const double start_time) {
+    if (!results) return;
+    results[*count] = (AlgorithmResult){.algorithm = name, .cost = cost, .seconds = second() - start_time};
+    (*count)++;
+}
+
+int run_selected_algorithms(const TspInstance *instance, const CmdOptions *options, AlgorithmResult *results,
+                            const RunHooks *hooks) {
     char full_plot_path[PATH_MAX];
     char full_costs_path[PATH_MAX];
     unsigned int threads = options->num_threads;
+    RunPlan plan = {.count = 0};
+    int result_count = 0;
 
 #define BUILD_PATHS(plot_fname, cost_fname) \
         if (options->plots_path && strlen(options->plots_path) > 0) { \
@@ -194,142 +664,62 @@ void run_selected_algorithms(const TspInstance *instance, const CmdOptions *opti
             snprintf(full_costs_path, PATH_MAX, "%s", cost_fname); \
         }
 
-    if (options->nn_params.enable) {
-        NNConfig cfg = {
-            .time_limit = options->nn_params.time_limit,
-            .seed = options->inst.seed,
-            .num_threads = (int) options->nn_params.num_threads
-        };
-        TspAlgorithm algo = nn_create(cfg);
-        BUILD_PATHS(options->nn_params.plot_file, options->nn_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
-    }
-
-    if (options->vns_params.enable) {
-        VNSConfig cfg = {
-            .min_k = (int) options->vns_params.min_k,
-            .max_k = (int) options->vns_params.max_k,
-            .kick_repetition = (int) options->vns_params.kick_repetitions,
-            .max_stagnation = (int) options->vns_params.max_stagnation,
-            .time_limit = options->vns_params.time_limit,
-            .seed = options->inst.seed
-        };
-        TspAlgorithm algo = vns_create(cfg);
-        BUILD_PATHS(options->vns_params.plot_file, options->vns_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
-    }
-
-    if (options->tabu_params.enable) {
-        TabuConfig cfg = {
-            .min_tenure = (int) options->tabu_params.min_tenure,
-            .max_tenure = (int) options->tabu_params.max_tenure,
-            .max_stagnation = (int) options->tabu_params.max_stagnation,
-            .time_limit = options->tabu_params.time_limit,
-            .seed = options->inst.seed
-        };
-        TspAlgorithm algo = tabu_create(cfg);
-        BUILD_PATHS(options->tabu_params.plot_file, options->tabu_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
-    }
-
-    if (options->grasp_params.enable) {
-        GraspConfig cfg = {
-            .rcl_size = (int) options->grasp_params.rcl_size,
-            .probability = options->grasp_params.probability,
-            .max_stagnation = (int) options->grasp_params.max_stagnation,
-            .time_limit = options->grasp_params.time_limit,
-            .seed = options->inst.seed
-        };
-        TspAlgorithm algo = grasp_create(cfg);
-        BUILD_PATHS(options->grasp_params.plot_file, options->grasp_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
-    }
-
-    if (options->em_params.enable) {
-        EMConfig cfg = {
-            .time_limit = options->em_params.time_limit,
-            .seed = options->inst.seed
-        };
-        TspAlgorithm algo = em_create(cfg);
-        BUILD_PATHS(options->em_params.plot_file, options->em_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
-    }
-
-    if (options->genetic_params.enable) {
-        GeneticConfig cfg = {
-            .time_limit = options->genetic_params.time_limit,
-            .population_size = (int) options->genetic_params.population_size,
-            .elite_count = (int) options->genetic_params.elite_count,
-            .mutation_rate = options->genetic_params.mutation_rate,
-            .crossover_cut_min_ratio = (int) options->genetic_params.crossover_cut_min_ratio,
-            .crossover_cut_max_ratio = (int) options->genetic_params.crossover_cut_max_ratio,
-            .tournament_size = options->genetic_params.tournament_size,
-            .init_grasp_rcl_size = options->genetic_params.init_grasp_rcl_size,
-            .init_grasp_prob = options->genetic_params.init_grasp_prob,
-            .init_grasp_percent = options->genetic_params.init_grasp_percent,
-            .seed = options->inst.seed
-        };
-
-        TspAlgorithm algo = genetic_create(cfg);
-        BUILD_PATHS(options->genetic_params.plot_file, options->genetic_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
-    }
-
-    if (options->benders_params.enable) {
-        BendersConfig cfg = {
-            .time_limit = options->benders_params.time_limit,
-            .max_iterations = (int) options->benders_params.max_iterations
-        };
-        TspAlgorithm algo = benders_create(cfg);
-        BUILD_PATHS(options->benders_params.plot_file, options->benders_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
-    }
+#define PLAN_IF_ENABLED(params, factory) \
+        if (options->params.enable) { \
+            BUILD_PATHS(options->params.plot_file, options->params.cost_file); \
+            plan_add(&plan, factory(options, options->params.time_limit), options->params.time_limit, \
+                     full_plot_path, full_costs_path); \
+        }
 
-    if (options->bc_params.enable) {
-        BranchCutConfig cfg = {
-            .time_limit = options->bc_params.time_limit,
-            .num_threads = (int) options->bc_params.num_threads
-        };
-        TspAlgorithm algo = branch_and_cut_create(cfg);
-        BUILD_PATHS(options->bc_params.plot_file, options->bc_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
+    PLAN_IF_ENABLED(nn_params, create_nn_algorithm)
+    PLAN_IF_ENABLED(vns_params, create_vns_algorithm)
+    PLAN_IF_ENABLED(tabu_params, create_tabu_algorithm)
+    PLAN_IF_ENABLED(grasp_params, create_grasp_algorithm)
+    PLAN_IF_ENABLED(em_params, create_em_algorithm)
+    PLAN_IF_ENABLED(genetic_params, create_genetic_algorithm)
+    PLAN_IF_ENABLED(benders_params, create_benders_algorithm)
+    PLAN_IF_ENABLED(bc_params, create_bc_algorithm)
+    PLAN_IF_ENABLED(hf_params, create_hf_algorithm)
+    HardFixingConfig *hf_config = options->hf_params.enable ? plan.runs[plan.count - 1].algo.config : NULL;
+    PLAN_IF_ENABLED(lb_params, create_lb_algorithm)
+
+    // The sub-MIPs split the cores among the runs actually sharing them
+    if (hf_config) {
+        if (options->portfolio.enable) {
+            const unsigned int pool = threads > 0 ? threads : (unsigned int) get_max_threads();
+            hf_config->num_workers = (int) (pool < (unsigned int) plan.count ? pool : (unsigned int) plan.count);
+        } else {
+            hf_config->num_workers = threads > 1 ? (int) threads : 1;
+        }
     }
 
-    if (options->hf_params.enable) {
-        HardFixingConfig cfg = {
-            .time_limit = options->hf_params.time_limit,
-            .fixing_rate = options->hf_params.fixing_rate,
-            .heuristic_time_ratio = options->hf_params.heuristic_ratio,
-            .time_slice_factor = options->hf_params.time_slice_factor,
-            .min_time_slice = options->hf_params.min_time_slice,
-            .heuristic_type = parse_warm_start_heuristic(options->hf_params.heuristic_name),
-            .seed = options->inst.seed,
-            .heuristic_args = NULL
-        };
-
-        cfg.heuristic_args = create_heuristic_config(cfg.heuristic_type, options);
-
-        TspAlgorithm algo = hard_fixing_create(cfg);
-        BUILD_PATHS(options->hf_params.plot_file, options->hf_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
+    if (options->portfolio.enable && plan.count > 0) {
+        BUILD_PATHS(options->portfolio.plot_file, "");
+        const double start = second();
+        const double cost = execute_portfolio(&plan, instance, full_plot_path, threads, options->plots_enable,
+                                              &options->recorder, hooks);
+        add_result(results, &result_count, "Portfolio", cost, start);
+    } else {
+        for (int i = 0; i < plan.count; i++) {
+            const PlannedRun *run = &plan.runs[i];
+            const double start = second();
+            const double cost = execute_and_report(&run->algo, instance, run->plot_file, run->costs_file, threads,
+                                                   options->plots_enable, &options->recorder, hooks);
+            add_result(results, &result_count, run->algo.name, cost, start);
+        }
     }
 
-    if (options->lb_params.enable) {
-        LocalBranchingConfig cfg = {
-            .time_limit = options->lb_params.time_limit,
-            .k = options->lb_params.k,
-            .heuristic_time_ratio = options->lb_params.heuristic_ratio,
-            .heuristic_type = parse_warm_start_heuristic(options->lb_params.heuristic_name),
-            .seed = options->inst.seed,
-            .heuristic_args = NULL
-        };
-
-        cfg.heuristic_args = create_heuristic_config(cfg.heuristic_type, options);
-
-        TspAlgorithm algo = local_branching_create(cfg);
-        BUILD_PATHS(options->lb_params.plot_file, options->lb_params.cost_file);
-        execute_and_report(&algo, instance, full_plot_path, full_costs_path, threads, options->plots_enable);
+    Pipeline pipeline;
+    if (options->pipeline.stages && strlen(options->pipeline.stages) > 0 &&
+        pipeline_parse(options->pipeline.stages, &pipeline)) {
+        BUILD_PATHS(options->pipeline.plot_file, options->pipeline.cost_file);
+        const double start = second();
+        const double cost = execute_pipeline(&pipeline, options, instance, full_plot_path, full_costs_path,
+                                             hooks);
+        add_result(results, &result_count, "Pipeline", cost, start);
     }
 
+#undef PLAN_IF_ENABLED
 #undef BUILD_PATHS
+    return result_count;
 }
@@ -0,0 +1,195 @@
+#include "batch_runner.h"
+#include "algorithm_runner.h"
+#include "tsp_instance.h"
+#include "c_util.h"
+#include "logger.h"
+#include "command_line.h"
+#include "instance_cache.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BATCH_MAX_ARGS 128
+
+typedef struct {
+    int line;
+    char *label;
+    CmdOptions *options;
+} BatchJob;
+
+typedef struct {
+    BatchJob *jobs;
+    int count;
+    InstanceCache *cache;
+    atomic_int next;
+    FILE *out;
+    pthread_mutex_t out_mutex;
+} BatchContext;
+
+/* Writes s as a JSON string literal. */
+static void write_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; s && *s; s++) {
+        const unsigned char c = (unsigned char) *s;
+        if (c == '"' || c == '\\') fprintf(out, "\\%c", c);
+        else if (c < 0x20) fprintf(out, "\\u%04x", c);
+        else fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+static void write_error(BatchContext *ctx, const int line, const char *message) {
+    pthread_mutex_lock(&ctx->out_mutex);
+    fprintf(ctx->out, "{\"line\":%d,\"error\":", line);
+    write_json_string(ctx->out, message);
+    fprintf(ctx->out, "}\n");
+    fflush(ctx->out);
+    pthread_mutex_unlock(&ctx->out_mutex);
+}
+
+static void write_results(BatchContext *ctx, const BatchJob *job, const TspInstance *instance,
+                          const AlgorithmResult *results, const int count) {
+    const TspInstanceOptions *inst = &job->options->inst;
+    pthread_mutex_lock(&ctx->out_mutex);
+    for (int i = 0; i < count; i++) {
+        fprintf(ctx->out, "{\"line\":%d,\"label\":", job->line);
+        write_json_string(ctx->out, job->label);
+        fprintf(ctx->out, ",\"instance\":");
+        write_json_string(ctx->out, inst->mode == TSP_INPUT_MODE_FILE ? inst->input_file : "random");
+        fprintf(ctx->out, ",\"nodes\":%d,\"seed\":%d,\"algorithm\":", tsp_instance_get_num_nodes(instance),
+                inst->seed);
+        write_json_string(ctx->out, results[i].algorithm);
+        fprintf(ctx->out, ",\"cost\":%.6f,\"seconds\":%.4f}\n", results[i].cost, results[i].seconds);
+    }
+    fflush(ctx->out);
+    pthread_mutex_unlock(&ctx->out_mutex);
+}
+
+static void *batch_worker(void *arg) {
+    BatchContext *ctx = arg;
+    AlgorithmResult results[MAX_ALGORITHM_RESULTS];
+    int i;
+    while ((i = atomic_fetch_add(&ctx->next, 1)) < ctx->count) {
+        const BatchJob *job = &ctx->jobs[i];
+        const TspInstance *instance = instance_cache_acquire(ctx->cache, &job->options->inst);
+        if (!instance) {
+            write_error(ctx, job->line, "cannot load instance");
+            continue;
+        }
+        const int count = run_selected_algorithms(instance, job->options, results, NULL);
+        if (count == 0) write_error(ctx, job->line, "no algorithm enabled");
+        else write_results(ctx, job, instance, results, count);
+        instance_cache_release(ctx->cache, instance);
+    }
+    return NULL;
+}
+
+/* Parses one manifest line into a job; its instance is built by the worker running it. Returns false (and
+ * reports it) for rejected lines. */
+static bool parse_job(BatchContext *ctx, char *text, const int line, BatchJob *job) {
+    char *label = NULL;
+    if (*text == '[') {
+        char *close = strchr(text, ']');
+        if (close) {
+            *close = '\0';
+            label = text + 1;
+            text = close + 1;
+        }
+    }
+
+    const char *argv[BATCH_MAX_ARGS];
+    const int argc = split_command_line(text, argv, BATCH_MAX_ARGS);
+
+    CmdOptions *options = cmd_options_create_defaults();
+    const ParsingResult *res = cmd_options_load(options, argc, argv);
+    if (res->state != PARSE_SUCCESS) {
+        write_error(ctx, line, res->error_message ? res->error_message : "invalid options");
+        cmd_options_destroy(options);
+        return false;
+    }
+    // Concurrent jobs must not fight over gnuplot and the plot files
+    options->plots_enable = false;
+
+    *job = (BatchJob){
+        .line = line,
+        .label = strdup(label ? label : ""),
+        .options = options
+    };
+    return true;
+}
+
+int run_batch(const CmdOptions *options) {
+    FILE *manifest = fopen(options->batch.manifest, "r");
+    if (!manifest) {
+        if_verbose(VERBOSE_INFO, "[ERROR] Batch: cannot open manifest %s\n", options->batch.manifest);
+        return 1;
+    }
+    FILE *out = stdout;
+    if (options->batch.output && strlen(options->batch.output) > 0) {
+        out = fopen(options->batch.output, "w");
+        if (!out) {
+            if_verbose(VERBOSE_INFO, "[ERROR] Batch: cannot open output %s\n", options->batch.output);
+            fclose(manifest);
+            return 1;
+        }
+    }
+
+    // Bounded: a manifest sweeping many instances keeps only the recently used ones built
+    BatchContext ctx = {.jobs = NULL, .count = 0, .cache = instance_cache_create((int) options->batch.cache_size),
+                        .out = out};
+    atomic_init(&ctx.next, 0);
+    pthread_mutex_init(&ctx.out_mutex, NULL);
+
+    // The whole manifest is parsed before the pool starts; instances are built by the workers
+    int capacity = 0;
+    char *text = NULL;
+    size_t text_size = 0;
+    int line = 0;
+    while (getline(&text, &text_size, manifest) != -1) {
+        line++;
+        str_trim(text);
+        if (text[0] == '\0' || text[0] == '#') continue;
+
+        if (ctx.count == capacity) {
+            capacity = capacity ? 2 * capacity : 16;
+            ctx.jobs = tsp_realloc(ctx.jobs, capacity * sizeof(BatchJob));
+        }
+        if (parse_job(&ctx, text, line, &ctx.jobs[ctx.count])) ctx.count++;
+    }
+    free(text);
+    fclose(manifest);
+
+    const unsigned int pool_size = options->num_threads > 0 ? options->num_threads : (unsigned int) get_max_threads();
+    const unsigned int workers = pool_size < (unsigned int) ctx.count ? pool_size : (unsigned int) ctx.count;
+    if_verbose(VERBOSE_INFO, ">>> Starting Batch: %d jobs, %u threads, cache of %u instances\n", ctx.count,
+               workers, options->batch.cache_size);
+
+    pthread_t *threads = tsp_malloc((workers > 0 ? workers : 1) * sizeof(pthread_t));
+    unsigned int started = 0;
+    for (; started < workers; started++) {
+        if (pthread_create(&threads[started], NULL, batch_worker, &ctx) != 0) {
+            fprintf(stderr, "Error creating thread %u\n", started);
+            break;
+        }
+    }
+    if (started == 0) batch_worker(&ctx);
+    for (unsigned int t = 0; t < started; t++)
+        pthread_join(threads[t], NULL);
+    tsp_free(threads);
+    if_verbose(VERBOSE_INFO, "Batch: %d instances built\n", instance_cache_get_builds(ctx.cache));
+
+    for (int i = 0; i < ctx.count; i++) {
+        free(ctx.jobs[i].label);
+        cmd_options_destroy(ctx.jobs[i].options);
+    }
+    tsp_free(ctx.jobs);
+    instance_cache_destroy(ctx.cache);
+    pthread_mutex_destroy(&ctx.out_mutex);
+    if (out != stdout) fclose(out);
+
+    if_verbose(VERBOSE_INFO, "Batch: done\n");
+    return 0;
+}
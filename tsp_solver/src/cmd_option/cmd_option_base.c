@@ -11,6 +11,11 @@ static const OptionMeta options_registry[] = {
     {"--plots", NULL, "Enable plots", "general", "plots_enable", OPT_BOOL, offsetof(CmdOptions, plots_enable)},
     {"--threads", "-t", "Number of threads (default 1)", "general", "threads", OPT_UINT, offsetof(CmdOptions, num_threads)},
 
+    // COST RECORDER
+    {"--recorder-samples", NULL, "Cost samples kept per run, downsampled beyond (0 = unbounded, default 100000)", "recorder", "max_samples", OPT_UINT, offsetof(CmdOptions, recorder.max_samples)},
+    {"--recorder-improvements", NULL, "Record only the improving costs", "recorder", "improvements_only", OPT_BOOL, offsetof(CmdOptions, recorder.improvements_only)},
+    {"--recorder-csv", NULL, "Save the cost samples (seconds,cost,thread,event) next to each cost plot", "recorder", "csv", OPT_BOOL, offsetof(CmdOptions, recorder.csv)},
+
     // TSP INSTANCE
     {"--mode", "-m", "Input mode (0=Random, 1=File)", "tsp_inst", "mode", OPT_TSP_MODE, offsetof(CmdOptions, inst.mode)},
     {"--file", "-f", "Input .tsp file path", "tsp_inst", "file", OPT_STRING, offsetof(CmdOptions, inst.input_file)},
@@ -24,6 +29,23 @@ static const OptionMeta options_registry[] = {
     {"--sol-load-file", "-slf", "Input .tspsol file path", "tsp_sol", "load", OPT_STRING, offsetof(CmdOptions, sol.load_file)},
     {"--sol-save-file", "-ssf", "Output .tspsol file path", "tsp_sol", "save", OPT_STRING, offsetof(CmdOptions, sol.save_file)},
 
+    // PORTFOLIO
+    {"--portfolio", NULL, "Run the enabled algorithms concurrently on one shared solution", "portfolio", "enabled", OPT_BOOL, offsetof(CmdOptions, portfolio.enable)},
+    {"--portfolio-plot", NULL, "Portfolio plot filename", "portfolio", "plot_file", OPT_STRING, offsetof(CmdOptions, portfolio.plot_file)},
+
+    // PIPELINE
+    {"--pipeline", NULL, "Stages run in sequence on one solution, e.g. \"nn -> 2opt -> vns:2 -> tabu\"", "pipeline", "stages", OPT_STRING, offsetof(CmdOptions, pipeline.stages)},
+    {"--pipeline-seconds", NULL, "Total time limit, split among the stages by weight", "pipeline", "seconds", OPT_UDOUBLE, offsetof(CmdOptions, pipeline.time_limit)},
+    {"--pipeline-plot", NULL, "Pipeline plot filename", "pipeline", "plot_file", OPT_STRING, offsetof(CmdOptions, pipeline.plot_file)},
+    {"--pipeline-cost", NULL, "Pipeline cost filename", "pipeline", "cost_file", OPT_STRING, offsetof(CmdOptions, pipeline.cost_file)},
+
+    // BATCH
+    {"--batch", NULL, "Run every job of a manifest file in this process", "batch", "manifest", OPT_STRING, offsetof(CmdOptions, batch.manifest)},
+    {"--batch-output", NULL, "JSON-lines results file (default stdout)", "batch", "output", OPT_STRING, offsetof(CmdOptions, batch.output)},
+    {"--batch-cache", NULL, "Instances kept built by a batch (0 = unbounded, default 8)", "batch", "cache_size", OPT_UINT, offsetof(CmdOptions, batch.cache_size)},
+    {"--serve", NULL, "Serve solve requests on this Unix socket path", "serve", "socket", OPT_STRING, offsetof(CmdOptions, serve.socket_path)},
+    {"--serve-cache", NULL, "Instances kept built by the server (0 = unbounded, default 8)", "serve", "cache_size", OPT_UINT, offsetof(CmdOptions, serve.cache_size)},
+
     // NEAREST NEIGHBOR
     {"--nn", NULL, "Enable Nearest Neighbor", "nn", "enabled", OPT_BOOL, offsetof(CmdOptions, nn_params.enable)},
     {"--nn-seconds", NULL, "Time limit for NN", "nn", "seconds", OPT_UDOUBLE, offsetof(CmdOptions, nn_params.time_limit)},
@@ -37,6 +59,7 @@ static const OptionMeta options_registry[] = {
     {"--vns-max-k", NULL, "VNS Max K", "vns", "max_k", OPT_UINT, offsetof(CmdOptions, vns_params.max_k)},
     {"--vns-k-reps", NULL, "Kick repetitions", "vns", "kick-repetitions", OPT_UINT, offsetof(CmdOptions, vns_params.kick_repetitions)},
     {"--vns-stagnation", NULL, "Max Stagnation", "vns", "max-stagnation", OPT_UINT, offsetof(CmdOptions, vns_params.max_stagnation)},
+    {"--vns-kick", NULL, "Kick (nopt, double-bridge, segment, near-double-bridge)", "vns", "kick", OPT_STRING, offsetof(CmdOptions, vns_params.kick_name)},
     {"--vns-seconds", NULL, "Time limit for VNS", "vns", "seconds", OPT_UDOUBLE, offsetof(CmdOptions, vns_params.time_limit)},
     {"--vns-plot", NULL, "VNS plot filename", "vns", "plot_file", OPT_STRING, offsetof(CmdOptions, vns_params.plot_file)},
     {"--vns-cost", NULL, "VNS cost filename", "vns", "cost_file", OPT_STRING, offsetof(CmdOptions, vns_params.cost_file)},
@@ -55,6 +78,11 @@ static const OptionMeta options_registry[] = {
     {"--grasp-rcl-size", NULL, "RCL Size", "grasp", "rcl-size", OPT_UINT, offsetof(CmdOptions, grasp_params.rcl_size)},
     {"--grasp-probability", NULL, "RCL Probability", "grasp", "probability", OPT_UDOUBLE, offsetof(CmdOptions, grasp_params.probability)},
     {"--grasp-stagnation", NULL, "Max Stagnation", "grasp", "max-stagnation", OPT_UINT, offsetof(CmdOptions, grasp_params.max_stagnation)},
+    {"--grasp-construction", NULL, "RCL construction (candidates, full)", "grasp", "construction", OPT_STRING, offsetof(CmdOptions, grasp_params.construction_name)},
+    {"--grasp-dedup", NULL, "Skip repeated constructions and local optima", "grasp", "dedup", OPT_BOOL, offsetof(CmdOptions, grasp_params.deduplicate)},
+    {"--grasp-elite", NULL, "Elite pool size for path relinking (0=off)", "grasp", "elite", OPT_UINT, offsetof(CmdOptions, grasp_params.elite_size)},
+    {"--grasp-diversity", NULL, "Min fraction of differing edges for elites", "grasp", "diversity", OPT_UDOUBLE, offsetof(CmdOptions, grasp_params.elite_min_diversity)},
+    {"--grasp-relink", NULL, "Relinking direction (forward, backward, both)", "grasp", "relink", OPT_STRING, offsetof(CmdOptions, grasp_params.relinking_name)},
     {"--grasp-seconds", NULL, "Time limit for GRASP", "grasp", "seconds", OPT_UDOUBLE, offsetof(CmdOptions, grasp_params.time_limit)},
     {"--grasp-plot", NULL, "GRASP plot filename", "grasp", "plot_file", OPT_STRING, offsetof(CmdOptions, grasp_params.plot_file)},
     {"--grasp-cost", NULL, "GRASP cost filename", "grasp", "cost_file", OPT_STRING, offsetof(CmdOptions, grasp_params.cost_file)},
@@ -70,11 +98,18 @@ static const OptionMeta options_registry[] = {
     {"--ga-pop-size", NULL, "Population size", "genetic", "pop_size", OPT_UINT, offsetof(CmdOptions, genetic_params.population_size)},
     {"--ga-elite", NULL, "Elite count", "genetic", "elite_count", OPT_UINT, offsetof(CmdOptions, genetic_params.elite_count)},
     {"--ga-mutation", NULL, "Mutation rate", "genetic", "mutation_rate", OPT_UDOUBLE, offsetof(CmdOptions, genetic_params.mutation_rate)},
+    {"--ga-crossover", NULL, "Crossover operator (cut, eax)", "genetic", "crossover", OPT_STRING, offsetof(CmdOptions, genetic_params.crossover_name)},
     {"--ga-cut-min", NULL, "Crossover cut min ratio", "genetic", "cut_min", OPT_UINT, offsetof(CmdOptions, genetic_params.crossover_cut_min_ratio)},
     {"--ga-cut-max", NULL, "Crossover cut max ratio", "genetic", "cut_max", OPT_UINT, offsetof(CmdOptions, genetic_params.crossover_cut_max_ratio)},
     {"--ga-seconds", NULL, "Time limit for GA", "genetic", "seconds", OPT_UDOUBLE, offsetof(CmdOptions, genetic_params.time_limit)},
     {"--ga-plot", NULL, "GA plot filename", "genetic", "plot_file", OPT_STRING, offsetof(CmdOptions, genetic_params.plot_file)},
     {"--ga-cost", NULL, "GA cost filename", "genetic", "cost_file", OPT_STRING, offsetof(CmdOptions, genetic_params.cost_file)},
+    {"--ga-threads", NULL, "Offspring threads per generation (0=auto)", "genetic", "threads", OPT_UINT, offsetof(CmdOptions, genetic_params.num_threads)},
+    {"--ga-islands", NULL, "Island model: number of islands (1=off)", "genetic", "islands", OPT_UINT, offsetof(CmdOptions, genetic_params.num_islands)},
+    {"--ga-migration-interval", NULL, "Generations between migrations", "genetic", "migration_interval", OPT_UINT, offsetof(CmdOptions, genetic_params.migration_interval)},
+    {"--ga-migrants", NULL, "Individuals sent per migration", "genetic", "migrants", OPT_UINT, offsetof(CmdOptions, genetic_params.migration_count)},
+    {"--ga-topology", NULL, "Migration topology (ring, random)", "genetic", "topology", OPT_STRING, offsetof(CmdOptions, genetic_params.topology_name)},
+    {"--ga-dedup", NULL, "Reject duplicate children", "genetic", "dedup", OPT_BOOL, offsetof(CmdOptions, genetic_params.deduplicate)},
     {"--ga-tournament", NULL, "Tournament size", "genetic", "tournament_size", OPT_UINT, offsetof(CmdOptions, genetic_params.tournament_size)},
     {"--ga-grasp-rcl", NULL, "Init GRASP RCL size", "genetic", "grasp_rcl", OPT_UINT, offsetof(CmdOptions, genetic_params.init_grasp_rcl_size)},
     {"--ga-grasp-prob", NULL, "Init GRASP probability", "genetic", "grasp_prob", OPT_UDOUBLE, offsetof(CmdOptions, genetic_params.init_grasp_prob)},
@@ -91,6 +126,8 @@ static const OptionMeta options_registry[] = {
     {"--bc", NULL, "Enable Branch and Cut", "bc", "enabled", OPT_BOOL, offsetof(CmdOptions, bc_params.enable)},
     {"--bc-seconds", NULL, "Time limit for Branch and Cut", "bc", "seconds", OPT_UDOUBLE, offsetof(CmdOptions, bc_params.time_limit)},
     {"--bc-threads", NULL, "Number of threads (0=auto)", "bc", "threads", OPT_UINT, offsetof(CmdOptions, bc_params.num_threads)},
+    {"--bc-cut-depth", NULL, "Deepest node with fractional SEC cuts (-1=off, 0=root)", "bc", "cut_depth", OPT_INT, offsetof(CmdOptions, bc_params.cut_depth)},
+    {"--bc-sparse-k", NULL, "Nearest neighbors per node of the sparse model with edge pricing (0=complete graph)", "bc", "sparse_k", OPT_INT, offsetof(CmdOptions, bc_params.sparse_k)},
     {"--bc-plot", NULL, "Branch and Cut plot filename", "bc", "plot_file", OPT_STRING, offsetof(CmdOptions, bc_params.plot_file)},
     {"--bc-cost", NULL, "Branch and Cut cost filename", "bc", "cost_file", OPT_STRING, offsetof(CmdOptions, bc_params.cost_file)},
 
@@ -104,6 +141,7 @@ static const OptionMeta options_registry[] = {
     {"--hf-cost", NULL, "HF cost filename", "hf", "cost_file", OPT_STRING, offsetof(CmdOptions, hf_params.cost_file)},
     {"--hf-slice", NULL, "Time slice factor (0.0-1.0)", "hf", "slice_factor", OPT_UDOUBLE, offsetof(CmdOptions, hf_params.time_slice_factor)},
     {"--hf-min-slice", NULL, "Min time per iteration (s)", "hf", "min_slice", OPT_UDOUBLE, offsetof(CmdOptions, hf_params.min_time_slice)},
+    {"--hf-threads", NULL, "CPLEX threads per worker (0=split the cores among --threads workers)", "hf", "threads", OPT_UINT, offsetof(CmdOptions, hf_params.num_threads)},
 
     // LOCAL BRANCHING (MATHEURISTIC)
     {"--lb", NULL, "Enable Local Branching", "lb", "enabled", OPT_BOOL, offsetof(CmdOptions, lb_params.enable)},
@@ -140,6 +178,35 @@ static void set_tsp_sol_defaults(TspSolutionOptions *opt) {
     opt->save_file = NULL;
 }
 
+static void set_portfolio_defaults(PortfolioOptions *opt) {
+    opt->enable = false;
+    opt->plot_file = strdup("PF-plot.png");
+}
+
+static void set_recorder_defaults(RecorderOptions *opt) {
+    opt->max_samples = 100000;
+    opt->improvements_only = false;
+    opt->csv = false;
+}
+
+static void set_pipeline_defaults(PipelineOptions *opt) {
+    opt->stages = NULL;
+    opt->time_limit = 60.0;
+    opt->plot_file = strdup("PL-plot.png");
+    opt->cost_file = strdup("PL-costs.png");
+}
+
+static void set_batch_defaults(BatchOptions *opt) {
+    opt->manifest = NULL;
+    opt->output = NULL;
+    opt->cache_size = 8;
+}
+
+static void set_serve_defaults(ServeOptions *opt) {
+    opt->socket_path = NULL;
+    opt->cache_size = 8;
+}
+
 static void set_nn_defaults(NNOptions *opt) {
     opt->enable = false;
     opt->num_threads = 1;
@@ -157,6 +224,7 @@ static void set_vns_defaults(VnsOptions *opt) {
     opt->time_limit = 10.0;
     opt->plot_file = strdup("VNS-plot.png");
     opt->cost_file = strdup("VNS-costs.png");
+    opt->kick_name = strdup("nopt");
 }
 
 static void set_tabu_defaults(TabuOptions *opt) {
@@ -177,6 +245,11 @@ static void set_grasp_defaults(GraspOptions *opt) {
     opt->time_limit = 10.0;
     opt->plot_file = strdup("GR-plot.png");
     opt->cost_file = strdup("GR-costs.png");
+    opt->elite_size = 0;
+    opt->elite_min_diversity = 0.05;
+    opt->relinking_name = strdup("backward");
+    opt->construction_name = strdup("candidates");
+    opt->deduplicate = false;
 }
 
 static void set_em_defaults(EMOptions *opt) {
@@ -200,6 +273,13 @@ static void set_genetic_defaults(GeneticOptions *opt) {
     opt->init_grasp_rcl_size = 5;
     opt->init_grasp_prob = 0.2;
     opt->init_grasp_percent = 90;
+    opt->crossover_name = strdup("cut");
+    opt->num_threads = 1;
+    opt->num_islands = 1;
+    opt->migration_interval = 20;
+    opt->migration_count = 2;
+    opt->topology_name = strdup("ring");
+    opt->deduplicate = false;
 }
 
 static void set_benders_defaults(BendersOptions *opt) {
@@ -214,6 +294,8 @@ static void set_bc_defaults(BranchCutOptions *opt) {
     opt->enable = false;
     opt->time_limit = 60.0;
     opt->num_threads = 0;
+    opt->cut_depth = 10;
+    opt->sparse_k = 0;
     opt->plot_file = strdup("BC-plot.png");
     opt->cost_file = strdup("BC-costs.png");
 }
@@ -228,6 +310,7 @@ static void set_hf_defaults(HardFixingOptions *opt) {
     opt->plot_file = strdup("HF-plot.png");
     opt->cost_file = strdup("HF-costs.png");
     opt->heuristic_name = strdup("vns");
+    opt->num_threads = 0;
 }
 
 static void set_lb_defaults(LocalBranchingOptions *opt) {
@@ -251,6 +334,11 @@ CmdOptions *cmd_options_create_defaults(void) {
 
     set_tsp_inst_defaults(&opt->inst);
     set_tsp_sol_defaults(&opt->sol);
+    set_recorder_defaults(&opt->recorder);
+    set_portfolio_defaults(&opt->portfolio);
+    set_pipeline_defaults(&opt->pipeline);
+    set_batch_defaults(&opt->batch);
+    set_serve_defaults(&opt->serve);
     set_nn_defaults(&opt->nn_params);
     set_vns_defaults(&opt->vns_params);
     set_tabu_defaults(&opt->tabu_params);
@@ -277,23 +365,38 @@ void cmd_options_destroy(CmdOptions *opt) {
     tsp_free(opt->sol.load_file);
     tsp_free(opt->sol.save_file);
 
+    tsp_free(opt->portfolio.plot_file);
+
+    tsp_free(opt->pipeline.stages);
+    tsp_free(opt->pipeline.plot_file);
+    tsp_free(opt->pipeline.cost_file);
+
+    tsp_free(opt->batch.manifest);
+    tsp_free(opt->batch.output);
+    tsp_free(opt->serve.socket_path);
+
     tsp_free(opt->nn_params.plot_file);
     tsp_free(opt->nn_params.cost_file);
 
     tsp_free(opt->vns_params.plot_file);
     tsp_free(opt->vns_params.cost_file);
+    tsp_free(opt->vns_params.kick_name);
 
     tsp_free(opt->tabu_params.plot_file);
     tsp_free(opt->tabu_params.cost_file);
 
     tsp_free(opt->grasp_params.plot_file);
     tsp_free(opt->grasp_params.cost_file);
+    tsp_free(opt->grasp_params.relinking_name);
+    tsp_free(opt->grasp_params.construction_name);
 
     tsp_free(opt->em_params.plot_file);
     tsp_free(opt->em_params.cost_file);
 
     tsp_free(opt->genetic_params.plot_file);
     tsp_free(opt->genetic_params.cost_file);
+    tsp_free(opt->genetic_params.crossover_name);
+    tsp_free(opt->genetic_params.topology_name);
 
     tsp_free(opt->benders_params.plot_file);
     tsp_free(opt->benders_params.cost_file);
@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "c_util.h"
+#include "pipeline.h"
 
 static const ParsingResult *validate_options(CmdOptions *opt) {
     if_verbose(VERBOSE_DEBUG, "Starting configuration validation...\n");
@@ -32,6 +33,15 @@ static const ParsingResult *validate_options(CmdOptions *opt) {
         }
     }
 
+    if (opt->pipeline.stages && strlen(opt->pipeline.stages) > 0) {
+        Pipeline pipeline;
+        if (!pipeline_parse(opt->pipeline.stages, &pipeline)) return WRONG_VALUE_TYPE;
+        if (opt->pipeline.time_limit <= 0.0) {
+            if_verbose(VERBOSE_INFO, "[Config Error] Pipeline time limit must be > 0.\n");
+            return WRONG_VALUE_TYPE;
+        }
+    }
+
     if (opt->nn_params.enable) {
         if (opt->nn_params.time_limit < 0.0) {
             if_verbose(VERBOSE_INFO, "[Config Error] NN: time limit cannot be negative.\n");
@@ -96,6 +106,10 @@ static const ParsingResult *validate_options(CmdOptions *opt) {
             if_verbose(VERBOSE_INFO, "[Config Error] GRASP: time limit cannot be negative.\n");
             return WRONG_VALUE_TYPE;
         }
+        if (opt->grasp_params.elite_min_diversity > 1.0) {
+            if_verbose(VERBOSE_INFO, "[Config Error] GRASP: elite diversity must be in [0,1].\n");
+            return WRONG_VALUE_TYPE;
+        }
     }
 
     if (opt->em_params.enable) {
@@ -134,6 +148,20 @@ static const ParsingResult *validate_options(CmdOptions *opt) {
             if_verbose(VERBOSE_INFO, "[Config Error] Genetic: Time limit cannot be negative.\n");
             return WRONG_VALUE_TYPE;
         }
+        if (opt->genetic_params.num_threads > max_threads) {
+            if_verbose(VERBOSE_INFO,
+                       "[Config Warning] GA thread count (%u) is greater than system cores (%u). Performance may degrade.\n",
+                       opt->genetic_params.num_threads, max_threads);
+        }
+        if (opt->genetic_params.num_islands > 1 && opt->genetic_params.migration_interval == 0) {
+            if_verbose(VERBOSE_INFO, "[Config Error] Genetic: migration interval must be positive.\n");
+            return WRONG_VALUE_TYPE;
+        }
+        if (opt->genetic_params.num_islands > max_threads) {
+            if_verbose(VERBOSE_INFO,
+                       "[Config Warning] GA island count (%u) is greater than system cores (%u). Performance may degrade.\n",
+                       opt->genetic_params.num_islands, max_threads);
+        }
     }
 
     if (opt->benders_params.enable) {
@@ -152,6 +180,14 @@ static const ParsingResult *validate_options(CmdOptions *opt) {
             if_verbose(VERBOSE_INFO, "[Config Error] Branch & Cut: time limit cannot be negative.\n");
             return WRONG_VALUE_TYPE;
         }
+        if (opt->bc_params.cut_depth < -1) {
+            if_verbose(VERBOSE_INFO, "[Config Error] Branch & Cut: cut depth must be >= -1.\n");
+            return WRONG_VALUE_TYPE;
+        }
+        if (opt->bc_params.sparse_k < 0) {
+            if_verbose(VERBOSE_INFO, "[Config Error] Branch & Cut: sparse k must be >= 0.\n");
+            return WRONG_VALUE_TYPE;
+        }
     }
 
     if (opt->hf_params.enable) {
@@ -300,6 +336,18 @@ void print_configuration(const CmdOptions *options) {
                "Nodes:               %u\n"
                "Seed:                %d\n"
                "Area:                %d,%d (side %u)\n"
+               "Cost samples:        %u%s%s\n"
+               "Portfolio:           %s\n"
+               "  plot:              %s\n"
+               "Pipeline:            %s\n"
+               "  plot:              %s\n"
+               "  cost:              %s\n"
+               "  time limit:        %.3f\n"
+               "Batch manifest:      %s\n"
+               "  output:            %s\n"
+               "  cache size:        %u\n"
+               "Server socket:       %s\n"
+               "  cache size:        %u\n"
                "\n\n"
                "--- Algorithms ---\n"
                "Nearest Neighbor:    %s\n"
@@ -318,6 +366,7 @@ void print_configuration(const CmdOptions *options) {
                "  cost:              %s\n"
                "  kicks MIN-MAX:     %u-%u\n"
                "  kicks reps:        %u\n"
+               "  kick type:         %s\n"
                "  max stagnation:    %u\n"
                "  time limit:        %.3f\n"
                "\n"
@@ -334,6 +383,11 @@ void print_configuration(const CmdOptions *options) {
                "  RCL size:          %d\n"
                "  probability:       %.3f\n"
                "  max stagnation:    %d\n"
+               "  construction:      %s\n"
+               "  dedup:             %s\n"
+               "  elite size:        %u\n"
+               "  elite diversity:   %.3f\n"
+               "  relinking:         %s\n"
                "  time limit:        %.3f\n"
                "\n"
                "Genetic Algorithm:   %s\n"
@@ -342,8 +396,13 @@ void print_configuration(const CmdOptions *options) {
                "  pop size:          %d\n"
                "  elite count:       %d\n"
                "  mutation rate:     %.3f\n"
+               "  crossover:         %s\n"
                "  cut ratio MIN-MAX: %d-%d\n"
                "  tournament size:   %d\n"
+               "  threads:           %u\n"
+               "  islands:           %u\n"
+               "  migration:         %u every %u gens (%s)\n"
+               "  dedup:             %s\n"
                "  init GRASP RCL:    %d\n"
                "  init GRASP prob:   %.3f\n"
                "  init GRASP %%:      %d\n"
@@ -360,6 +419,8 @@ void print_configuration(const CmdOptions *options) {
                "  cost:              %s\n"
                "  threads:           %u\n"
                "  time limit:        %.3f\n"
+               "  cut depth:         %d\n"
+               "  sparse k:          %d\n"
                "\n"
                "Hard Fixing:         %s\n"
                "  plot:              %s\n"
@@ -370,6 +431,7 @@ void print_configuration(const CmdOptions *options) {
                "  slice factor:      %.3f\n"
                "  min slice:         %.3f\n"
                "  heuristic:         %s\n"
+               "  threads:           %u\n"
                "\n"
                "Local Branching:     %s\n"
                "  plot:              %s\n"
@@ -391,6 +453,20 @@ void print_configuration(const CmdOptions *options) {
                options->inst.generation_area.x_square,
                options->inst.generation_area.y_square,
                options->inst.generation_area.square_side,
+               options->recorder.max_samples,
+               options->recorder.improvements_only ? " (improvements only)" : "",
+               options->recorder.csv ? " + csv" : "",
+               options->portfolio.enable ? "ENABLED" : "DISABLED",
+               options->portfolio.plot_file ? options->portfolio.plot_file : "(none)",
+               options->pipeline.stages ? options->pipeline.stages : "(none)",
+               options->pipeline.plot_file ? options->pipeline.plot_file : "(none)",
+               options->pipeline.cost_file ? options->pipeline.cost_file : "(none)",
+               options->pipeline.time_limit,
+               options->batch.manifest ? options->batch.manifest : "(none)",
+               options->batch.output ? options->batch.output : "(stdout)",
+               options->batch.cache_size,
+               options->serve.socket_path ? options->serve.socket_path : "(none)",
+               options->serve.cache_size,
 
                options->nn_params.enable ? "ENABLED" : "DISABLED",
                options->nn_params.plot_file ? options->nn_params.plot_file : "(none)",
@@ -409,6 +485,7 @@ void print_configuration(const CmdOptions *options) {
                options->vns_params.min_k,
                options->vns_params.max_k,
                options->vns_params.kick_repetitions,
+               options->vns_params.kick_name ? options->vns_params.kick_name : "(none)",
                options->vns_params.max_stagnation,
                options->vns_params.time_limit,
 
@@ -426,6 +503,11 @@ void print_configuration(const CmdOptions *options) {
                options->grasp_params.rcl_size,
                options->grasp_params.probability,
                options->grasp_params.max_stagnation,
+               options->grasp_params.construction_name ? options->grasp_params.construction_name : "(none)",
+               options->grasp_params.deduplicate ? "yes" : "no",
+               options->grasp_params.elite_size,
+               options->grasp_params.elite_min_diversity,
+               options->grasp_params.relinking_name ? options->grasp_params.relinking_name : "(none)",
                options->grasp_params.time_limit,
 
                options->genetic_params.enable ? "ENABLED" : "DISABLED",
@@ -434,9 +516,16 @@ void print_configuration(const CmdOptions *options) {
                options->genetic_params.population_size,
                options->genetic_params.elite_count,
                options->genetic_params.mutation_rate,
+               options->genetic_params.crossover_name ? options->genetic_params.crossover_name : "(none)",
                options->genetic_params.crossover_cut_min_ratio,
                options->genetic_params.crossover_cut_max_ratio,
                options->genetic_params.tournament_size,
+               options->genetic_params.num_threads,
+               options->genetic_params.num_islands,
+               options->genetic_params.migration_count,
+               options->genetic_params.migration_interval,
+               options->genetic_params.topology_name ? options->genetic_params.topology_name : "(none)",
+               options->genetic_params.deduplicate ? "yes" : "no",
                options->genetic_params.init_grasp_rcl_size,
                options->genetic_params.init_grasp_prob,
                options->genetic_params.init_grasp_percent,
@@ -453,6 +542,8 @@ void print_configuration(const CmdOptions *options) {
                options->bc_params.cost_file ? options->bc_params.cost_file : "(none)",
                options->bc_params.num_threads,
                options->bc_params.time_limit,
+               options->bc_params.cut_depth,
+               options->bc_params.sparse_k,
 
                options->hf_params.enable ? "ENABLED" : "DISABLED",
                options->hf_params.plot_file ? options->hf_params.plot_file : "(none)",
@@ -463,6 +554,7 @@ void print_configuration(const CmdOptions *options) {
                options->hf_params.time_slice_factor,
                options->hf_params.min_time_slice,
                options->hf_params.heuristic_name ? options->hf_params.heuristic_name : "(none)",
+               options->hf_params.num_threads,
 
                options->lb_params.enable ? "ENABLED" : "DISABLED",
                options->lb_params.plot_file ? options->lb_params.plot_file : "(none)",
@@ -0,0 +1,25 @@
+#include "command_line.h"
+
+#include <ctype.h>
+#include <stdbool.h>
+
+int split_command_line(char *line, const char **argv, const int max_args) {
+    int argc = 0;
+    char *p = line;
+    while (*p && argc < max_args) {
+        while (isspace((unsigned char) *p)) p++;
+        if (!*p) break;
+
+        char *dst = p;
+        argv[argc++] = dst;
+        bool quoted = false;
+        while (*p && (quoted || !isspace((unsigned char) *p))) {
+            if (*p == '"') quoted = !quoted;
+            else *dst++ = *p;
+            p++;
+        }
+        if (*p) p++;
+        *dst = '\0';
+    }
+    return argc;
+}
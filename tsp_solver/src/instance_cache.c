@@ -0,0 +1,216 @@
+#include "instance_cache.h"
+#include "c_util.h"
+#include "logger.h"
+#include "random.h"
+
+#include <linux/limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CACHE_KEY_SIZE (PATH_MAX + 64)
+
+typedef struct {
+    char key[CACHE_KEY_SIZE];
+    TspInstance *instance;
+    int refcount;
+    unsigned long last_used;
+    bool pending; // being built outside the lock: instance is NULL until then
+} CacheEntry;
+
+struct InstanceCache {
+    CacheEntry *entries;
+    int count;
+    int allocated;
+    int capacity;
+    int builds;
+    unsigned long clock;
+    pthread_mutex_t mutex;
+    pthread_cond_t built; // broadcast when a pending entry is built or dropped
+    pthread_mutex_t random_mutex; // the random instances are generated with the global generator
+};
+
+InstanceCache *instance_cache_create(const int capacity) {
+    InstanceCache *cache = tsp_calloc(1, sizeof(InstanceCache));
+    cache->capacity = capacity;
+    pthread_mutex_init(&cache->mutex, NULL);
+    pthread_cond_init(&cache->built, NULL);
+    pthread_mutex_init(&cache->random_mutex, NULL);
+    return cache;
+}
+
+void instance_cache_destroy(InstanceCache *cache) {
+    if (!cache) return;
+    for (int i = 0; i < cache->count; i++)
+        tsp_instance_destroy(cache->entries[i].instance);
+    tsp_free(cache->entries);
+    pthread_mutex_destroy(&cache->mutex);
+    pthread_cond_destroy(&cache->built);
+    pthread_mutex_destroy(&cache->random_mutex);
+    tsp_free(cache);
+}
+
+static void remove_entry(InstanceCache *cache, const int i) {
+    tsp_instance_destroy(cache->entries[i].instance);
+    cache->entries[i] = cache->entries[--cache->count];
+}
+
+/*
+ * Evicts least recently used unreferenced entries until at most `limit` are left. Instances in use are never
+ * evicted (it would free nothing while their jobs run): the cache then stays above the limit until they are
+ * released.
+ */
+static void shrink_to(InstanceCache *cache, const int limit) {
+    while (cache->capacity > 0 && cache->count > limit) {
+        int victim = -1;
+        for (int i = 0; i < cache->count; i++) {
+            const CacheEntry *e = &cache->entries[i];
+            if (e->refcount > 0) continue; // also the pending entries, referenced by their builder
+            if (victim < 0 || e->last_used < cache->entries[victim].last_used) victim = i;
+        }
+        if (victim < 0) return;
+
+        if_verbose(VERBOSE_DEBUG, "InstanceCache: evicting %s\n", cache->entries[victim].key);
+        remove_entry(cache, victim);
+    }
+}
+
+typedef TspInstance *(*BuildFn)(InstanceCache *cache, const void *arg);
+
+/*
+ * Returns the entry of key, referenced, or builds it outside the lock: a pending entry makes concurrent
+ * acquirers of the same key wait for that build, while other keys are served meanwhile.
+ */
+static const TspInstance *acquire(InstanceCache *cache, const char *key, const BuildFn build, const void *arg) {
+    pthread_mutex_lock(&cache->mutex);
+    for (int i = 0; i < cache->count; i++) {
+        CacheEntry *e = &cache->entries[i];
+        if (strcmp(e->key, key) != 0) continue;
+        if (e->pending) {
+            // Entries move while unlocked: scan again once the build is over
+            pthread_cond_wait(&cache->built, &cache->mutex);
+            i = -1;
+            continue;
+        }
+        e->refcount++;
+        e->last_used = ++cache->clock;
+        pthread_mutex_unlock(&cache->mutex);
+        return e->instance;
+    }
+
+    shrink_to(cache, cache->capacity - 1);
+    if (cache->count == cache->allocated) {
+        cache->allocated = cache->allocated ? 2 * cache->allocated : 8;
+        cache->entries = tsp_realloc(cache->entries, cache->allocated * sizeof(CacheEntry));
+    }
+    CacheEntry *pending = &cache->entries[cache->count++];
+    snprintf(pending->key, CACHE_KEY_SIZE, "%s", key);
+    pending->instance = NULL;
+    pending->refcount = 1;
+    pending->last_used = ++cache->clock;
+    pending->pending = true;
+    pthread_mutex_unlock(&cache->mutex);
+
+    TspInstance *instance = build(cache, arg);
+    // Built here once, instead of by the first algorithm of every solve
+    if (instance) tsp_instance_get_candidate_lists(instance);
+
+    pthread_mutex_lock(&cache->mutex);
+    int i = 0;
+    while (!cache->entries[i].pending || strcmp(cache->entries[i].key, key) != 0) i++;
+    if (instance) {
+        cache->entries[i].instance = instance;
+        cache->entries[i].pending = false;
+        cache->builds++;
+        if_verbose(VERBOSE_INFO, "InstanceCache: built %s (%d nodes)\n", key, tsp_instance_get_num_nodes(instance));
+    } else {
+        remove_entry(cache, i);
+    }
+    pthread_cond_broadcast(&cache->built);
+    pthread_mutex_unlock(&cache->mutex);
+    return instance;
+}
+
+static TspInstance *build_from_options(InstanceCache *cache, const void *arg) {
+    const TspInstanceOptions *options = arg;
+    TspInstance *instance = NULL;
+    if (options->mode == TSP_INPUT_MODE_FILE) {
+        const TspError err = tsp_instance_load_from_file(&instance, options->input_file);
+        if (err != TSP_OK) {
+            if_verbose(VERBOSE_INFO, "[ERROR] InstanceCache: failed to load %s: %s\n", options->input_file,
+                       tsp_error_to_string(err));
+            return NULL;
+        }
+        return instance;
+    }
+
+    // Same generation as a standalone run with this seed; the global generator is only used here
+    const TspGenerationArea area = {
+        .x_square = options->generation_area.x_square,
+        .y_square = options->generation_area.y_square,
+        .square_side = options->generation_area.square_side
+    };
+    pthread_mutex_lock(&cache->random_mutex);
+    global_random_init(options->seed);
+    instance = tsp_instance_create_random(options->number_of_nodes, area);
+    pthread_mutex_unlock(&cache->random_mutex);
+    return instance;
+}
+
+const TspInstance *instance_cache_acquire(InstanceCache *cache, const TspInstanceOptions *options) {
+    char key[CACHE_KEY_SIZE];
+    if (options->mode == TSP_INPUT_MODE_FILE) {
+        snprintf(key, CACHE_KEY_SIZE, "file:%s", options->input_file);
+    } else {
+        snprintf(key, CACHE_KEY_SIZE, "random:%u:%d:%d:%d:%u", options->number_of_nodes, options->seed,
+                 options->generation_area.x_square, options->generation_area.y_square,
+                 options->generation_area.square_side);
+    }
+    return acquire(cache, key, build_from_options, options);
+}
+
+typedef struct {
+    const Node *nodes;
+    int n;
+} NodesArg;
+
+static TspInstance *build_from_nodes(InstanceCache *cache, const void *arg) {
+    (void) cache;
+    const NodesArg *nodes = arg;
+    return tsp_instance_create(nodes->nodes, nodes->n);
+}
+
+const TspInstance *instance_cache_acquire_nodes(InstanceCache *cache, const Node *nodes, const int n) {
+    // FNV-1a over the raw coordinates: requests repeating the same points share the instance
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const unsigned char *bytes = (const unsigned char *) nodes;
+    for (size_t i = 0; i < (size_t) n * sizeof(Node); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    char key[CACHE_KEY_SIZE];
+    snprintf(key, CACHE_KEY_SIZE, "nodes:%d:%016llx", n, (unsigned long long) hash);
+
+    const NodesArg arg = {.nodes = nodes, .n = n};
+    return acquire(cache, key, build_from_nodes, &arg);
+}
+
+void instance_cache_release(InstanceCache *cache, const TspInstance *instance) {
+    pthread_mutex_lock(&cache->mutex);
+    for (int i = 0; i < cache->count; i++) {
+        CacheEntry *e = &cache->entries[i];
+        if (e->instance != instance) continue;
+        // An instance released by its last job may now make room for the ones built meanwhile
+        if (--e->refcount == 0) shrink_to(cache, cache->capacity);
+        break;
+    }
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+int instance_cache_get_builds(InstanceCache *cache) {
+    pthread_mutex_lock(&cache->mutex);
+    const int builds = cache->builds;
+    pthread_mutex_unlock(&cache->mutex);
+    return builds;
+}
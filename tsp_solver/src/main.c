@@ -1,5 +1,8 @@
 #include <stdio.h>
+#include <string.h>
 #include "algorithm_runner.h"
+#include "batch_runner.h"
+#include "solver_server.h"
 #include "cmd_options.h"
 #include "tsp_instance.h"
 #include "logger.h"
@@ -66,6 +69,20 @@ int main(const int argc, const char *argv[]) {
     setup_global_services(options);
     print_configuration(options);
 
+    // Batch mode builds its own instances, one per distinct manifest entry
+    if (options->batch.manifest && strlen(options->batch.manifest) > 0) {
+        const int exit_code = run_batch(options);
+        cmd_options_destroy(options);
+        return exit_code;
+    }
+
+    // Server mode builds the instances of its clients
+    if (options->serve.socket_path && strlen(options->serve.socket_path) > 0) {
+        const int exit_code = run_server(options);
+        cmd_options_destroy(options);
+        return exit_code;
+    }
+
     // Create/Load Instance
     TspInstance *instance = create_tsp_instance(options);
     if (!instance) {
@@ -75,7 +92,7 @@ int main(const int argc, const char *argv[]) {
     }
 
     // Run Algorithms
-    run_selected_algorithms(instance, options);
+    run_selected_algorithms(instance, options, NULL, NULL);
 
     // Cleanup
     tsp_instance_destroy(instance);
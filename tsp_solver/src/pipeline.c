@@ -0,0 +1,112 @@
+#include "pipeline.h"
+#include "logger.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+typedef struct {
+    const char *name;
+    PipelineStageKind kind;
+} StageAlias;
+
+static const StageAlias stage_aliases[] = {
+    {"nn", STAGE_NN},
+    {"greedy", STAGE_NN},
+    {"em", STAGE_EM},
+    {"2opt", STAGE_TWO_OPT},
+    {"vns", STAGE_VNS},
+    {"tabu", STAGE_TABU},
+    {"ts", STAGE_TABU},
+    {"grasp", STAGE_GRASP},
+    {"ga", STAGE_GENETIC},
+    {"genetic", STAGE_GENETIC},
+    {"benders", STAGE_BENDERS},
+    {"bc", STAGE_BC},
+    {"hf", STAGE_HF},
+    {"lb", STAGE_LB},
+};
+
+/* Trims in place and returns the first non-blank character. */
+static char *trim(char *s) {
+    while (isspace((unsigned char) *s)) s++;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char) end[-1])) end--;
+    *end = '\0';
+    return s;
+}
+
+static bool parse_stage(char *token, PipelineStage *stage) {
+    char *colon = strchr(token, ':');
+    stage->weight = 1.0;
+    if (colon) {
+        *colon = '\0';
+        char *weight = trim(colon + 1);
+        char *end;
+        stage->weight = strtod(weight, &end);
+        if (end == weight || *end != '\0' || stage->weight <= 0.0) {
+            if_verbose(VERBOSE_INFO, "[Config Error] Pipeline weight '%s' must be a positive number.\n", weight);
+            return false;
+        }
+    }
+
+    const char *name = trim(token);
+    for (size_t i = 0; i < sizeof(stage_aliases) / sizeof(stage_aliases[0]); i++) {
+        if (strcasecmp(name, stage_aliases[i].name) == 0) {
+            stage->kind = stage_aliases[i].kind;
+            return true;
+        }
+    }
+    if_verbose(VERBOSE_INFO, "[Config Error] Unknown pipeline stage '%s'.\n", name);
+    return false;
+}
+
+bool pipeline_parse(const char *spec, Pipeline *pipeline) {
+    pipeline->count = 0;
+    if (!spec) return false;
+
+    char *copy = strdup(spec);
+    bool ok = true;
+    char *cursor = copy;
+    while (ok) {
+        char *arrow = strstr(cursor, "->");
+        if (arrow) *arrow = '\0';
+
+        if (pipeline->count == PIPELINE_MAX_STAGES) {
+            if_verbose(VERBOSE_INFO, "[Config Error] Pipeline has more than %d stages.\n", PIPELINE_MAX_STAGES);
+            ok = false;
+        } else {
+            ok = parse_stage(cursor, &pipeline->stages[pipeline->count++]);
+        }
+
+        if (!arrow) break;
+        cursor = arrow + 2;
+    }
+    free(copy);
+    return ok;
+}
+
+double pipeline_stage_seconds(const Pipeline *pipeline, const int i, const double total_seconds) {
+    double total_weight = 0.0;
+    for (int k = 0; k < pipeline->count; k++) total_weight += pipeline->stages[k].weight;
+    return total_seconds * pipeline->stages[i].weight / total_weight;
+}
+
+const char *pipeline_stage_name(const PipelineStageKind kind) {
+    switch (kind) {
+        case STAGE_NN: return "nn";
+        case STAGE_EM: return "em";
+        case STAGE_TWO_OPT: return "2opt";
+        case STAGE_VNS: return "vns";
+        case STAGE_TABU: return "tabu";
+        case STAGE_GRASP: return "grasp";
+        case STAGE_GENETIC: return "ga";
+        case STAGE_BENDERS: return "benders";
+        case STAGE_BC: return "bc";
+        case STAGE_HF: return "hf";
+        case STAGE_LB: return "lb";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,405 @@
+#include "solver_server.h"
+#include "algorithm_runner.h"
+#include "command_line.h"
+#include "instance_cache.h"
+#include "cancel_token.h"
+#include "chrono.h"
+#include "c_util.h"
+#include "logger.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define SERVER_MAX_ARGS 128
+#define SERVER_BACKLOG 16
+
+typedef struct Server Server;
+typedef struct Session Session;
+
+typedef struct Job {
+    Session *session;
+    CmdOptions *options;
+    const TspInstance *instance;
+    CancelToken *cancel;
+    double start_time;
+
+    pthread_mutex_t mutex; // guards everything below
+    pthread_cond_t done_cond;
+    bool done;
+    int n;
+    int *best_tour; // best tour over all the algorithms of the solve, starting from the initial tour
+    double best_cost;
+    double best_time; // seconds from the start of the solve to best_cost
+    pthread_cond_t stream_cond;
+    bool improved; // best_cost not streamed yet
+    bool solved; // the algorithms are over: the streamer exits once nothing is pending
+
+    struct Job *next; // server queue link
+} Job;
+
+struct Session {
+    Server *server;
+    int fd;
+    pthread_mutex_t write_mutex;
+    Job *active;
+};
+
+struct Server {
+    InstanceCache *cache;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    Job *head;
+    Job *tail;
+};
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_stop_signal(const int signum) {
+    (void) signum;
+    stop_requested = 1;
+}
+
+static void session_send(Session *session, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    pthread_mutex_lock(&session->write_mutex);
+    vdprintf(session->fd, format, args);
+    pthread_mutex_unlock(&session->write_mutex);
+    va_end(args);
+}
+
+/*
+ * Called under the solution lock: only records global improvements of the solve, so that a slow client
+ * never holds up the solver threads. The job's streamer writes them to the socket.
+ */
+static void on_improvement(const int *tour, const int n, const double cost, void *user_data) {
+    Job *job = user_data;
+    pthread_mutex_lock(&job->mutex);
+    if (cost < job->best_cost) {
+        job->best_cost = cost;
+        job->best_time = second() - job->start_time;
+        memcpy(job->best_tour, tour, (n + 1) * sizeof(int));
+        job->improved = true;
+        pthread_cond_signal(&job->stream_cond);
+    }
+    pthread_mutex_unlock(&job->mutex);
+}
+
+/* Streams the incumbents of a job outside every lock; improvements found during a write are coalesced. */
+static void *stream_main(void *arg) {
+    Job *job = arg;
+    pthread_mutex_lock(&job->mutex);
+    for (;;) {
+        while (!job->improved && !job->solved) pthread_cond_wait(&job->stream_cond, &job->mutex);
+        if (!job->improved) break;
+        job->improved = false;
+        const double cost = job->best_cost;
+        const double seconds = job->best_time;
+        pthread_mutex_unlock(&job->mutex);
+        session_send(job->session, "INCUMBENT %.6f %.4f\n", cost, seconds);
+        pthread_mutex_lock(&job->mutex);
+    }
+    pthread_mutex_unlock(&job->mutex);
+    return NULL;
+}
+
+static void run_job(Server *server, Job *job) {
+    Session *session = job->session;
+    AlgorithmResult results[MAX_ALGORITHM_RESULTS];
+    const RunHooks hooks = {.cancel = job->cancel, .on_improvement = on_improvement, .user_data = job};
+
+    job->start_time = second();
+    pthread_t streamer;
+    const bool streaming = pthread_create(&streamer, NULL, stream_main, job) == 0;
+    if (!streaming) if_verbose(VERBOSE_INFO, "[ERROR] Server: cannot stream incumbents, only the result is sent\n");
+
+    const int count = run_selected_algorithms(job->instance, job->options, results, &hooks);
+
+    pthread_mutex_lock(&job->mutex);
+    job->solved = true;
+    pthread_cond_signal(&job->stream_cond);
+    pthread_mutex_unlock(&job->mutex);
+    if (streaming) pthread_join(streamer, NULL);
+
+    if (count == 0) session_send(session, "ERROR no algorithm enabled\n");
+    for (int i = 0; i < count; i++)
+        session_send(session, "RESULT %.6f %.4f %s\n", results[i].cost, results[i].seconds, results[i].algorithm);
+
+    pthread_mutex_lock(&session->write_mutex);
+    if (count > 0) {
+        dprintf(session->fd, "TOUR");
+        for (int i = 0; i <= job->n; i++) dprintf(session->fd, " %d", job->best_tour[i]);
+        dprintf(session->fd, "\n");
+    }
+    dprintf(session->fd, cancel_token_is_cancelled(job->cancel) ? "DONE cancelled\n" : "DONE\n");
+    pthread_mutex_unlock(&session->write_mutex);
+
+    instance_cache_release(server->cache, job->instance);
+    job->instance = NULL;
+
+    pthread_mutex_lock(&job->mutex);
+    job->done = true;
+    pthread_cond_signal(&job->done_cond);
+    pthread_mutex_unlock(&job->mutex);
+}
+
+static void *worker_main(void *arg) {
+    Server *server = arg;
+    for (;;) {
+        pthread_mutex_lock(&server->mutex);
+        while (!server->head) pthread_cond_wait(&server->not_empty, &server->mutex);
+        Job *job = server->head;
+        server->head = job->next;
+        if (!server->head) server->tail = NULL;
+        pthread_mutex_unlock(&server->mutex);
+
+        run_job(server, job);
+    }
+    return NULL;
+}
+
+static void enqueue(Server *server, Job *job) {
+    pthread_mutex_lock(&server->mutex);
+    job->next = NULL;
+    if (server->tail) server->tail->next = job;
+    else server->head = job;
+    server->tail = job;
+    pthread_cond_signal(&server->not_empty);
+    pthread_mutex_unlock(&server->mutex);
+}
+
+static void job_wait_and_free(Job *job) {
+    pthread_mutex_lock(&job->mutex);
+    while (!job->done) pthread_cond_wait(&job->done_cond, &job->mutex);
+    pthread_mutex_unlock(&job->mutex);
+
+    cmd_options_destroy(job->options);
+    cancel_token_destroy(job->cancel);
+    tsp_free(job->best_tour);
+    pthread_mutex_destroy(&job->mutex);
+    pthread_cond_destroy(&job->done_cond);
+    pthread_cond_destroy(&job->stream_cond);
+    tsp_free(job);
+}
+
+/* Parses the flags of a SOLVE request; nodes (may be NULL) replace the instance options. */
+static Job *create_job(Session *session, char *flags, const Node *nodes, const int n) {
+    const char *argv[SERVER_MAX_ARGS];
+    const int argc = split_command_line(flags, argv, SERVER_MAX_ARGS);
+
+    CmdOptions *options = cmd_options_create_defaults();
+    const ParsingResult *res = cmd_options_load(options, argc, argv);
+    if (res->state != PARSE_SUCCESS) {
+        session_send(session, "ERROR %s\n", res->error_message ? res->error_message : "invalid options");
+        cmd_options_destroy(options);
+        return NULL;
+    }
+    options->plots_enable = false;
+
+    const TspInstance *instance = nodes
+                                      ? instance_cache_acquire_nodes(session->server->cache, nodes, n)
+                                      : instance_cache_acquire(session->server->cache, &options->inst);
+    if (!instance) {
+        session_send(session, "ERROR cannot load instance\n");
+        cmd_options_destroy(options);
+        return NULL;
+    }
+
+    Job *job = tsp_calloc(1, sizeof(Job));
+    job->session = session;
+    job->options = options;
+    job->instance = instance;
+    job->cancel = cancel_token_create();
+    job->n = tsp_instance_get_num_nodes(instance);
+    job->best_tour = tsp_malloc((job->n + 1) * sizeof(int));
+
+    // Every run starts from this tour, so the TOUR line is valid even if no algorithm improves on it
+    TspSolution *initial = tsp_solution_create(instance);
+    tsp_solution_get_tour(initial, job->best_tour);
+    job->best_cost = tsp_solution_get_cost(initial);
+    tsp_solution_destroy(initial);
+
+    pthread_mutex_init(&job->mutex, NULL);
+    pthread_cond_init(&job->done_cond, NULL);
+    pthread_cond_init(&job->stream_cond, NULL);
+    return job;
+}
+
+/* Reads the n coordinate lines of a SOLVE_NODES request. */
+static Node *read_nodes(FILE *in, const int n) {
+    Node *nodes = tsp_malloc(n * sizeof(Node));
+    char *line = NULL;
+    size_t size = 0;
+    for (int i = 0; i < n; i++) {
+        if (getline(&line, &size, in) == -1 || sscanf(line, "%lf %lf", &nodes[i].x, &nodes[i].y) != 2) {
+            free(line);
+            tsp_free(nodes);
+            return NULL;
+        }
+    }
+    free(line);
+    return nodes;
+}
+
+static bool job_is_done(Job *job) {
+    pthread_mutex_lock(&job->mutex);
+    const bool done = job->done;
+    pthread_mutex_unlock(&job->mutex);
+    return done;
+}
+
+static void handle_solve(Session *session, FILE *in, char *request, const bool with_nodes) {
+    if (session->active && !job_is_done(session->active)) {
+        session_send(session, "ERROR busy: a solve is already running on this connection\n");
+        return;
+    }
+    if (session->active) {
+        job_wait_and_free(session->active);
+        session->active = NULL;
+    }
+
+    Node *nodes = NULL;
+    int n = 0;
+    char *flags = request;
+    if (with_nodes) {
+        if (sscanf(request, "%d", &n) != 1 || n < 2) {
+            session_send(session, "ERROR SOLVE_NODES needs a node count of at least 2\n");
+            return;
+        }
+        nodes = read_nodes(in, n);
+        if (!nodes) {
+            session_send(session, "ERROR expected %d lines \"x y\"\n", n);
+            return;
+        }
+        while (*flags == ' ') flags++;
+        while (*flags && *flags != ' ') flags++;
+    }
+
+    Job *job = create_job(session, flags, nodes, n);
+    tsp_free(nodes);
+    if (!job) return;
+
+    session->active = job;
+    session_send(session, "ACCEPTED %d\n", job->n);
+    enqueue(session->server, job);
+}
+
+static void *session_main(void *arg) {
+    Session *session = arg;
+    FILE *in = fdopen(dup(session->fd), "r");
+    char *line = NULL;
+    size_t size = 0;
+
+    while (in && getline(&line, &size, in) != -1) {
+        str_trim(line);
+        if (strncmp(line, "SOLVE_NODES ", 12) == 0) {
+            handle_solve(session, in, line + 12, true);
+        } else if (strncmp(line, "SOLVE", 5) == 0 && (line[5] == ' ' || line[5] == '\0')) {
+            handle_solve(session, in, line + 5, false);
+        } else if (strcmp(line, "CANCEL") == 0) {
+            if (session->active) cancel_token_cancel(session->active->cancel);
+        } else if (strcmp(line, "QUIT") == 0) {
+            break;
+        } else if (line[0] != '\0') {
+            session_send(session, "ERROR unknown command\n");
+        }
+    }
+
+    if (session->active) {
+        cancel_token_cancel(session->active->cancel);
+        job_wait_and_free(session->active);
+    }
+    free(line);
+    if (in) fclose(in);
+    close(session->fd);
+    pthread_mutex_destroy(&session->write_mutex);
+    tsp_free(session);
+    return NULL;
+}
+
+static int open_socket(const char *path) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        if_verbose(VERBOSE_INFO, "[ERROR] Server: socket path too long: %s\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    unlink(path);
+    if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0 || listen(fd, SERVER_BACKLOG) != 0) {
+        if_verbose(VERBOSE_INFO, "[ERROR] Server: cannot listen on %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int run_server(const CmdOptions *options) {
+    const int listen_fd = open_socket(options->serve.socket_path);
+    if (listen_fd < 0) return 1;
+
+    // Clients may disconnect mid-solve: a failed write must not kill the daemon
+    signal(SIGPIPE, SIG_IGN);
+    // No SA_RESTART, so that accept returns on a stop signal
+    struct sigaction stop_action = {.sa_handler = handle_stop_signal};
+    sigemptyset(&stop_action.sa_mask);
+    sigaction(SIGINT, &stop_action, NULL);
+    sigaction(SIGTERM, &stop_action, NULL);
+
+    Server server = {.cache = instance_cache_create((int) options->serve.cache_size), .head = NULL, .tail = NULL};
+    pthread_mutex_init(&server.mutex, NULL);
+    pthread_cond_init(&server.not_empty, NULL);
+
+    // The workers live as long as the server: no thread is created per request
+    const unsigned int workers = options->num_threads > 0 ? options->num_threads : 1;
+    for (unsigned int i = 0; i < workers; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, worker_main, &server) != 0) {
+            fprintf(stderr, "Error creating thread %u\n", i);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+
+    if_verbose(VERBOSE_INFO, ">>> Serving on %s with %u workers, cache of %u instances\n",
+               options->serve.socket_path, workers, options->serve.cache_size);
+
+    while (!stop_requested) {
+        const int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if_verbose(VERBOSE_INFO, "[ERROR] Server: accept failed: %s\n", strerror(errno));
+            break;
+        }
+
+        Session *session = tsp_calloc(1, sizeof(Session));
+        session->server = &server;
+        session->fd = fd;
+        pthread_mutex_init(&session->write_mutex, NULL);
+
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, session_main, session) != 0) {
+            close(fd);
+            pthread_mutex_destroy(&session->write_mutex);
+            tsp_free(session);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+
+    // Sessions and workers are detached: in-flight solves end with the process
+    close(listen_fd);
+    unlink(options->serve.socket_path);
+    if_verbose(VERBOSE_INFO, "Server: stopped\n");
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <assert.h>
+
+#include "instance_cache.h"
+
+static void fill_nodes(Node *nodes, const int n, const double shift) {
+    for (int i = 0; i < n; i++) {
+        nodes[i].x = shift + i;
+        nodes[i].y = (double) (i * i % 7);
+    }
+}
+
+void test_hit_and_release() {
+    printf("Running test_hit_and_release...\n");
+    Node nodes[5];
+    fill_nodes(nodes, 5, 0.0);
+    InstanceCache *cache = instance_cache_create(2);
+
+    const TspInstance *first = instance_cache_acquire_nodes(cache, nodes, 5);
+    const TspInstance *second = instance_cache_acquire_nodes(cache, nodes, 5);
+    assert(first != NULL);
+    assert(first == second);
+    assert(instance_cache_get_builds(cache) == 1);
+
+    instance_cache_release(cache, first);
+    instance_cache_release(cache, second);
+    instance_cache_destroy(cache);
+}
+
+void test_held_instance_not_evicted() {
+    printf("Running test_held_instance_not_evicted...\n");
+    Node held_nodes[6], other_nodes[6];
+    fill_nodes(held_nodes, 6, 0.0);
+    fill_nodes(other_nodes, 6, 100.0);
+    InstanceCache *cache = instance_cache_create(1);
+
+    // A job keeps using the first instance while another job needs a second key
+    const TspInstance *held = instance_cache_acquire_nodes(cache, held_nodes, 6);
+    const TspInstance *other = instance_cache_acquire_nodes(cache, other_nodes, 6);
+    assert(other != held);
+    instance_cache_release(cache, other);
+
+    const TspInstance *again = instance_cache_acquire_nodes(cache, held_nodes, 6);
+    assert(again == held);
+    assert(instance_cache_get_builds(cache) == 2);
+    instance_cache_release(cache, again);
+    instance_cache_release(cache, held);
+
+    // Unreferenced now: the least recently used one makes room
+    const TspInstance *rebuilt = instance_cache_acquire_nodes(cache, other_nodes, 6);
+    assert(instance_cache_get_builds(cache) == 3);
+    instance_cache_release(cache, rebuilt);
+    const TspInstance *kept = instance_cache_acquire_nodes(cache, other_nodes, 6);
+    assert(kept == rebuilt);
+    assert(instance_cache_get_builds(cache) == 3);
+    instance_cache_release(cache, kept);
+
+    instance_cache_destroy(cache);
+}
+
+int main() {
+    printf("--- Starting Instance Cache Test Suite ---\n\n");
+    test_hit_and_release();
+    test_held_instance_not_evicted();
+    printf("\n--- All tests passed successfully! ---\n");
+    return 0;
+}